@@ -67,23 +67,27 @@ void SortedList<T,F,C>::Insert(U &&element)
     mContainer.Insert(it, std::forward<U>(element));   
 }
 
-// binary search
+// binary search: first element not ordered before key, then equality is checked among the equivalent elements
 template <typename T, typename F, template <typename> class C>
 typename SortedList<T,F,C>::Iterator SortedList<T,F,C>::Find(const T &key)
 {
-    int middleIndex = mContainer.Size();
+    size_t low = 0, high = mContainer.Size();
 
-    while (middleIndex > 0)
+    while (low < high)
     {
-        middleIndex /= 2;
+        size_t middle = low + (high - low) / 2;
 
-        Iterator it = mContainer.AtIndex(middleIndex);
-
-        if (*it == key)
-            return it;
+        if (mComparator(*mContainer.AtIndex(middle), key))
+            low = middle + 1;
+        else
+            high = middle;
     }
 
-    return mContainer.End();    
+    for (; low < mContainer.Size() && !mComparator(key, *mContainer.AtIndex(low)); low++)
+        if (*mContainer.AtIndex(low) == key)
+            return mContainer.AtIndex(low);
+
+    return mContainer.End();
 }
 
 #endif  // SORTED_LIST_H
\ No newline at end of file
@@ -0,0 +1,52 @@
+#ifndef ALLOCATION_POLICY_H
+#define ALLOCATION_POLICY_H
+
+#include <cstddef>
+#include <new>
+
+using std::size_t;
+
+/**** allocation policies of the array based containers (Vector, Heap, CircularArray): stateless classes with
+      static void *Allocate(size_t bytes, size_t alignment) and static void Deallocate(void *memory, size_t bytes, size_t alignment),
+      Deallocate gets the bytes and alignment given to Allocate (nullptr with 0 bytes must be accepted). portable,
+      HugePageAllocation (huge_page_allocation.hpp) needs Linux ****/
+
+// operator new, the aligned one for over-aligned types (sized delete)
+struct DefaultAllocation
+{
+    static void *Allocate(size_t bytes, size_t alignment)
+    {
+        if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+            return operator new(bytes, std::align_val_t(alignment));
+
+        return operator new(bytes);
+    }
+
+    static void Deallocate(void *memory, size_t bytes, size_t alignment)
+    {
+        if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+            operator delete(memory, bytes, std::align_val_t(alignment));
+        else
+            operator delete(memory, bytes);
+    }
+};
+
+// arrays start on an ALIGNMENT boundary: 64 is a cache line (no line shared with another allocation) and an AVX-512
+// register (aligned loads from the first element)
+template <size_t ALIGNMENT = 64>
+struct AlignedAllocation
+{
+    static_assert(ALIGNMENT != 0 && (ALIGNMENT & (ALIGNMENT - 1)) == 0, "alignment must be a power of two");
+
+    static void *Allocate(size_t bytes, size_t alignment)
+    {
+        return operator new(bytes, std::align_val_t(alignment > ALIGNMENT ? alignment : ALIGNMENT));
+    }
+
+    static void Deallocate(void *memory, size_t bytes, size_t alignment)
+    {
+        operator delete(memory, bytes, std::align_val_t(alignment > ALIGNMENT ? alignment : ALIGNMENT));
+    }
+};
+
+#endif  // ALLOCATION_POLICY_H
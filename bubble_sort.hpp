@@ -1,44 +1,58 @@
 #ifndef BUBBLE_SORT_H
 #define BUBBLE_SORT_H
 
-template <template <typename> class S, typename T>
-void BubbleSort(S<T> &sequence)
+#include <cstddef>
+#include <utility>
+
+// O(n^2) walking forward iterators (AtIndex is O(n) on the lists), stops after a pass without swaps
+template <template <typename...> class S, typename T, typename... Rest>
+void BubbleSort(S<T, Rest...> &sequence)
 {
-    for (size_t i = sequence.Size() - 1; i > 0; i--)
-        for (size_t j = 0; j < i; j++)
+    using std::swap;
+
+    for (size_t i = sequence.Size(); i > 1; i--)
+    {
+        bool swapped = false;
+
+        typename S<T, Rest...>::Iterator prec = sequence.Begin(), succ = prec;
+        ++succ;
+
+        for (size_t j = 1; j < i; j++, ++prec, ++succ)
         {
-            if (*sequence.AtIndex(j) > *sequence.AtIndex(j + 1))
+            if (*prec > *succ)
             {
-                T temp = *sequence.AtIndex(j);
-                *sequence.AtIndex(j) = *sequence.AtIndex(j + 1);
-                *sequence.AtIndex(j + 1) = temp;
+                swap(*prec, *succ);
+                swapped = true;
             }
         }
+
+        if (!swapped)
+            break;
+    }
 }
 
-template <typename T, template <class> class S>
-void IT_BubbleSort(S<T> &vec)
+template <typename T, template <typename...> class S, typename... Rest>
+void IT_BubbleSort(S<T, Rest...> &vec)
 {
-    typename S<T>::Iterator it = vec.End();
+    using std::swap;
+
+    typename S<T, Rest...>::Iterator it = vec.End();
 
     while (it != vec.Begin())
     {
-        typename S<T>::Iterator prec = vec.Begin(), succ = prec;
+        typename S<T, Rest...>::Iterator prec = vec.Begin(), succ = prec;
         ++succ;
 
         while (succ != it)
         {
             if (*prec > *succ)
-            {
-                T temp = *prec;
-                *prec = *succ;
-                *succ = temp;
-            } 
+                swap(*prec, *succ);   // moves, no copy
+
             ++prec;
             ++succ;
-        } 
-        --it;  
+        }
+        --it;
     }
 }
 
-#endif  // BUBBLE_SORT_H
\ No newline at end of file
+#endif  // BUBBLE_SORT_H
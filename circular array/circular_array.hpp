@@ -5,14 +5,16 @@
 #include <utility>
 #include <exception>
 
+#include "../allocation_policy.hpp"
+
 using std::size_t;
 
-template <typename T>
+template <typename T, typename A = DefaultAllocation>   // A: allocation policy of the buffer
 class CircularArray
 {
 public:
     CircularArray(size_t size = 10);
-    ~CircularArray() { Clear(); operator delete(mBuffer); }
+    ~CircularArray() { Clear(); A::Deallocate(mBuffer, sizeof(T) * mSize, alignof(T)); }
 
     bool Empty() const { return mHead == mTail; }
     bool Full() const { size_t temp = (mTail + 1) % mSize; return temp == mHead; /* return Size() == mSize - 1;*/ } 
@@ -39,17 +41,17 @@ private:
     size_t mTail;
 };
 
-template <typename T>
-CircularArray<T>::CircularArray(size_t size) : mSize(size), mHead(0), mTail(0)
+template <typename T, typename A>
+CircularArray<T, A>::CircularArray(size_t size) : mSize(size), mHead(0), mTail(0)
 {
-    void *rawMem = operator new(sizeof(T) * size);
+    void *rawMem = A::Allocate(sizeof(T) * size, alignof(T));
 
     mBuffer = static_cast<T*>(rawMem);
 }
 
-template <typename T>
+template <typename T, typename A>
 template <typename U>
-void CircularArray<T>::InsertFirst(U &&element)
+void CircularArray<T, A>::InsertFirst(U &&element)
 {
     if (Full())
         throw std::exception();
@@ -62,9 +64,9 @@ void CircularArray<T>::InsertFirst(U &&element)
     new(&mBuffer[mHead]) T(std::forward<U>(element));  // placement-new
 }
     
-template <typename T>
+template <typename T, typename A>
 template <typename U>
-void CircularArray<T>::InsertLast(U &&element)
+void CircularArray<T, A>::InsertLast(U &&element)
 {
     if (Full())
         throw std::exception();
@@ -75,8 +77,8 @@ void CircularArray<T>::InsertLast(U &&element)
     mTail %= mSize;
 }
 
-template <typename T>
-void CircularArray<T>::RemoveFirst()
+template <typename T, typename A>
+void CircularArray<T, A>::RemoveFirst()
 {
     if (Empty())
         throw std::exception();
@@ -87,8 +89,8 @@ void CircularArray<T>::RemoveFirst()
     mHead %= mSize;
 }
     
-template <typename T>
-void CircularArray<T>::RemoveLast()
+template <typename T, typename A>
+void CircularArray<T, A>::RemoveLast()
 {
     if (Empty())
         throw std::exception();
@@ -101,8 +103,8 @@ void CircularArray<T>::RemoveLast()
     mBuffer[mTail].~T();
 }
 
-template <typename T>
-void CircularArray<T>::Clear()
+template <typename T, typename A>
+void CircularArray<T, A>::Clear()
 {
     while (!Empty())
         RemoveFirst();
@@ -0,0 +1,192 @@
+#ifndef DISJOINT_SET_H
+#define DISJOINT_SET_H
+
+#include <cstddef>
+
+#include "../vector/vector.hpp"
+
+using std::size_t;
+
+/**** disjoint set forest (union-find) with path halving and union by size ****/
+class DisjointSet
+{
+public:
+    DisjointSet() = default;
+    DisjointSet(size_t size) { Reset(size); }
+
+    size_t Size() const { return mParents.Size(); }
+    size_t NumSets() const { return mNumSets; }
+
+    void Reset(size_t size);     // size singleton sets {0}, {1}, ... {size - 1}
+    void Reserve(size_t size) { mParents.Reserve(size); mSizes.Reserve(size); }
+    unsigned int MakeSet();      // add a singleton set and return its element
+
+    unsigned int Find(unsigned int element);
+    bool Union(unsigned int element1, unsigned int element2);   // false if elements were already in the same set
+    bool Connected(unsigned int element1, unsigned int element2) { return Find(element1) == Find(element2); }
+
+    // const queries do not halve paths (O(log n) with union by size): concurrent readers are safe without a writer
+    unsigned int Find(unsigned int element) const;
+    bool Connected(unsigned int element1, unsigned int element2) const { return Find(element1) == Find(element2); }
+
+    unsigned int SetSize(unsigned int element) { return mSizes[Find(element)]; }
+
+private:
+    Vector<unsigned int> mParents;
+    Vector<unsigned int> mSizes;   // number of elements in the tree (valid for roots only)
+    size_t mNumSets = 0;
+};
+
+inline void DisjointSet::Reset(size_t size)
+{
+    mParents.Clear();
+    mSizes.Clear();
+
+    mParents.Reserve(size);
+    mSizes.Reserve(size);
+    mNumSets = 0;
+
+    for (size_t i = 0; i < size; i++)
+        MakeSet();
+}
+
+inline unsigned int DisjointSet::MakeSet()
+{
+    unsigned int element = static_cast<unsigned int>(mParents.Size());
+
+    mParents.InsertLast(element);
+    mSizes.InsertLast(1U);
+    mNumSets++;
+
+    return element;
+}
+
+inline unsigned int DisjointSet::Find(unsigned int element)
+{
+    // path halving: every other node on the path points to its grandparent (single pass, no recursion)
+    while (mParents[element] != element)
+    {
+        mParents[element] = mParents[mParents[element]];
+        element = mParents[element];
+    }
+
+    return element;
+}
+
+inline unsigned int DisjointSet::Find(unsigned int element) const
+{
+    while (mParents[element] != element)
+        element = mParents[element];
+
+    return element;
+}
+
+inline bool DisjointSet::Union(unsigned int element1, unsigned int element2)
+{
+    unsigned int root1 = Find(element1);
+    unsigned int root2 = Find(element2);
+
+    if (root1 == root2)
+        return false;
+
+    // attach the smaller tree under the larger one
+    if (mSizes[root1] < mSizes[root2])
+    {
+        unsigned int temp = root1;
+        root1 = root2;
+        root2 = temp;
+    }
+
+    mParents[root2] = root1;
+    mSizes[root1] += mSizes[root2];
+
+    mNumSets--;
+
+    return true;
+}
+
+#include <atomic>
+
+/**** lock-free disjoint set for concurrent Union/Find on a fixed number of elements ****/
+// roots are linked by index (larger index under smaller index) with a single CAS on the root's parent,
+// Find halves paths with CAS (a failed CAS only means another thread already shortened the path)
+class ConcurrentDisjointSet
+{
+public:
+    ConcurrentDisjointSet(size_t size);
+
+    size_t Size() const { return mParents.Size(); }
+
+    unsigned int Find(unsigned int element);
+    bool Union(unsigned int element1, unsigned int element2);       // false if elements were already in the same set
+    bool Connected(unsigned int element1, unsigned int element2);   // linearizable w.r.t. concurrent unions
+
+private:
+    Vector<std::atomic<unsigned int>> mParents;
+};
+
+inline ConcurrentDisjointSet::ConcurrentDisjointSet(size_t size) : mParents(size)
+{
+    for (size_t i = 0; i < size; i++)
+        mParents[i].store(static_cast<unsigned int>(i), std::memory_order_relaxed);
+}
+
+inline unsigned int ConcurrentDisjointSet::Find(unsigned int element)
+{
+    unsigned int parent = mParents[element].load(std::memory_order_acquire);
+
+    while (parent != element)
+    {
+        unsigned int grandparent = mParents[parent].load(std::memory_order_acquire);
+
+        if (parent != grandparent)
+            mParents[element].compare_exchange_weak(parent, grandparent, std::memory_order_release, std::memory_order_relaxed);
+
+        element = grandparent;
+        parent = mParents[element].load(std::memory_order_acquire);
+    }
+
+    return element;
+}
+
+inline bool ConcurrentDisjointSet::Union(unsigned int element1, unsigned int element2)
+{
+    while (true)
+    {
+        unsigned int root1 = Find(element1);
+        unsigned int root2 = Find(element2);
+
+        if (root1 == root2)
+            return false;
+
+        if (root1 > root2)   // link larger index under smaller index (no cycles can be created)
+        {
+            unsigned int temp = root1;
+            root1 = root2;
+            root2 = temp;
+        }
+
+        unsigned int expected = root2;
+        if (mParents[root2].compare_exchange_strong(expected, root1, std::memory_order_acq_rel))
+            return true;
+
+        // root2 was linked by another thread in the meantime, retry
+    }
+}
+
+inline bool ConcurrentDisjointSet::Connected(unsigned int element1, unsigned int element2)
+{
+    while (true)
+    {
+        unsigned int root1 = Find(element1);
+        unsigned int root2 = Find(element2);
+
+        if (root1 == root2)
+            return true;
+
+        if (mParents[root1].load(std::memory_order_acquire) == root1)   // root1 still a root: sets were distinct at this point
+            return false;
+    }
+}
+
+#endif  // DISJOINT_SET_H
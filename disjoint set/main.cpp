@@ -0,0 +1,21 @@
+#include "disjoint_set.hpp"
+#include <iostream>
+
+int main(int argc, char **argv)
+{
+    DisjointSet set(10);
+
+    set.Union(0, 1);
+    set.Union(2, 3);
+    set.Union(1, 3);
+    set.Union(7, 8);
+
+    std::cout << "number of sets: " << set.NumSets() << std::endl;
+    std::cout << "0 and 2 connected: " << set.Connected(0, 2) << std::endl;
+    std::cout << "0 and 7 connected: " << set.Connected(0, 7) << std::endl;
+
+    for (unsigned int i = 0; i < set.Size(); i++)
+        std::cout << i << " ---> " << set.Find(i) << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,171 @@
+#ifndef ALL_PAIRS_SHORTEST_PATHS_H
+#define ALL_PAIRS_SHORTEST_PATHS_H
+
+#include "../vector/vector.hpp"
+#include "../parallel/parallel_for.hpp"
+#include <limits>
+
+/**** all pairs shortest paths (blocked Floyd-Warshall) - distance and next hop matrices stored row major in flat arrays ****/
+class AllPairsShortestPaths
+{
+public:
+    static constexpr float INF = std::numeric_limits<float>::infinity();   // distance of unreachable nodes
+
+public:
+    AllPairsShortestPaths() : mNumNodes(0U), mStride(0U) {}
+
+    // weight(i, j) returns the weight of edge i -> j or INF if there is no edge
+    template <typename F>
+    void Compute(unsigned int numNodes, const F &weight);
+
+    unsigned int Size() const { return mNumNodes; }
+
+    /**** queries are O(1) ****/
+    float Distance(unsigned int nodeIndex1, unsigned int nodeIndex2) const { return mDistances[nodeIndex1 * mStride + nodeIndex2]; }
+    bool Reachable(unsigned int nodeIndex1, unsigned int nodeIndex2) const { return mNextHops[nodeIndex1 * mStride + nodeIndex2] != -1; }
+    int NextHop(unsigned int nodeIndex1, unsigned int nodeIndex2) const { return mNextHops[nodeIndex1 * mStride + nodeIndex2]; }   // -1 if unreachable
+
+    bool HasNegativeCycle() const;
+
+    Vector<unsigned int> Path(unsigned int startNodeIndex, unsigned int endNodeIndex) const;   // empty if unreachable
+
+private:
+    static const unsigned int BLOCK_SIZE = 64U;   // 64 x 64 floats (16 KB) per block, 3 blocks fit in L1/L2
+
+    unsigned int mNumNodes;
+    unsigned int mStride;              // row length padded to a multiple of BLOCK_SIZE
+    Vector<float> mDistances;
+    Vector<int> mNextHops;
+
+    void UpdateBlock(unsigned int blockRow, unsigned int blockColumn, unsigned int blockK);
+};
+
+template <typename F>
+void AllPairsShortestPaths::Compute(unsigned int numNodes, const F &weight)
+{
+    mNumNodes = numNodes;
+    mStride = (numNodes + BLOCK_SIZE - 1) / BLOCK_SIZE * BLOCK_SIZE;
+
+    // padding nodes are isolated: they never shorten a path
+    mDistances.Clear();
+    mDistances.Resize(static_cast<size_t>(mStride) * mStride, INF);
+    mNextHops.Clear();
+    mNextHops.Resize(static_cast<size_t>(mStride) * mStride, -1);
+
+    for (unsigned int i = 0; i < numNodes; i++)
+    {
+        for (unsigned int j = 0; j < numNodes; j++)
+        {
+            float w = weight(i, j);
+
+            if (w != INF)
+            {
+                mDistances[i * mStride + j] = w;
+                mNextHops[i * mStride + j] = static_cast<int>(j);
+            }
+        }
+
+        if (mDistances[i * mStride + i] > 0.0f)
+        {
+            mDistances[i * mStride + i] = 0.0f;
+            mNextHops[i * mStride + i] = static_cast<int>(i);
+        }
+    }
+
+    unsigned int numBlocks = mStride / BLOCK_SIZE;
+
+    for (unsigned int k = 0; k < numBlocks; k++)
+    {
+        // phase 1: diagonal block depends only on itself
+        UpdateBlock(k, k, k);
+
+        // phase 2: blocks in row k and column k depend on themselves and the diagonal block
+        ParallelFor(0, numBlocks, [this, k](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+                if (i != k)
+                {
+                    UpdateBlock(k, static_cast<unsigned int>(i), k);
+                    UpdateBlock(static_cast<unsigned int>(i), k, k);
+                }
+        });
+
+        // phase 3: remaining blocks depend on their row k and column k blocks (independent of each other)
+        ParallelFor(0, numBlocks, [this, k, numBlocks](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+                if (i != k)
+                    for (unsigned int j = 0; j < numBlocks; j++)
+                        if (j != k)
+                            UpdateBlock(static_cast<unsigned int>(i), j, k);
+        });
+    }
+}
+
+// relax block (blockRow, blockColumn) through intermediate nodes of block blockK, source blocks may alias the updated block
+inline void AllPairsShortestPaths::UpdateBlock(unsigned int blockRow, unsigned int blockColumn, unsigned int blockK)
+{
+    float *distances = mDistances.Data();
+    int *nextHops = mNextHops.Data();
+
+    unsigned int rowBegin = blockRow * BLOCK_SIZE;
+    unsigned int columnBegin = blockColumn * BLOCK_SIZE;
+    unsigned int kBegin = blockK * BLOCK_SIZE;
+
+    for (unsigned int k = kBegin; k < kBegin + BLOCK_SIZE; k++)
+    {
+        const float *rowK = distances + k * mStride + columnBegin;
+
+        for (unsigned int i = rowBegin; i < rowBegin + BLOCK_SIZE; i++)
+        {
+            float distanceIK = distances[i * mStride + k];
+
+            if (distanceIK == INF)
+                continue;
+
+            int nextHopIK = nextHops[i * mStride + k];
+            float *rowI = distances + i * mStride + columnBegin;
+            int *nextHopRowI = nextHops + i * mStride + columnBegin;
+
+            // branch free inner loop (vectorized by the compiler)
+            for (unsigned int j = 0; j < BLOCK_SIZE; j++)
+            {
+                float newDistance = distanceIK + rowK[j];
+                bool shorter = newDistance < rowI[j];
+
+                rowI[j] = shorter ? newDistance : rowI[j];
+                nextHopRowI[j] = shorter ? nextHopIK : nextHopRowI[j];
+            }
+        }
+    }
+}
+
+inline bool AllPairsShortestPaths::HasNegativeCycle() const
+{
+    for (unsigned int i = 0; i < mNumNodes; i++)
+        if (mDistances[i * mStride + i] < 0.0f)
+            return true;
+
+    return false;
+}
+
+inline Vector<unsigned int> AllPairsShortestPaths::Path(unsigned int startNodeIndex, unsigned int endNodeIndex) const
+{
+    Vector<unsigned int> path;
+
+    if (!Reachable(startNodeIndex, endNodeIndex))
+        return path;
+
+    path.InsertLast(startNodeIndex);
+
+    unsigned int nodeIndex = startNodeIndex;
+    while (nodeIndex != endNodeIndex && path.Size() <= mNumNodes)   // bounded in case of negative cycles
+    {
+        nodeIndex = static_cast<unsigned int>(NextHop(nodeIndex, endNodeIndex));
+        path.InsertLast(nodeIndex);
+    }
+
+    return path;
+}
+
+#endif  // ALL_PAIRS_SHORTEST_PATHS_H
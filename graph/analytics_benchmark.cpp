@@ -0,0 +1,94 @@
+#include "graph_analytics.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+
+// usage: analytics_benchmark [numNodes] [averageDegree] [repetitions]
+// random graph with a skewed degree distribution (R-MAT like), times the SpMV kernel, PageRank and label propagation
+
+static double Milliseconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char **argv)
+{
+    unsigned int numNodes = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    unsigned int averageDegree = argc > 2 ? std::atoi(argv[2]) : 16;
+    unsigned int repetitions = argc > 3 ? std::atoi(argv[3]) : 10;
+
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> uniform(0.0f, 1.0f);
+
+    // R-MAT: every edge descends the adjacency matrix quadrants with probabilities 0.57, 0.19, 0.19, 0.05
+    unsigned int scale = 0;
+    while ((1U << scale) < numNodes)
+        scale++;
+
+    Vector<CsrGraph::Edge> edges;
+    edges.Reserve(static_cast<size_t>(numNodes) * averageDegree);
+
+    while (edges.Size() < static_cast<size_t>(numNodes) * averageDegree)
+    {
+        unsigned int source = 0, destination = 0;
+
+        for (unsigned int bit = 0; bit < scale; bit++)
+        {
+            float p = uniform(random);
+
+            source = source << 1 | (p >= 0.76f);
+            destination = destination << 1 | ((p >= 0.57f && p < 0.76f) || p >= 0.95f);
+        }
+
+        if (source < numNodes && destination < numNodes)
+            edges.InsertLast(CsrGraph::Edge{source, destination, uniform(random)});
+    }
+
+    CsrGraph csr;
+    csr.Build(numNodes, edges);
+    CsrGraph transpose = csr.Transpose();
+
+    std::cout << "nodes: " << csr.Size() << " edges: " << csr.NumEdges() << " threads: " << HardwareConcurrency() << std::endl;
+
+    SpMVKernel kernel(transpose.View());
+
+    Vector<float> x, y;
+    x.Resize(numNodes, 1.0f);
+    y.Resize(numNodes);
+
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < repetitions; i++)
+        kernel.Multiply(x.Data(), y.Data());
+    double spmv = Milliseconds(start) / repetitions;
+
+    std::cout << "spmv: " << spmv << " ms (" << csr.NumEdges() / spmv / 1e6 << " G edges/s)" << std::endl;
+
+    Vector<float> ranks;
+    start = std::chrono::steady_clock::now();
+    IterationResult pageRank = PageRank(csr.View(), transpose.View(), ranks);
+    std::cout << "pagerank: " << Milliseconds(start) << " ms, " << pageRank.mNumIterations << " iterations, residual " << pageRank.mResidual << std::endl;
+
+    // personalized on the first 16 nodes
+    Vector<float> personalization;
+    personalization.Resize(numNodes, 0.0f);
+    for (unsigned int i = 0; i < numNodes && i < 16; i++)
+        personalization[i] = 1.0f / std::min(numNodes, 16U);
+
+    Vector<float> personalizedRanks;
+    start = std::chrono::steady_clock::now();
+    IterationResult personalized = PageRank(csr.View(), transpose.View(), personalizedRanks, 0.85f, 1e-6, 100, personalization.Data());
+    std::cout << "personalized pagerank: " << Milliseconds(start) << " ms, " << personalized.mNumIterations << " iterations, residual " << personalized.mResidual << std::endl;
+
+    Vector<unsigned int> labels;
+    start = std::chrono::steady_clock::now();
+    IterationResult components = LabelPropagationComponents(csr.View(), transpose.View(), labels);
+
+    unsigned int numComponents = 0;
+    for (unsigned int i = 0; i < numNodes; i++)
+        numComponents += labels[i] == i;
+
+    std::cout << "label propagation: " << Milliseconds(start) << " ms, " << components.mNumIterations << " iterations, " << numComponents << " components" << std::endl;
+
+    return 0;
+}
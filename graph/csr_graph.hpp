@@ -0,0 +1,139 @@
+#ifndef CSR_GRAPH_H
+#define CSR_GRAPH_H
+
+#include <cstdint>
+
+#include "../vector/vector.hpp"
+
+/**** read-only compressed sparse row view: edges of node i are [offsets[i], offsets[i + 1]) in targets and weights ****/
+class CsrView
+{
+public:
+    CsrView() : mNumNodes(0), mNumEdges(0), mOffsets(nullptr), mTargets(nullptr), mWeights(nullptr) {}
+    CsrView(unsigned int numNodes, std::uint64_t numEdges, const std::uint64_t *offsets, const unsigned int *targets, const float *weights)
+        : mNumNodes(numNodes), mNumEdges(numEdges), mOffsets(offsets), mTargets(targets), mWeights(weights) {}
+
+    unsigned int Size() const { return mNumNodes; }
+    std::uint64_t NumEdges() const { return mNumEdges; }
+
+    unsigned int Degree(unsigned int nodeIndex) const { return static_cast<unsigned int>(mOffsets[nodeIndex + 1] - mOffsets[nodeIndex]); }
+
+    const unsigned int *TargetsBegin(unsigned int nodeIndex) const { return mTargets + mOffsets[nodeIndex]; }
+    const unsigned int *TargetsEnd(unsigned int nodeIndex) const { return mTargets + mOffsets[nodeIndex + 1]; }
+    const float *Weights(unsigned int nodeIndex) const { return mWeights + mOffsets[nodeIndex]; }   // weights of the edges in TargetsBegin(nodeIndex)
+
+    const std::uint64_t *Offsets() const { return mOffsets; }
+    const unsigned int *Targets() const { return mTargets; }
+    const float *Weights() const { return mWeights; }
+
+private:
+    unsigned int mNumNodes;
+    std::uint64_t mNumEdges;
+    const std::uint64_t *mOffsets;   // numNodes + 1 entries
+    const unsigned int *mTargets;
+    const float *mWeights;
+};
+
+/**** compressed sparse row graph (owns its arrays) ****/
+class CsrGraph
+{
+public:
+    struct Edge
+    {
+        unsigned int sourceNodeIndex;
+        unsigned int destinationNodeIndex;
+        float weight;
+    };
+
+public:
+    CsrGraph() { mOffsets.InsertLast(std::uint64_t(0)); }
+
+    void Build(unsigned int numNodes, const Vector<Edge> &edges);   // counting sort of edges by source node
+
+    template <typename G>
+    void Build(const G &graph);   // from any graph exposing Size() and GetAdjacencies(nodeIndex)
+
+    CsrView View() const { return CsrView(Size(), NumEdges(), mOffsets.Data(), mTargets.Data(), mWeights.Data()); }
+
+    CsrGraph Transpose() const;   // reverse every edge
+
+    unsigned int Size() const { return static_cast<unsigned int>(mOffsets.Size() - 1); }
+    std::uint64_t NumEdges() const { return mTargets.Size(); }
+
+private:
+    Vector<std::uint64_t> mOffsets;
+    Vector<unsigned int> mTargets;
+    Vector<float> mWeights;
+};
+
+inline void CsrGraph::Build(unsigned int numNodes, const Vector<Edge> &edges)
+{
+    mOffsets.Clear();
+    mOffsets.Resize(numNodes + 1, std::uint64_t(0));
+
+    for (const Edge &edge : edges)
+        mOffsets[edge.sourceNodeIndex + 1]++;
+
+    for (unsigned int i = 0; i < numNodes; i++)
+        mOffsets[i + 1] += mOffsets[i];
+
+    mTargets.Clear();
+    mTargets.Resize(edges.Size());
+    mWeights.Clear();
+    mWeights.Resize(edges.Size());
+
+    Vector<std::uint64_t> next(mOffsets);   // next free slot of each node (stable: edges keep their input order)
+
+    unsigned int *targets = mTargets.Data();
+    float *weights = mWeights.Data();
+
+    for (const Edge &edge : edges)
+    {
+        std::uint64_t position = next[edge.sourceNodeIndex]++;
+
+        targets[position] = edge.destinationNodeIndex;
+        weights[position] = edge.weight;
+    }
+}
+
+template <typename G>
+void CsrGraph::Build(const G &graph)
+{
+    unsigned int numNodes = graph.Size();
+
+    mOffsets.Clear();
+    mOffsets.Reserve(numNodes + 1);
+    mOffsets.InsertLast(std::uint64_t(0));
+
+    for (unsigned int i = 0; i < numNodes; i++)
+        mOffsets.InsertLast(mOffsets.Last() + graph.GetAdjacencies(i).Size());
+
+    mTargets.Clear();
+    mTargets.Reserve(mOffsets.Last());
+    mWeights.Clear();
+    mWeights.Reserve(mOffsets.Last());
+
+    for (unsigned int i = 0; i < numNodes; i++)
+        for (const auto &adjacency : graph.GetAdjacencies(i))
+        {
+            mTargets.InsertLast(adjacency.mConnectedNodeIndex);
+            mWeights.InsertLast(adjacency.mWeight);
+        }
+}
+
+inline CsrGraph CsrGraph::Transpose() const
+{
+    Vector<Edge> edges;
+    edges.Reserve(NumEdges());
+
+    for (unsigned int i = 0; i < Size(); i++)
+        for (std::uint64_t j = mOffsets[i]; j < mOffsets[i + 1]; j++)
+            edges.InsertLast(Edge{mTargets.Data()[j], i, mWeights.Data()[j]});
+
+    CsrGraph transpose;
+    transpose.Build(Size(), edges);
+
+    return transpose;
+}
+
+#endif  // CSR_GRAPH_H
@@ -2,6 +2,13 @@
 #define GRAPH_H
 
 #include "../../vector/vector.hpp"
+#include "../../disjoint set/disjoint_set.hpp"
+#include "../graph_traversal.hpp"
+#include "../node_states.hpp"
+#include "../graph_reorder.hpp"
+#include "../shortest_path_tree.hpp"
+#include "../landmark_heuristic.hpp"
+#include "../graph_components.hpp"
 #include <limits>
 
 template <typename T>
@@ -12,15 +19,9 @@ class Graph
 {
 friend class NodeVisitor<T>;
 private:
-	struct Node_
+	struct Node_   // payload only, traversal state lives in mNodeStates
 	{
 		T mData;
-
-		mutable bool mVisited = false;
-		mutable bool mInQueue = false;
-		mutable int mParentNodeIndex = -1;
-		mutable float mCost = std::numeric_limits<float>::max();
-		mutable float mHeuristic;
 	};
 	struct Adjacency
 	{
@@ -32,18 +33,43 @@ public:
     
 	void AddNode(const T &data);
 
+	void Reserve(unsigned int numNodes);   // preallocate storage for bulk loading
+
+	void ReserveEdges(unsigned int nodeIndex, unsigned int numEdges) { mAdjacencyList[nodeIndex].Reserve(numEdges); }
+
 	void RemoveNode(unsigned int nodeIndex);
 
 	void AddEdge(unsigned int node1, unsigned int node2, float weight = 1.0f, bool directed = false);
 
+	unsigned int Size() const { return mNodes.Size(); }
+
 	bool Connected(unsigned int node1, unsigned int node2) const;
 
+	Vector<Adjacency> const &GetAdjacencies(unsigned int nodeIndex) const { return mAdjacencyList[nodeIndex]; }
+
+	bool Reachable(unsigned int node1, unsigned int node2) const { return mComponents.Connected(node1, node2); }   // ignoring edge direction, near O(1)
+
+	// relabel nodes so that nodes traversed together are close in memory, returns the old to new index map (newIndices[oldNodeIndex])
+	Vector<unsigned int> Reorder(NodeOrder nodeOrder);
+
+	void Relabel(const Vector<unsigned int> &newIndices);   // move every node i to index newIndices[i], in place
+
+	// strongly connected components (iterative Tarjan), ids in reverse topological order of the condensation
+	Vector<unsigned int> StronglyConnectedComponents(unsigned int *numComponents = nullptr) const;
+
+	bool TopologicalSort(Vector<unsigned int> &order) const;   // Kahn, false if the graph has a cycle
+
 	int GetUnvisitedAdjacentNodeIndex(unsigned int nodeIndex) const;
 
 	void Reset() const;
 
 	T const &GetData(unsigned int nodeIndex) { return mNodes[nodeIndex].mData; }
 
+	// iterative depth first traversal, preVisitor(nodeIndex) is called when a node is discovered and postVisitor(nodeIndex) when all
+	// its descendants are done, a visitor returning false stops the traversal (return value is false if stopped early)
+	template <typename Pre, typename Post = NullVisitor>
+	bool DepthFirstTraversal(unsigned int startNodeIndex, const Pre &preVisitor, const Post &postVisitor = Post()) const;
+
 	template <template <typename> typename  F>
 	void DepthFirstSearch(F<T> &visitor, unsigned int startNodeIndex) const;
 
@@ -53,22 +79,47 @@ public:
 	template <template <typename> typename F>
 	void BreadthFirstSearch(F<T> &visitor, unsigned int startNodeIndex) const;
 
-	Vector<Vector<unsigned int>> DijkstraShortestPath(unsigned int startNodeIndex) const;
+	ShortestPathTree DijkstraShortestPath(unsigned int startNodeIndex) const;
 	Vector<unsigned int> DijkstraShortestPath(unsigned int startNodeIndex, unsigned int endNodeIndex) const;
 
 	Vector<unsigned int> AStar(unsigned int startNodeIndex, unsigned int endNodeIndex) const;
+
+	// landmark lower bounds used by the default GetNodeHeuristic (the landmarks must outlive their use by the graph,
+	// Relabel drops them: their tables follow the old indices)
+	void SetLandmarks(const LandmarkHeuristic *landmarks) { mLandmarks = landmarks; }
 private:
 	Vector<Node> mNodes;
+	mutable NodeStates mNodeStates;
 	Vector<Vector<Adjacency>> mAdjacencyList;
+	DisjointSet mComponents;   // connected components, updated incrementally as edges are added
+
+	const LandmarkHeuristic *mLandmarks = nullptr;
+
+	mutable DepthFirstScratch mDepthFirstScratch;   // stack and visit marks reused across traversals
+	mutable bool mDepthFirstScratchInUse = false;
 
 	float GetNodeHeuristic(unsigned int nodeIndex, unsigned int endNodeIndex) const;
+
+	template <template <typename> typename  F>
+	void DepthFirstSearchRecursive(F<T> &visitor, unsigned int nodeIndex, VisitMarks &visitMarks) const;
 };
 
 template <typename T>
 void Graph<T>::AddNode(const T &data)
 {
 	mNodes.InsertLast(Node{data});
-	mAdjacencyList.Resize(mNodes.Size());
+	mNodeStates.AddNode();
+	mAdjacencyList.InsertLast(Vector<Adjacency>());
+	mComponents.MakeSet();
+}
+
+template <typename T>
+void Graph<T>::Reserve(unsigned int numNodes)
+{
+	mNodes.Reserve(numNodes);
+	mNodeStates.Reserve(numNodes);
+	mAdjacencyList.Reserve(numNodes);
+	mComponents.Reserve(numNodes);
 }
 
 template <typename T>
@@ -78,18 +129,73 @@ void Graph<T>::AddEdge(unsigned int nodeIndex1, unsigned int nodeIndex2, float w
 
 	if (!directed)
 		mAdjacencyList[nodeIndex2].InsertLast(Adjacency{nodeIndex1, weight});
+
+	mComponents.Union(nodeIndex1, nodeIndex2);
 }
 
 template <typename T>
 void Graph<T>::Reset() const
 {
-	for (auto &node : mNodes)
+	mNodeStates.Reset();
+}
+
+template <typename T>
+Vector<unsigned int> Graph<T>::Reorder(NodeOrder nodeOrder)
+{
+	Vector<unsigned int> newIndices = ComputeNodeOrder(*this, nodeOrder);
+
+	Relabel(newIndices);
+
+	return newIndices;
+}
+
+template <typename T>
+void Graph<T>::Relabel(const Vector<unsigned int> &newIndices)
+{
+	for (auto &adjacencies : mAdjacencyList)
 	{
-		node.mVisited = false;
-		node.mInQueue = false;
-		node.mCost = std::numeric_limits<float>::max();
-		node.mParentNodeIndex = -1;
+		for (auto &adjacency : adjacencies)
+			adjacency.mConnectedNodeIndex = newIndices[adjacency.mConnectedNodeIndex];
+
+		// neighbours in index order: scans walk memory forward
+		std::sort(adjacencies.Begin(), adjacencies.End(), [](const Adjacency &adjacency1, const Adjacency &adjacency2) { return adjacency1.mConnectedNodeIndex < adjacency2.mConnectedNodeIndex; });
 	}
+
+	PermuteInPlace(mNodes, newIndices);
+	PermuteInPlace(mAdjacencyList, newIndices);
+
+	mNodeStates.Reset();
+	mLandmarks = nullptr;
+
+	mComponents.Reset(mNodes.Size());
+
+	for (unsigned int i = 0; i < mAdjacencyList.Size(); i++)
+		for (auto &adjacency : mAdjacencyList[i])
+			mComponents.Union(i, adjacency.mConnectedNodeIndex);
+}
+
+template <typename T>
+Vector<unsigned int> Graph<T>::StronglyConnectedComponents(unsigned int *numComponents) const
+{
+	CsrGraph csr;
+	csr.Build(*this);
+
+	Vector<unsigned int> components;
+	unsigned int count = TarjanStronglyConnectedComponents(csr.View(), components);
+
+	if (numComponents)
+		*numComponents = count;
+
+	return components;
+}
+
+template <typename T>
+bool Graph<T>::TopologicalSort(Vector<unsigned int> &order) const
+{
+	CsrGraph csr;
+	csr.Build(*this);
+
+	return ::TopologicalSort(csr.View(), order);
 }
 
 template <typename T>
@@ -106,7 +212,7 @@ template <typename T>
 int Graph<T>::GetUnvisitedAdjacentNodeIndex(unsigned int nodeIndex) const
 {
 	for (auto &adjacency : mAdjacencyList[nodeIndex])
-		if (!mNodes[adjacency.mConnectedNodeIndex].mVisited)
+		if (!mNodeStates.Visited(adjacency.mConnectedNodeIndex))
 			return adjacency.mConnectedNodeIndex;
 
 	return -1;
@@ -116,74 +222,81 @@ template <typename T>
 template <template <typename> class F>
 void Graph<T>::DepthFirstSearchRecursive(F<T> &visitor, unsigned int startNodeIndex) const
 {
-	static unsigned int level = 0U;
-
-	level++;
+	ScratchLease<DepthFirstScratch> scratch(mDepthFirstScratch, mDepthFirstScratchInUse);
 
-	const Node &node = mNodes[startNodeIndex];
+	VisitMarks &visitMarks = scratch.Get().mVisitMarks;
+	visitMarks.Reset(mNodes.Size());
 
-	visitor.Visit(node);
-	node.mVisited = true;
-
-	unsigned int unvisitedAdjacentNodeIndex;
-	while ((unvisitedAdjacentNodeIndex = GetUnvisitedAdjacentNodeIndex(startNodeIndex)) != -1)
-		DepthFirstSearchRecursive(visitor, unvisitedAdjacentNodeIndex);
+	DepthFirstSearchRecursive(visitor, startNodeIndex, visitMarks);
+}
 
-	level--;
+template <typename T>
+template <template <typename> class F>
+void Graph<T>::DepthFirstSearchRecursive(F<T> &visitor, unsigned int nodeIndex, VisitMarks &visitMarks) const
+{
+	visitor.Visit(mNodes[nodeIndex]);
+	visitMarks.Visit(nodeIndex);
 
-	if (level == 0U)  // end of recursion - reset node flags
-		Reset(); 
+	for (const Adjacency &adjacency : mAdjacencyList[nodeIndex])   // each adjacency is examined once
+		if (!visitMarks.Visited(adjacency.mConnectedNodeIndex))
+			DepthFirstSearchRecursive(visitor, adjacency.mConnectedNodeIndex, visitMarks);
 }
 
-#include "../../ADT/stack/stack.hpp"
-
 template <typename T>
-template <template <typename> class F>
-void Graph<T>::DepthFirstSearch(F<T> &visitor, unsigned int startNodeIndex) const
+template <typename Pre, typename Post>
+bool Graph<T>::DepthFirstTraversal(unsigned int startNodeIndex, const Pre &preVisitor, const Post &postVisitor) const
 {
-	Stack<unsigned int> stack;
+	ScratchLease<DepthFirstScratch> scratch(mDepthFirstScratch, mDepthFirstScratchInUse);
+
+	Vector<DepthFirstFrame> &stack = scratch.Get().mStack;
+	VisitMarks &visitMarks = scratch.Get().mVisitMarks;
+
+	stack.Resize(0);   // keeps capacity
+	visitMarks.Reset(mNodes.Size());
 
-	const Node &startNode = mNodes[startNodeIndex];
-	visitor.Visit(startNode);
-	startNode.mVisited = true;
+	visitMarks.Visit(startNodeIndex);
+	if (!CallVisitor(preVisitor, startNodeIndex))
+		return false;
 
-	stack.Push(startNodeIndex);
+	stack.InsertLast(DepthFirstFrame{startNodeIndex, 0U});
 
 	while (!stack.Empty())
 	{
-		unsigned int currentNodeIndex = stack.Top();
+		DepthFirstFrame &frame = stack.Last();
+		const Vector<Adjacency> &adjacencies = mAdjacencyList[frame.mNodeIndex];
 
-		unsigned int unvisitedAdjacentNodeIndex;
-		if ((unvisitedAdjacentNodeIndex = GetUnvisitedAdjacentNodeIndex(currentNodeIndex)) != -1)	
+		// resume scanning the adjacency list where this frame left off
+		while (frame.mNextAdjacency < adjacencies.Size() && visitMarks.Visited(adjacencies[frame.mNextAdjacency].mConnectedNodeIndex))
+			frame.mNextAdjacency++;
+
+		if (frame.mNextAdjacency < adjacencies.Size())
 		{
-			const Node &node = mNodes[unvisitedAdjacentNodeIndex];
-			visitor.Visit(node);
-			node.mVisited = true;
+			unsigned int adjacentNodeIndex = adjacencies[frame.mNextAdjacency++].mConnectedNodeIndex;
 
-			stack.Push(unvisitedAdjacentNodeIndex);
+			visitMarks.Visit(adjacentNodeIndex);
+			if (!CallVisitor(preVisitor, adjacentNodeIndex))
+				return false;
+
+			stack.InsertLast(DepthFirstFrame{adjacentNodeIndex, 0U});   // invalidates frame
 		}
 		else
-			stack.Pop();
-	}	
-
-	// stack.Push(startNodeIndex);
-
-	// while (!stack.Empty())
-	// {
-	// 	unsigned int currentNodeIndex = stack.Top();
+		{
+			unsigned int nodeIndex = frame.mNodeIndex;
+			stack.RemoveLast();
 
-	// 	const Node &node = mNodes[startNodeIndex];
-	// 	visitor.Visit(node);
-	// 	node.mVisited = true;
+			if (!CallVisitor(postVisitor, nodeIndex))
+				return false;
+		}
+	}
 
-	// 	unsigned int unvisitedAdjacentNodeIndex;
-	// 	while ((unvisitedAdjacentNodeIndex = GetUnvisitedAdjacentNodeIndex(currentNodeIndex)) != -1)	
-	// 		stack.Push(unvisitedAdjacentNodeIndex);
-		
-	// 	stack.Pop();
-	// }
+	return true;
+}
 
-	Reset();
+template <typename T>
+template <template <typename> class F>
+void Graph<T>::DepthFirstSearch(F<T> &visitor, unsigned int startNodeIndex) const
+{
+	DepthFirstTraversal(startNodeIndex, [this, &visitor](unsigned int nodeIndex) { visitor.Visit(mNodes[nodeIndex]); });
 }
 
 #include "../../ADT/queue/queue.hpp"
@@ -194,9 +307,8 @@ void Graph<T>::BreadthFirstSearch(F<T> &visitor, unsigned int startNodeIndex) co
 {
 	Queue<unsigned int> queue;
 
-	const Node &startNode = mNodes[startNodeIndex];
-	visitor.Visit(startNode);
-	startNode.mVisited = true;
+	visitor.Visit(mNodes[startNodeIndex]);
+	mNodeStates.SetVisited(startNodeIndex);
 
 	queue.Enqueue(startNodeIndex);
 
@@ -207,9 +319,8 @@ void Graph<T>::BreadthFirstSearch(F<T> &visitor, unsigned int startNodeIndex) co
 		unsigned int unvisitedAdjacentNodeIndex;
 		if ((unvisitedAdjacentNodeIndex = GetUnvisitedAdjacentNodeIndex(currentNodeIndex)) != -1)
 		{
-			const Node &node = mNodes[unvisitedAdjacentNodeIndex];
-			visitor.Visit(node);
-			node.mVisited = true;
+			visitor.Visit(mNodes[unvisitedAdjacentNodeIndex]);
+			mNodeStates.SetVisited(unvisitedAdjacentNodeIndex);
 
 			queue.Enqueue(unvisitedAdjacentNodeIndex);
 		}
@@ -226,11 +337,11 @@ void Graph<T>::BreadthFirstSearch(F<T> &visitor, unsigned int startNodeIndex) co
 #include "../../ADT/priority queue/priority_queue.hpp"
 
 template <typename T>
-Vector<Vector<unsigned int>> Graph<T>::DijkstraShortestPath(unsigned int startNodeIndex) const
+ShortestPathTree Graph<T>::DijkstraShortestPath(unsigned int startNodeIndex) const
 {
-	PriorityQueue<unsigned int> queue([this](unsigned int nodeIndex1, unsigned int nodeIndex2){ return mNodes[nodeIndex1].mCost < mNodes[nodeIndex2].mCost; });
+	PriorityQueue<unsigned int> queue([this](unsigned int nodeIndex1, unsigned int nodeIndex2){ return mNodeStates.Cost(nodeIndex1) < mNodeStates.Cost(nodeIndex2); });
 	
-	mNodes[startNodeIndex].mCost = 0.0f;
+	mNodeStates.Cost(startNodeIndex) = 0.0f;
 
 	queue.Insert(startNodeIndex);
 
@@ -240,56 +351,48 @@ Vector<Vector<unsigned int>> Graph<T>::DijkstraShortestPath(unsigned int startNo
 
 		for (auto &adjacency : mAdjacencyList[currentNodeIndex])
 		{
-			if (mNodes[adjacency.mConnectedNodeIndex].mVisited)
+			if (mNodeStates.Visited(adjacency.mConnectedNodeIndex))
 				continue;
 
 			float weight = adjacency.mWeight;
-			float newCost = mNodes[currentNodeIndex].mCost + weight;
+			float newCost = mNodeStates.Cost(currentNodeIndex) + weight;
 
-			if (newCost < mNodes[adjacency.mConnectedNodeIndex].mCost)
+			if (newCost < mNodeStates.Cost(adjacency.mConnectedNodeIndex))
 			{
-				mNodes[adjacency.mConnectedNodeIndex].mCost = newCost;
-				mNodes[adjacency.mConnectedNodeIndex].mParentNodeIndex = currentNodeIndex;
+				mNodeStates.Cost(adjacency.mConnectedNodeIndex) = newCost;
+				mNodeStates.Parent(adjacency.mConnectedNodeIndex) = currentNodeIndex;
 
-				if (!mNodes[adjacency.mConnectedNodeIndex].mInQueue)
+				if (!mNodeStates.InQueue(adjacency.mConnectedNodeIndex))
 				{
 					queue.Insert(adjacency.mConnectedNodeIndex);
-					mNodes[adjacency.mConnectedNodeIndex].mInQueue = true;   // node's cost has been relaxed but all its neighbours have not been examined from it yet
+					mNodeStates.SetInQueue(adjacency.mConnectedNodeIndex);   // node's cost has been relaxed but all its neighbours have not been examined from it yet
 				}
 			}
 		}
 
 		queue.Remove();
-		mNodes[currentNodeIndex].mVisited = true;  // all node's neighbours have been examined from it
+		mNodeStates.SetVisited(currentNodeIndex);  // all node's neighbours have been examined from it
 	}
 
-	Vector<Vector<unsigned int>> paths;
-	paths.Resize(mNodes.Size());
+	ShortestPathTree shortestPathTree(mNodes.Size(), startNodeIndex);
 
 	for (unsigned int i = 0; i < mNodes.Size(); ++i)
 	{
-		Vector<unsigned int> &path = paths[i];
-
-		unsigned int currentNodeIndex = i;
-
-		while (currentNodeIndex != -1)
-		{
-			path.InsertFirst(currentNodeIndex);
-			currentNodeIndex = mNodes[currentNodeIndex].mParentNodeIndex;
-		}
+		shortestPathTree.Distances()[i] = mNodeStates.Cost(i);
+		shortestPathTree.Parents()[i] = mNodeStates.Parent(i);
 	}
 
 	Reset();
 
-	return paths;
+	return shortestPathTree;
 }
 
 template <typename T>
 Vector<unsigned int> Graph<T>::DijkstraShortestPath(unsigned int startNodeIndex, unsigned int endNodeIndex) const
 {
-	PriorityQueue<unsigned int> queue([this](unsigned int nodeIndex1, unsigned int nodeIndex2) { return mNodes[nodeIndex1].mCost < mNodes[nodeIndex2].mCost; });
+	PriorityQueue<unsigned int> queue([this](unsigned int nodeIndex1, unsigned int nodeIndex2) { return mNodeStates.Cost(nodeIndex1) < mNodeStates.Cost(nodeIndex2); });
 	
-	mNodes[startNodeIndex].mCost = 0.0f;
+	mNodeStates.Cost(startNodeIndex) = 0.0f;
 
 	queue.Insert(startNodeIndex);
 
@@ -302,27 +405,27 @@ Vector<unsigned int> Graph<T>::DijkstraShortestPath(unsigned int startNodeIndex,
 
 		for (auto &adjacency : mAdjacencyList[currentNodeIndex])
 		{			
-			if (mNodes[adjacency.mConnectedNodeIndex].mVisited)
+			if (mNodeStates.Visited(adjacency.mConnectedNodeIndex))
 				continue;
 
 			float weight = adjacency.mWeight;
-			float newCost = mNodes[currentNodeIndex].mCost + weight;
+			float newCost = mNodeStates.Cost(currentNodeIndex) + weight;
 
-			if (newCost < mNodes[adjacency.mConnectedNodeIndex].mCost)
+			if (newCost < mNodeStates.Cost(adjacency.mConnectedNodeIndex))
 			{
-				mNodes[adjacency.mConnectedNodeIndex].mCost = newCost;
-				mNodes[adjacency.mConnectedNodeIndex].mParentNodeIndex = currentNodeIndex;
+				mNodeStates.Cost(adjacency.mConnectedNodeIndex) = newCost;
+				mNodeStates.Parent(adjacency.mConnectedNodeIndex) = currentNodeIndex;
 
-				if (!mNodes[adjacency.mConnectedNodeIndex].mInQueue)
+				if (!mNodeStates.InQueue(adjacency.mConnectedNodeIndex))
 				{
 					queue.Insert(adjacency.mConnectedNodeIndex);
-					mNodes[adjacency.mConnectedNodeIndex].mInQueue = true;   // node's cost has been relaxed but all its neighbours have not been examined from it yet
+					mNodeStates.SetInQueue(adjacency.mConnectedNodeIndex);   // node's cost has been relaxed but all its neighbours have not been examined from it yet
 				}
 			}
 		}
 
 		queue.Remove();
-		mNodes[currentNodeIndex].mVisited = true;  // all node's neighbours have been examined from it
+		mNodeStates.SetVisited(currentNodeIndex);  // all node's neighbours have been examined from it
 	}
 
 	Vector<unsigned int> path;
@@ -331,10 +434,10 @@ Vector<unsigned int> Graph<T>::DijkstraShortestPath(unsigned int startNodeIndex,
 
 	unsigned int currentNodeIndex = endNodeIndex;
 
-	while (mNodes[currentNodeIndex].mParentNodeIndex != -1)
+	while (mNodeStates.Parent(currentNodeIndex) != -1)
 	{
-		path.InsertFirst(mNodes[currentNodeIndex].mParentNodeIndex);
-		currentNodeIndex = mNodes[currentNodeIndex].mParentNodeIndex;
+		path.InsertFirst(mNodeStates.Parent(currentNodeIndex));
+		currentNodeIndex = mNodeStates.Parent(currentNodeIndex);
 	}
 
 	Reset();
@@ -345,20 +448,17 @@ Vector<unsigned int> Graph<T>::DijkstraShortestPath(unsigned int startNodeIndex,
 template <typename T>
 Vector<unsigned int> Graph<T>::AStar(unsigned int startNodeIndex, unsigned int endNodeIndex) const
 {
-	for (unsigned int i = 0U; i < mNodes.Size(); i++)
-		mNodes[i].mHeuristic = GetNodeHeuristic(i, endNodeIndex);
+	// the heuristic of a node is evaluated when the node is first reached
+	PriorityQueue<unsigned int> queue([this](unsigned int nodeIndex1, unsigned int nodeIndex2) { return mNodeStates.Cost(nodeIndex1) + mNodeStates.Heuristic(nodeIndex1) < mNodeStates.Cost(nodeIndex2) + mNodeStates.Heuristic(nodeIndex2); });
 
-	PriorityQueue<unsigned int> queue([this](unsigned int nodeIndex1, unsigned int nodeIndex2) { return mNodes[nodeIndex1].mCost + mNodes[nodeIndex1].mHeuristic < mNodes[nodeIndex2].mCost + mNodes[nodeIndex2].mHeuristic; });
-
-	const Node &startNode = mNodes[startNodeIndex];
-	startNode.mCost = 0.0f;
+	mNodeStates.Cost(startNodeIndex) = 0.0f;
+	mNodeStates.Heuristic(startNodeIndex) = GetNodeHeuristic(startNodeIndex, endNodeIndex);
 
 	queue.Insert(startNodeIndex);
 	
 	while (!queue.Empty())
 	{
 		unsigned int currentNodeIndex = queue.Peek();
-		const Node &currentNode = mNodes[currentNodeIndex];
 
 		if (currentNodeIndex == endNodeIndex)
 			break;
@@ -366,28 +466,30 @@ Vector<unsigned int> Graph<T>::AStar(unsigned int startNodeIndex, unsigned int e
 		for (auto &adjacency : mAdjacencyList[currentNodeIndex])
 		{
 			unsigned int adjacentNodeIndex = adjacency.mConnectedNodeIndex;
-			const Node &adjacentNode = mNodes[adjacentNodeIndex];
 
-			if (adjacentNode.mVisited)
+			if (mNodeStates.Visited(adjacentNodeIndex))
 				continue;
 
 			float weight = adjacency.mWeight;
-			float newCost = currentNode.mCost + weight;
+			float newCost = mNodeStates.Cost(currentNodeIndex) + weight;
 
-			if (newCost < adjacentNode.mCost)
+			if (newCost < mNodeStates.Cost(adjacentNodeIndex))
 			{
-				adjacentNode.mCost = newCost;
-				adjacentNode.mParentNodeIndex = currentNodeIndex;
+				if (mNodeStates.Cost(adjacentNodeIndex) == NodeStates::INF)
+					mNodeStates.Heuristic(adjacentNodeIndex) = GetNodeHeuristic(adjacentNodeIndex, endNodeIndex);
+
+				mNodeStates.Cost(adjacentNodeIndex) = newCost;
+				mNodeStates.Parent(adjacentNodeIndex) = currentNodeIndex;
 
-				if (!adjacentNode.mInQueue)
+				if (!mNodeStates.InQueue(adjacentNodeIndex))
 				{
 					queue.Insert(adjacentNodeIndex);
-					adjacentNode.mInQueue = true;
+					mNodeStates.SetInQueue(adjacentNodeIndex);
 				}
 			}
 		}
 
-		currentNode.mVisited = true;
+		mNodeStates.SetVisited(currentNodeIndex);
 		queue.Remove();
 	}	
 
@@ -398,7 +500,7 @@ Vector<unsigned int> Graph<T>::AStar(unsigned int startNodeIndex, unsigned int e
 	while (currentNodeIndex != -1)
 	{	
 		path.InsertFirst(currentNodeIndex);
-		currentNodeIndex = mNodes[currentNodeIndex].mParentNodeIndex;
+		currentNodeIndex = mNodeStates.Parent(currentNodeIndex);
 	}
 
 	Reset();
@@ -409,7 +511,7 @@ Vector<unsigned int> Graph<T>::AStar(unsigned int startNodeIndex, unsigned int e
 template <typename T>
 float Graph<T>::GetNodeHeuristic(unsigned int nodeIndex, unsigned int endNodeIndex) const
 {
-	return 0.0f;
+	return mLandmarks ? mLandmarks->Distance(nodeIndex, endNodeIndex) : 0.0f;
 }
 
 #include <iostream>
@@ -69,7 +69,7 @@ int main(int argc, char **argv)
 
     auto shortestPaths = gi.DijkstraShortestPath(0);
 
-    for (auto node : shortestPaths[6])
+    for (auto node : shortestPaths.GetPath(6))
         std:: cout << node << " ";   
     std::cout << std::endl;
 
@@ -138,7 +138,7 @@ int main(int argc, char **argv)
 
     NodeVisitor<Vector2D> vv;
 
-    for (auto nodeIndex : shortestPath2[2])
+    for (auto nodeIndex : shortestPath2.GetPath(2))
         std::cout << gv.GetData(nodeIndex) << " ";
     std::cout << '\n';
 
@@ -1,4 +1,7 @@
 #include "../vector/vector.hpp"
+#include "../disjoint set/disjoint_set.hpp"
+#include "shortest_path_tree.hpp"
+#include "minimum_spanning_tree.hpp"
 #include <limits>
 
 template <typename T, typename Heuristic>
@@ -47,6 +50,8 @@ public:
     
     void AddEdge(unsigned int nodeIndex1, unsigned int nodeIndex2, float weight = 1.0f, bool directed = false);
 
+    bool Reachable(unsigned int nodeIndex1, unsigned int nodeIndex2) const { return mComponents.Connected(nodeIndex1, nodeIndex2); }   // ignoring edge direction, near O(1)
+
     int GetUnvisitedAdjacentNodeIndex(unsigned int nodeIndex) const;
 
     template <typename F>
@@ -58,17 +63,20 @@ public:
     template <typename F>
     void DepthFirstSearchRecursive(unsigned int nodeIndex, const F&f);
 
-    Vector<Path> DijkstraShortestPath(unsigned int startNodeIndex) const; 
+    ShortestPathTree DijkstraShortestPath(unsigned int startNodeIndex) const;
     
     Path DijkstraShortestPath(unsigned int startNodeIndex, unsigned int endNodeIndex) const; 
     
     Path AStar(unsigned int startNodeIndex, unsigned int endNodeIndex) const;
 
+    Vector<SpanningTreeEdge> MinimumSpanningTree() const;   // Prim with an indexed heap, edges are treated as undirected
+
 private:
     static const float INF;
     Vector<Node> mNodes;                           // ordered list of nodes
     Vector<Edge> mEdges;                           // ordered list of edges
     Vector<Vector<unsigned int>> mAdjacencyList;   // ordered list of lists of references (indices) to edges in the edge list
+    DisjointSet mComponents;                       // connected components, updated incrementally as edges are added
 };
 
 template <typename T, typename Heuristic>
@@ -79,6 +87,7 @@ void Graph<T, Heuristic>::AddNode(const T &data)
 {
     mNodes.InsertLast(Node{data});
     mAdjacencyList.InsertLast(Vector<unsigned int>());  // to each node corresponds a list of edges
+    mComponents.MakeSet();
 }
 
 template <typename T, typename Heuristic>
@@ -94,6 +103,8 @@ void Graph<T, Heuristic>::AddEdge(unsigned int nodeIndex1, unsigned int nodeInde
             mEdges.InsertLast(Edge{nodeIndex2, nodeIndex1, weight});
             mAdjacencyList[nodeIndex2].InsertLast(mEdges.Size() - 1);  
         }
+
+        mComponents.Union(nodeIndex1, nodeIndex2);
     }
 }
 
@@ -107,6 +118,16 @@ int Graph<T, Heuristic>::GetUnvisitedAdjacentNodeIndex(unsigned int nodeIndex) c
     return -1;
 }
 
+template <typename T, typename Heuristic>
+Vector<SpanningTreeEdge> Graph<T, Heuristic>::MinimumSpanningTree() const
+{
+    return PrimMinimumSpanningTree(mNodes.Size(), [this](unsigned int nodeIndex, const auto &f)
+    {
+        for (unsigned int edgeIndex : mAdjacencyList[nodeIndex])
+            f(mEdges[edgeIndex].destinationNodeIndex, mEdges[edgeIndex].weight);
+    });
+}
+
 #include "../ADT/queue/queue.hpp"
 
 template <typename T, typename Heuristic>
@@ -195,7 +216,7 @@ void Graph<T, Heuristic>::DepthFirstSearchRecursive(unsigned int nodeIndex, cons
 #include "../ADT/priority queue/priority_queue.hpp"
 
 template <typename T, typename Heuristic>
-Vector<typename Graph<T, Heuristic>::Path> Graph<T, Heuristic>::DijkstraShortestPath(unsigned int startNodeIndex) const
+ShortestPathTree Graph<T, Heuristic>::DijkstraShortestPath(unsigned int startNodeIndex) const
 {
     for (unsigned int i = 0; i < mNodes.Size(); i++)
     {
@@ -239,28 +260,15 @@ Vector<typename Graph<T, Heuristic>::Path> Graph<T, Heuristic>::DijkstraShortest
         }
     }
 
-    Vector<Path> paths;
-    paths.Resize(mNodes.Size());
+    ShortestPathTree shortestPathTree(mNodes.Size(), startNodeIndex);
 
     for (unsigned int i = 0; i < mNodes.Size(); i++)
     {
-        if (i == startNodeIndex)
-        {
-            paths[i].InsertFirst(&mNodes[i]);
-            continue;
-        }
-
-        unsigned int currentNodeIndex = i;
-        do 
-        {
-            paths[i].InsertFirst(&mNodes[currentNodeIndex]);
-            currentNodeIndex = mNodes[currentNodeIndex].parentNodeIndex;
-        } while (currentNodeIndex != startNodeIndex);
-
-        paths[i].InsertFirst(&mNodes[startNodeIndex]);
+        shortestPathTree.Distances()[i] = mNodes[i].distance;
+        shortestPathTree.Parents()[i] = mNodes[i].parentNodeIndex;
     }
     
-    return paths;
+    return shortestPathTree;
 }
 
 template <typename T, typename Heuristic>
@@ -2,7 +2,18 @@
 #define GRAPH_H
 
 #include "../vector/vector.hpp"
+#include "../segmented vector/segmented_vector.hpp"
+#include "../disjoint set/disjoint_set.hpp"
+#include "graph_traversal.hpp"
+#include "node_states.hpp"
+#include "graph_reorder.hpp"
+#include "shortest_path_tree.hpp"
+#include "landmark_heuristic.hpp"
+#include "graph_components.hpp"
+#include "multi_source_bfs.hpp"
+#include "minimum_spanning_tree.hpp"
 #include <limits>
+#include <type_traits>
 
 template <typename T, typename Heuristic>
 class Graph;
@@ -25,14 +36,9 @@ class Graph
     friend Heuristic;
 
 public:
-	struct Node
+	struct Node   // payload only, traversal state lives in mNodeStates
 	{
 		T data;
-
-		mutable bool mVisited{false};
-		mutable int mParentNodeIndex{-1};
-		mutable float mCost{std::numeric_limits<float>::max()};
-		mutable float mHeuristic{0.0f};
 	};
 
 	struct Adjacency
@@ -41,24 +47,87 @@ public:
 		float mWeight;
 	};
 
+	struct EdgeWeightUpdate   // new weight of the directed edge source -> destination
+	{
+		unsigned int mSourceNodeIndex;
+		unsigned int mDestinationNodeIndex;
+		float mWeight;
+	};
+
+	// stable reference to a node: survives removal of other nodes and Compact(), goes stale once its node is removed
+	struct NodeHandle
+	{
+		unsigned int mSlot;
+		unsigned int mGeneration;
+	};
+
 public:
-	void AddNode(const T &data);
+	NodeHandle AddNode(const T &data);
+
+	void Reserve(unsigned int numNodes);   // preallocate storage for bulk loading
 
+	void ReserveEdges(unsigned int nodeIndex, unsigned int numEdges) { mAdjacencyList[nodeIndex].Reserve(numEdges); }
+
+	// O(degree) removal: the node's edges are dropped through the reverse adjacency lists and the node is left as a
+	// tombstone (no edges, indices of the other nodes do not change) until Compact(). per node results stay indexed up to
+	// Size(), tombstones are left out of them: NO_COMPONENT, not in a topological order, UNREACHED, no spanning tree edge
 	void RemoveNode(unsigned int nodeIndex);
 
+	bool Removed(unsigned int nodeIndex) const { return mNodeHandles[nodeIndex] == REMOVED; }
+
+	// drop tombstones and close the gaps, returns the old to new index map (-1 for removed nodes), handles stay valid
+	Vector<int> Compact();
+
+	NodeHandle GetHandle(unsigned int nodeIndex) const { return NodeHandle{mNodeHandles[nodeIndex], mHandleSlots[mNodeHandles[nodeIndex]].mGeneration}; }
+
+	int GetNodeIndex(NodeHandle handle) const;   // -1 if the node has been removed
+
 	void AddEdge(unsigned int node1, unsigned int node2, float weight = 1.0f, bool directed = false);
 
-	unsigned int Size() const { return mNodes.Size(); }
+	bool RemoveEdge(unsigned int node1, unsigned int node2, bool directed = false);   // O(degree), false if there is no such edge
+
+	// batch weight change (an undirected edge needs an update in each direction), returns the number of edges found
+	unsigned int UpdateEdgeWeights(const EdgeWeightUpdate *updates, unsigned int numUpdates);
+	unsigned int UpdateEdgeWeights(const Vector<EdgeWeightUpdate> &updates) { return UpdateEdgeWeights(updates.Data(), updates.Size()); }
+
+	unsigned int Size() const { return mNodes.Size(); }   // index bound, including tombstones
+
+	unsigned int NumNodes() const { return mNodes.Size() - mNumRemovedNodes; }
 
 	bool Connected(unsigned int node1, unsigned int node2) const;
 
+	Vector<Adjacency> const &GetAdjacencies(unsigned int nodeIndex) const { return mAdjacencyList[nodeIndex]; }
+
+	// ignoring edge direction, O(log n). the first query after a removal rebuilds the components: not safe to call
+	// concurrently then, safe between modifications
+	bool Reachable(unsigned int node1, unsigned int node2) const;
+
+	// relabel nodes so that nodes traversed together are close in memory, returns the old to new index map (newIndices[oldNodeIndex])
+	Vector<unsigned int> Reorder(NodeOrder nodeOrder);
+
+	void Relabel(const Vector<unsigned int> &newIndices);   // move every node i to index newIndices[i], in place
+
+	// strongly connected components (iterative Tarjan), ids in reverse topological order of the condensation (NO_COMPONENT for tombstones)
+	Vector<unsigned int> StronglyConnectedComponents(unsigned int *numComponents = nullptr) const;
+
+	bool TopologicalSort(Vector<unsigned int> &order) const;   // Kahn over the live nodes, false if the graph has a cycle
+
+	// minimum spanning forest of the undirected graph: Prim with an indexed heap, or parallel Boruvka over a CSR copy
+	Vector<SpanningTreeEdge> MinimumSpanningTree() const;
+	Vector<SpanningTreeEdge> ParallelMinimumSpanningTree() const;
+
 	int GetUnvisitedAdjacentNodeIndex(unsigned int nodeIndex) const;
 	
-    void Clear() { mNodes.Clear(); mAdjacencyList.Clear(); }
+	void Clear();
 
 	void Reset() const;
 
-	T const &GetData(unsigned int nodeIndex) { return mNodes[nodeIndex].mData; }
+	T const &GetData(unsigned int nodeIndex) const { return mNodes[nodeIndex].data; }
+
+	// iterative depth first traversal, preVisitor(nodeIndex) is called when a node is discovered and postVisitor(nodeIndex) when all
+	// its descendants are done, a visitor returning false stops the traversal (return value is false if stopped early)
+	template <typename Pre, typename Post = NullVisitor>
+	bool DepthFirstTraversal(unsigned int startNodeIndex, const Pre &preVisitor, const Post &postVisitor = Post()) const;
 
 	template <template <typename> typename  F>
 	void DepthFirstSearch(unsigned int startNodeIndex, const F<T> &visitor) const;
@@ -69,38 +138,198 @@ public:
 	template <template <typename> typename F>
 	void BreadthFirstSearch(unsigned int startNodeIndex, const F<T> &visitor) const;
 
-	Vector<Vector<const Node*>> DijkstraShortestPath(unsigned int startNodeIndex) const;
+	// hop distances from many sources at once (bit parallel, 256 sources per adjacency scan): distances[i * Size() + nodeIndex]
+	// from sources[i], MultiSourceBreadthFirstSearch<>::UNREACHED if not reachable
+	Vector<unsigned int> BreadthFirstDistances(const Vector<unsigned int> &sources) const;
+
+	ShortestPathTree DijkstraShortestPath(unsigned int startNodeIndex) const;
+
+	// bring a shortest path tree of this graph up to date after UpdateEdgeWeights(updates): only the subtrees hanging from
+	// lengthened tree edges and the nodes improved by shortened edges are recomputed (dynamic Dijkstra, non negative weights)
+	void RepairShortestPathTree(ShortestPathTree &shortestPathTree, const EdgeWeightUpdate *updates, unsigned int numUpdates) const;
+	void RepairShortestPathTree(ShortestPathTree &shortestPathTree, const Vector<EdgeWeightUpdate> &updates) const { RepairShortestPathTree(shortestPathTree, updates.Data(), updates.Size()); }
 	Vector<const Node*> DijkstraShortestPath(unsigned int startNodeIndex, unsigned int endNodeIndex) const;
 
 	Vector<const Node*> AStar(unsigned int startNodeIndex, unsigned int endNodeIndex) const;
 
+	// for heuristics holding precomputed data (LandmarkHeuristic: follows Relabel, cleared by Compact)
+	void SetHeuristic(const Heuristic &heuristic) { mHeuristic = heuristic; }
+	Heuristic const &GetHeuristic() const { return mHeuristic; }
+
 private:
-	Vector<Node> mNodes;
+	static constexpr unsigned int REMOVED = std::numeric_limits<unsigned int>::max();
+
+	struct HandleSlot
+	{
+		int mNodeIndex;             // -1 while the slot is free
+		unsigned int mGeneration;   // bumped when the slot is freed, outstanding handles become stale
+	};
+
+	SegmentedVector<Node> mNodes;   // stable addresses, the Node pointers of a path survive AddNode
+	mutable NodeStates mNodeStates;
 	Vector<Vector<Adjacency>> mAdjacencyList;
+	Vector<Vector<unsigned int>> mReverseAdjacencyList;   // source node of every incoming edge (one entry per edge)
+
+	Vector<unsigned int> mNodeHandles;     // handle slot of every node, REMOVED for tombstones
+	Vector<HandleSlot> mHandleSlots;
+	Vector<unsigned int> mFreeHandleSlots;
+	unsigned int mNumRemovedNodes = 0;
+
+	mutable DisjointSet mComponents;   // connected components, updated incrementally as edges are added
+	mutable bool mComponentsStale = false;   // removals cannot be undone in a disjoint set: rebuilt on next query
+
+	Heuristic mHeuristic;
+
+	mutable DepthFirstScratch mDepthFirstScratch;   // stack and visit marks reused across traversals
+	mutable bool mDepthFirstScratchInUse = false;
+
+	mutable MultiSourceBreadthFirstSearch<> mMultiSourceSearch;   // bitsets reused across batched searches
 
 	float GetNodeHeuristic(unsigned int nodeIndex, unsigned int endNodeIndex) const;
+
+	template <template <typename> typename  F>
+	void DepthFirstSearchRecursive(unsigned int nodeIndex, const F<T> &visitor, VisitMarks &visitMarks) const;
+
+	void RebuildComponents() const;
+
+	static bool RemoveAdjacencies(Vector<Adjacency> &adjacencies, unsigned int nodeIndex, bool all);
+	static void RemoveSource(Vector<unsigned int> &sources, unsigned int nodeIndex);
 };
 
 template <typename T, typename Heuristic>
-void Graph<T, Heuristic>::AddNode(const T &data)
+typename Graph<T, Heuristic>::NodeHandle Graph<T, Heuristic>::AddNode(const T &data)
 {
+	unsigned int slot;
+
+	if (mFreeHandleSlots.Empty())
+	{
+		slot = mHandleSlots.Size();
+		mHandleSlots.InsertLast(HandleSlot{-1, 0U});
+	}
+	else
+	{
+		slot = mFreeHandleSlots.Last();
+		mFreeHandleSlots.RemoveLast();
+	}
+
+	mHandleSlots[slot].mNodeIndex = mNodes.Size();
+
 	mNodes.InsertLast(Node{data});
-	mAdjacencyList.Resize(mNodes.Size());
+	mNodeStates.AddNode();
+	mAdjacencyList.InsertLast(Vector<Adjacency>());
+	mReverseAdjacencyList.InsertLast(Vector<unsigned int>());
+	mNodeHandles.InsertLast(slot);
+	mComponents.MakeSet();
+
+	return NodeHandle{slot, mHandleSlots[slot].mGeneration};
+}
+
+template <typename T, typename Heuristic>
+void Graph<T, Heuristic>::Reserve(unsigned int numNodes)
+{
+	mNodes.Reserve(numNodes);
+	mNodeStates.Reserve(numNodes);
+	mAdjacencyList.Reserve(numNodes);
+	mReverseAdjacencyList.Reserve(numNodes);
+	mNodeHandles.Reserve(numNodes);
+	mHandleSlots.Reserve(numNodes);
+	mComponents.Reserve(numNodes);
 }
 
 template <typename T, typename Heuristic>
 void Graph<T, Heuristic>::RemoveNode(unsigned int nodeIndex)
 {
-	mNodes.Remove(nodeIndex);
-	mAdjacencyList.Remove(nodeIndex);
+	if (nodeIndex >= mNodes.Size() || Removed(nodeIndex))
+		return;
 
-	for (auto &nodeAdjacencyList: mAdjacencyList)
-		for (auto it = nodeAdjacencyList.Begin(), end = nodeAdjacencyList.End(); it != end; ++it)
-			if (it->mConnectedNodeIndex == nodeIndex)
-			{
-				nodeAdjacencyList.Remove(it);
-				break;
-			}
+	// incoming edges: only the adjacency lists of the sources are scanned
+	for (unsigned int sourceNodeIndex : mReverseAdjacencyList[nodeIndex])
+		RemoveAdjacencies(mAdjacencyList[sourceNodeIndex], nodeIndex, true);
+
+	// outgoing edges
+	for (const Adjacency &adjacency : mAdjacencyList[nodeIndex])
+		RemoveSource(mReverseAdjacencyList[adjacency.mConnectedNodeIndex], nodeIndex);
+
+	mAdjacencyList[nodeIndex].Clear();
+	mReverseAdjacencyList[nodeIndex].Clear();
+
+	HandleSlot &slot = mHandleSlots[mNodeHandles[nodeIndex]];
+	slot.mNodeIndex = -1;
+	slot.mGeneration++;
+	mFreeHandleSlots.InsertLast(mNodeHandles[nodeIndex]);
+
+	mNodeHandles[nodeIndex] = REMOVED;
+	mNumRemovedNodes++;
+
+	mComponentsStale = true;   // removal can split a component
+}
+
+template <typename T, typename Heuristic>
+Vector<int> Graph<T, Heuristic>::Compact()
+{
+	Vector<int> newIndices;
+	newIndices.Resize(mNodes.Size(), -1);
+
+	unsigned int numNodes = 0;
+
+	for (unsigned int i = 0; i < mNodes.Size(); i++)
+	{
+		if (Removed(i))
+			continue;
+
+		newIndices[i] = numNodes;
+
+		if (i != numNodes)
+		{
+			mNodes[numNodes] = std::move(mNodes[i]);
+			mAdjacencyList[numNodes] = std::move(mAdjacencyList[i]);
+			mReverseAdjacencyList[numNodes] = std::move(mReverseAdjacencyList[i]);
+			mNodeHandles[numNodes] = mNodeHandles[i];
+		}
+
+		mHandleSlots[mNodeHandles[numNodes]].mNodeIndex = numNodes;
+		numNodes++;
+	}
+
+	while (mNodes.Size() > numNodes)
+	{
+		mNodes.RemoveLast();
+		mAdjacencyList.RemoveLast();
+		mReverseAdjacencyList.RemoveLast();
+		mNodeHandles.RemoveLast();
+	}
+
+	for (unsigned int i = 0; i < numNodes; i++)
+	{
+		for (Adjacency &adjacency : mAdjacencyList[i])
+			adjacency.mConnectedNodeIndex = newIndices[adjacency.mConnectedNodeIndex];
+
+		for (unsigned int &sourceNodeIndex : mReverseAdjacencyList[i])
+			sourceNodeIndex = newIndices[sourceNodeIndex];
+	}
+
+	mNodeStates.Clear();
+	mNodeStates.Reserve(numNodes);
+	for (unsigned int i = 0; i < numNodes; i++)
+		mNodeStates.AddNode();
+
+	mNumRemovedNodes = 0;
+
+	if constexpr (std::is_same<Heuristic, LandmarkHeuristic>::value)   // landmark rows of removed nodes are gone, distances may have grown
+		mHeuristic.Clear();
+
+	RebuildComponents();
+
+	return newIndices;
+}
+
+template <typename T, typename Heuristic>
+int Graph<T, Heuristic>::GetNodeIndex(NodeHandle handle) const
+{
+	if (handle.mSlot >= mHandleSlots.Size() || mHandleSlots[handle.mSlot].mGeneration != handle.mGeneration)
+		return -1;
+
+	return mHandleSlots[handle.mSlot].mNodeIndex;
 }
 
 template <typename T, typename Heuristic>
@@ -109,21 +338,226 @@ void Graph<T, Heuristic>::AddEdge(unsigned int nodeIndex1, unsigned int nodeInde
     if (nodeIndex1 < mNodes.Size() && nodeIndex2 < mNodes.Size())
     {
 	    mAdjacencyList[nodeIndex1].InsertLast(Adjacency{ nodeIndex2, weight });
+	    mReverseAdjacencyList[nodeIndex2].InsertLast(nodeIndex1);
 
 	    if (!directed)
+	    {
 		    mAdjacencyList[nodeIndex2].InsertLast(Adjacency{ nodeIndex1, weight });
+		    mReverseAdjacencyList[nodeIndex1].InsertLast(nodeIndex2);
+	    }
+
+	    mComponents.Union(nodeIndex1, nodeIndex2);
     }
 }
 
+template <typename T, typename Heuristic>
+bool Graph<T, Heuristic>::RemoveEdge(unsigned int nodeIndex1, unsigned int nodeIndex2, bool directed)
+{
+	if (nodeIndex1 >= mNodes.Size() || nodeIndex2 >= mNodes.Size() || !RemoveAdjacencies(mAdjacencyList[nodeIndex1], nodeIndex2, false))
+		return false;
+
+	RemoveSource(mReverseAdjacencyList[nodeIndex2], nodeIndex1);
+
+	if (!directed && RemoveAdjacencies(mAdjacencyList[nodeIndex2], nodeIndex1, false))
+		RemoveSource(mReverseAdjacencyList[nodeIndex1], nodeIndex2);
+
+	mComponentsStale = true;
+
+	return true;
+}
+
+template <typename T, typename Heuristic>
+unsigned int Graph<T, Heuristic>::UpdateEdgeWeights(const EdgeWeightUpdate *updates, unsigned int numUpdates)
+{
+	unsigned int numUpdated = 0;
+
+	for (const EdgeWeightUpdate *update = updates; update != updates + numUpdates; ++update)
+		for (Adjacency &adjacency : mAdjacencyList[update->mSourceNodeIndex])
+			if (adjacency.mConnectedNodeIndex == update->mDestinationNodeIndex)
+			{
+				adjacency.mWeight = update->mWeight;
+				numUpdated++;
+				break;
+			}
+
+	return numUpdated;
+}
+
+// remove the first (or every) adjacency to nodeIndex, keeps the order of the others
+template <typename T, typename Heuristic>
+bool Graph<T, Heuristic>::RemoveAdjacencies(Vector<Adjacency> &adjacencies, unsigned int nodeIndex, bool all)
+{
+	unsigned int size = 0;
+	bool removed = false;
+
+	for (unsigned int i = 0; i < adjacencies.Size(); i++)
+	{
+		if (adjacencies[i].mConnectedNodeIndex == nodeIndex && (all || !removed))
+		{
+			removed = true;
+			continue;
+		}
+
+		adjacencies[size++] = adjacencies[i];
+	}
+
+	while (adjacencies.Size() > size)
+		adjacencies.RemoveLast();
+
+	return removed;
+}
+
+template <typename T, typename Heuristic>
+void Graph<T, Heuristic>::RemoveSource(Vector<unsigned int> &sources, unsigned int nodeIndex)
+{
+	for (unsigned int i = 0; i < sources.Size(); i++)
+		if (sources[i] == nodeIndex)
+		{
+			sources[i] = sources.Last();   // order of sources does not matter
+			sources.RemoveLast();
+			return;
+		}
+}
+
+template <typename T, typename Heuristic>
+bool Graph<T, Heuristic>::Reachable(unsigned int nodeIndex1, unsigned int nodeIndex2) const
+{
+	if (mComponentsStale)
+		RebuildComponents();
+
+	return static_cast<const DisjointSet&>(mComponents).Connected(nodeIndex1, nodeIndex2);   // no path halving
+}
+
+template <typename T, typename Heuristic>
+void Graph<T, Heuristic>::RebuildComponents() const
+{
+	mComponents.Reset(mNodes.Size());
+
+	for (unsigned int i = 0; i < mAdjacencyList.Size(); i++)
+		for (auto &adjacency : mAdjacencyList[i])
+			mComponents.Union(i, adjacency.mConnectedNodeIndex);
+
+	mComponentsStale = false;
+}
+
+template <typename T, typename Heuristic>
+void Graph<T, Heuristic>::Clear()
+{
+	mNodes.Clear();
+	mNodeStates.Clear();
+	mAdjacencyList.Clear();
+	mReverseAdjacencyList.Clear();
+	mNodeHandles.Clear();
+	mHandleSlots.Clear();
+	mFreeHandleSlots.Clear();
+	mNumRemovedNodes = 0;
+	mComponents.Reset(0);
+	mComponentsStale = false;
+}
+
 template <typename T, typename Heuristic>
 void Graph<T, Heuristic>::Reset() const
 {
-	for (auto &node : mNodes)
+	mNodeStates.Reset();
+}
+
+template <typename T, typename Heuristic>
+Vector<unsigned int> Graph<T, Heuristic>::Reorder(NodeOrder nodeOrder)
+{
+	Vector<unsigned int> newIndices = ComputeNodeOrder(*this, nodeOrder);
+
+	Relabel(newIndices);
+
+	return newIndices;
+}
+
+template <typename T, typename Heuristic>
+void Graph<T, Heuristic>::Relabel(const Vector<unsigned int> &newIndices)
+{
+	for (auto &adjacencies : mAdjacencyList)
 	{
-		node.mVisited = false;
-		node.mCost = std::numeric_limits<float>::max();
-		node.mParentNodeIndex = -1;
+		for (auto &adjacency : adjacencies)
+			adjacency.mConnectedNodeIndex = newIndices[adjacency.mConnectedNodeIndex];
+
+		// neighbours in index order: scans walk memory forward
+		std::sort(adjacencies.Begin(), adjacencies.End(), [](const Adjacency &adjacency1, const Adjacency &adjacency2) { return adjacency1.mConnectedNodeIndex < adjacency2.mConnectedNodeIndex; });
 	}
+
+	for (auto &sources : mReverseAdjacencyList)
+		for (unsigned int &sourceNodeIndex : sources)
+			sourceNodeIndex = newIndices[sourceNodeIndex];
+
+	PermuteInPlace(mNodes, newIndices);
+	PermuteInPlace(mAdjacencyList, newIndices);
+	PermuteInPlace(mReverseAdjacencyList, newIndices);
+	PermuteInPlace(mNodeHandles, newIndices);
+
+	for (unsigned int i = 0; i < mNodeHandles.Size(); i++)
+		if (!Removed(i))
+			mHandleSlots[mNodeHandles[i]].mNodeIndex = i;
+
+	mNodeStates.Reset();
+
+	if constexpr (std::is_same<Heuristic, LandmarkHeuristic>::value)
+		mHeuristic.Relabel(newIndices);
+
+	RebuildComponents();
+}
+
+template <typename T, typename Heuristic>
+Vector<unsigned int> Graph<T, Heuristic>::StronglyConnectedComponents(unsigned int *numComponents) const
+{
+	CsrGraph csr;
+	csr.Build(*this);
+
+	Vector<unsigned int> components;
+	unsigned int count = TarjanStronglyConnectedComponents(csr.View(), components, [this](unsigned int nodeIndex) { return !Removed(nodeIndex); });
+
+	if (numComponents)
+		*numComponents = count;
+
+	return components;
+}
+
+template <typename T, typename Heuristic>
+bool Graph<T, Heuristic>::TopologicalSort(Vector<unsigned int> &order) const
+{
+	CsrGraph csr;
+	csr.Build(*this);
+
+	return ::TopologicalSort(csr.View(), order, [this](unsigned int nodeIndex) { return !Removed(nodeIndex); });
+}
+
+template <typename T, typename Heuristic>
+Vector<unsigned int> Graph<T, Heuristic>::BreadthFirstDistances(const Vector<unsigned int> &sources) const
+{
+	Vector<unsigned int> distances = mMultiSourceSearch.Run(*this, sources);
+
+	// a tombstone has no edges: as a source it only reaches itself
+	for (unsigned int i = 0; i < sources.Size(); i++)
+		if (Removed(sources[i]))
+			distances[static_cast<size_t>(i) * Size() + sources[i]] = MultiSourceBreadthFirstSearch<>::UNREACHED;
+
+	return distances;
+}
+
+template <typename T, typename Heuristic>
+Vector<SpanningTreeEdge> Graph<T, Heuristic>::MinimumSpanningTree() const
+{
+	return PrimMinimumSpanningTree(mNodes.Size(), [this](unsigned int nodeIndex, const auto &f)
+	{
+		for (const Adjacency &adjacency : mAdjacencyList[nodeIndex])
+			f(adjacency.mConnectedNodeIndex, adjacency.mWeight);
+	});
+}
+
+template <typename T, typename Heuristic>
+Vector<SpanningTreeEdge> Graph<T, Heuristic>::ParallelMinimumSpanningTree() const
+{
+	CsrGraph csr;
+	csr.Build(*this);
+
+	return ParallelBoruvkaMinimumSpanningTree(csr.View());
 }
 
 template <typename T, typename Heuristic>
@@ -140,7 +574,7 @@ template <typename T, typename Heuristic>
 int Graph<T, Heuristic>::GetUnvisitedAdjacentNodeIndex(unsigned int nodeIndex) const
 {
 	for (const auto &adjacency : mAdjacencyList[nodeIndex])
-		if (!mNodes[adjacency.mConnectedNodeIndex].mVisited)
+		if (!mNodeStates.Visited(adjacency.mConnectedNodeIndex))
 			return adjacency.mConnectedNodeIndex;
 
 	return -1;
@@ -150,77 +584,81 @@ template <typename T, typename Heuristic>
 template <template <typename> class F>
 void Graph<T, Heuristic>::DepthFirstSearchRecursive(unsigned int startNodeIndex, const F<T> &visitor) const
 {
-	static unsigned int level = 0U;
-
-	level++;
-
-	const Node &node = mNodes[startNodeIndex];
+	ScratchLease<DepthFirstScratch> scratch(mDepthFirstScratch, mDepthFirstScratchInUse);
 
-	visitor(node);
-	node.mVisited = true;
+	VisitMarks &visitMarks = scratch.Get().mVisitMarks;
+	visitMarks.Reset(mNodes.Size());
 
-	unsigned int unvisitedAdjacentNodeIndex;
-	while ((unvisitedAdjacentNodeIndex = GetUnvisitedAdjacentNodeIndex(startNodeIndex)) != -1)
-		DepthFirstSearchRecursive(unvisitedAdjacentNodeIndex, visitor);
+	DepthFirstSearchRecursive(startNodeIndex, visitor, visitMarks);
+}
 
-	level--;
+template <typename T, typename Heuristic>
+template <template <typename> class F>
+void Graph<T, Heuristic>::DepthFirstSearchRecursive(unsigned int nodeIndex, const F<T> &visitor, VisitMarks &visitMarks) const
+{
+	visitor(mNodes[nodeIndex]);
+	visitMarks.Visit(nodeIndex);
 
-	if (level == 0U)  // end of recursion - reset node flags
-		Reset();
+	for (const Adjacency &adjacency : mAdjacencyList[nodeIndex])   // each adjacency is examined once
+		if (!visitMarks.Visited(adjacency.mConnectedNodeIndex))
+			DepthFirstSearchRecursive(adjacency.mConnectedNodeIndex, visitor, visitMarks);
 }
 
-#include "../ADT/stack/stack.hpp"
-
 template <typename T, typename Heuristic>
-template <template <typename> class F>
-void Graph<T, Heuristic>::DepthFirstSearch(unsigned int startNodeIndex, const F<T> &visitor) const
+template <typename Pre, typename Post>
+bool Graph<T, Heuristic>::DepthFirstTraversal(unsigned int startNodeIndex, const Pre &preVisitor, const Post &postVisitor) const
 {
-	Stack<unsigned int> stack;
+	ScratchLease<DepthFirstScratch> scratch(mDepthFirstScratch, mDepthFirstScratchInUse);
+
+	Vector<DepthFirstFrame> &stack = scratch.Get().mStack;
+	VisitMarks &visitMarks = scratch.Get().mVisitMarks;
+
+	stack.Resize(0);   // keeps capacity
+	visitMarks.Reset(mNodes.Size());
 
-	const Node &startNode = mNodes[startNodeIndex];
-	visitor(startNode);
-	startNode.mVisited = true;
+	visitMarks.Visit(startNodeIndex);
+	if (!CallVisitor(preVisitor, startNodeIndex))
+		return false;
 
-	stack.Push(startNodeIndex);
+	stack.InsertLast(DepthFirstFrame{startNodeIndex, 0U});
 
 	while (!stack.Empty())
 	{
-		unsigned int currentNodeIndex = stack.Top();
+		DepthFirstFrame &frame = stack.Last();
+		const Vector<Adjacency> &adjacencies = mAdjacencyList[frame.mNodeIndex];
 
-		unsigned int unvisitedAdjacentNodeIndex;
-		if ((unvisitedAdjacentNodeIndex = GetUnvisitedAdjacentNodeIndex(currentNodeIndex)) != -1)
+		// resume scanning the adjacency list where this frame left off
+		while (frame.mNextAdjacency < adjacencies.Size() && visitMarks.Visited(adjacencies[frame.mNextAdjacency].mConnectedNodeIndex))
+			frame.mNextAdjacency++;
+
+		if (frame.mNextAdjacency < adjacencies.Size())
 		{
-			const Node &node = mNodes[unvisitedAdjacentNodeIndex];
-			visitor(node);
-			node.mVisited = true;
+			unsigned int adjacentNodeIndex = adjacencies[frame.mNextAdjacency++].mConnectedNodeIndex;
+
+			visitMarks.Visit(adjacentNodeIndex);
+			if (!CallVisitor(preVisitor, adjacentNodeIndex))
+				return false;
 
-			stack.Push(unvisitedAdjacentNodeIndex);
+			stack.InsertLast(DepthFirstFrame{adjacentNodeIndex, 0U});   // invalidates frame
 		}
 		else
-			stack.Pop();
-	}
-
-	// stack.Push(startNodeIndex);
-
-	// while (!stack.Empty())
-	// {
-	// 	unsigned int currentNodeIndex = stack.Top();
+		{
+			unsigned int nodeIndex = frame.mNodeIndex;
+			stack.RemoveLast();
 
-	// 	const Node &node = mNodes[currentNodeIndex];
-    //  if (!node.mVisited)
-    //  {
-	// 	  visitor(node);
-	// 	  node.mVisited = true;
-    //  }
+			if (!CallVisitor(postVisitor, nodeIndex))
+				return false;
+		}
+	}
 
-	// 	unsigned int unvisitedAdjacentNodeIndex;
-	// 	if ((unvisitedAdjacentNodeIndex = GetUnvisitedAdjacentNodeIndex(currentNodeIndex)) != -1)	
-	// 		stack.Push(unvisitedAdjacentNodeIndex);
-    //  else
-	// 	    stack.Pop();
-	// }
+	return true;
+}
 
-	Reset();
+template <typename T, typename Heuristic>
+template <template <typename> class F>
+void Graph<T, Heuristic>::DepthFirstSearch(unsigned int startNodeIndex, const F<T> &visitor) const
+{
+	DepthFirstTraversal(startNodeIndex, [this, &visitor](unsigned int nodeIndex) { visitor(mNodes[nodeIndex]); });
 }
 
 #include "../ADT/queue/queue.hpp"
@@ -231,9 +669,8 @@ void Graph<T, Heuristic>::BreadthFirstSearch(unsigned int startNodeIndex, const
 {
 	Queue<unsigned int> queue;
 
-	const Node &startNode = mNodes[startNodeIndex];
-	visitor(startNode);
-	startNode.mVisited = true;
+	visitor(mNodes[startNodeIndex]);
+	mNodeStates.SetVisited(startNodeIndex);
 
 	queue.Enqueue(startNodeIndex);
 
@@ -244,9 +681,8 @@ void Graph<T, Heuristic>::BreadthFirstSearch(unsigned int startNodeIndex, const
 		unsigned int unvisitedAdjacentNodeIndex;
 		if ((unvisitedAdjacentNodeIndex = GetUnvisitedAdjacentNodeIndex(currentNodeIndex)) != -1)
 		{
-			const Node &node = mNodes[unvisitedAdjacentNodeIndex];
-			visitor(node);
-			node.mVisited = true;
+			visitor(mNodes[unvisitedAdjacentNodeIndex]);
+			mNodeStates.SetVisited(unvisitedAdjacentNodeIndex);
 
 			queue.Enqueue(unvisitedAdjacentNodeIndex);
 		}
@@ -281,12 +717,12 @@ void Graph<T, Heuristic>::BreadthFirstSearch(unsigned int startNodeIndex, const
 #include "../ADT/priority queue/priority_queue.hpp"
 
 template <typename T, typename Heuristic>
-Vector<Vector<const typename Graph<T, Heuristic>::Node*>> Graph<T, Heuristic>::DijkstraShortestPath(unsigned int startNodeIndex) const
+ShortestPathTree Graph<T, Heuristic>::DijkstraShortestPath(unsigned int startNodeIndex) const
 {
-	auto comparator = [this](unsigned int nodeIndex1, unsigned int nodeIndex2) { return mNodes[nodeIndex1].mCost < mNodes[nodeIndex2].mCost; };
+	auto comparator = [this](unsigned int nodeIndex1, unsigned int nodeIndex2) { return mNodeStates.Cost(nodeIndex1) < mNodeStates.Cost(nodeIndex2); };
 	PriorityQueue<unsigned int, decltype(comparator)> queue(comparator);
 
-	mNodes[startNodeIndex].mCost = 0.0f;
+	mNodeStates.Cost(startNodeIndex) = 0.0f;
 
 	queue.Insert(startNodeIndex);
 
@@ -296,56 +732,180 @@ Vector<Vector<const typename Graph<T, Heuristic>::Node*>> Graph<T, Heuristic>::D
 
 		for (auto &adjacency : mAdjacencyList[currentNodeIndex])
 		{
-			if (mNodes[adjacency.mConnectedNodeIndex].mVisited)
+			if (mNodeStates.Visited(adjacency.mConnectedNodeIndex))
 				continue;
 
 			float weight = adjacency.mWeight;
-			float newCost = mNodes[currentNodeIndex].mCost + weight;
+			float newCost = mNodeStates.Cost(currentNodeIndex) + weight;
 
-			if (newCost < mNodes[adjacency.mConnectedNodeIndex].mCost)
+			if (newCost < mNodeStates.Cost(adjacency.mConnectedNodeIndex))
 			{
                 if (queue.Find(adjacency.mConnectedNodeIndex))
                     queue.Remove(adjacency.mConnectedNodeIndex);
 
-				mNodes[adjacency.mConnectedNodeIndex].mCost = newCost;
-				mNodes[adjacency.mConnectedNodeIndex].mParentNodeIndex = currentNodeIndex;
+				mNodeStates.Cost(adjacency.mConnectedNodeIndex) = newCost;
+				mNodeStates.Parent(adjacency.mConnectedNodeIndex) = currentNodeIndex;
 
 				queue.Insert(adjacency.mConnectedNodeIndex);
 			}
 		}
 
-		mNodes[currentNodeIndex].mVisited = true;  // all node's neighbours have been examined 
+		mNodeStates.SetVisited(currentNodeIndex);  // all node's neighbours have been examined 
 		queue.Remove();
 	}
 
-	Vector<Vector<const Node*>> paths;
-	paths.Resize(mNodes.Size());
+	ShortestPathTree shortestPathTree(mNodes.Size(), startNodeIndex);
 
 	for (unsigned int i = 0; i < mNodes.Size(); ++i)
 	{
-		Vector<const Node*> &path = paths[i];
+		shortestPathTree.Distances()[i] = mNodeStates.Cost(i);
+		shortestPathTree.Parents()[i] = mNodeStates.Parent(i);
+	}
+
+	Reset();
+
+	return shortestPathTree;
+}
+
+#include <algorithm>
+
+template <typename T, typename Heuristic>
+void Graph<T, Heuristic>::RepairShortestPathTree(ShortestPathTree &shortestPathTree, const EdgeWeightUpdate *updates, unsigned int numUpdates) const
+{
+	static const int AFFECTED = -2;   // parent mark of the nodes whose distance is invalidated
+
+	float *distances = shortestPathTree.Distances();
+	int *parents = shortestPathTree.Parents();
+
+	struct Entry
+	{
+		float mCost;
+		unsigned int mNodeIndex;
+
+		bool operator<(const Entry &other) const { return mCost > other.mCost; }   // min heap
+	};
+
+	Vector<Entry> heap;   // lazy: entries whose cost no longer matches the node distance are skipped
+
+	// weights are read back from the graph: a batch can hold several updates of the same edge
+	auto weight = [this](unsigned int sourceNodeIndex, unsigned int destinationNodeIndex)
+	{
+		float minWeight = ShortestPathTree::INF;
+
+		for (const Adjacency &adjacency : mAdjacencyList[sourceNodeIndex])
+			if (adjacency.mConnectedNodeIndex == destinationNodeIndex && adjacency.mWeight < minWeight)
+				minWeight = adjacency.mWeight;
+
+		return minWeight;
+	};
+
+	auto push = [&heap](float cost, unsigned int nodeIndex)
+	{
+		heap.InsertLast(Entry{cost, nodeIndex});
+		std::push_heap(heap.Begin(), heap.End());
+	};
+
+	// 1. lengthened tree edges invalidate the whole subtree below them (children of a node are the adjacent nodes whose parent it is)
+	Vector<unsigned int> affected;
+	Vector<unsigned int> stack;
+
+	for (const EdgeWeightUpdate *update = updates; update != updates + numUpdates; ++update)
+	{
+		unsigned int nodeIndex = update->mDestinationNodeIndex;
 
-		unsigned int currentNodeIndex = i;
+		if (parents[nodeIndex] != static_cast<int>(update->mSourceNodeIndex) || distances[update->mSourceNodeIndex] + weight(update->mSourceNodeIndex, nodeIndex) <= distances[nodeIndex])
+			continue;
 
-		while (currentNodeIndex != -1)
+		parents[nodeIndex] = AFFECTED;
+		stack.InsertLast(nodeIndex);
+
+		while (!stack.Empty())
 		{
-			path.InsertFirst(&mNodes[currentNodeIndex]);
-			currentNodeIndex = mNodes[currentNodeIndex].mParentNodeIndex;
+			unsigned int affectedNodeIndex = stack.Last();
+			stack.RemoveLast();
+			affected.InsertLast(affectedNodeIndex);
+
+			for (const Adjacency &adjacency : mAdjacencyList[affectedNodeIndex])
+				if (parents[adjacency.mConnectedNodeIndex] == static_cast<int>(affectedNodeIndex))
+				{
+					parents[adjacency.mConnectedNodeIndex] = AFFECTED;
+					stack.InsertLast(adjacency.mConnectedNodeIndex);
+				}
 		}
 	}
 
-	Reset();
+	// 2. affected nodes restart from their best unaffected incoming edge
+	for (unsigned int nodeIndex : affected)
+	{
+		distances[nodeIndex] = ShortestPathTree::INF;
+
+		for (unsigned int sourceNodeIndex : mReverseAdjacencyList[nodeIndex])
+		{
+			if (parents[sourceNodeIndex] <= AFFECTED || distances[sourceNodeIndex] == ShortestPathTree::INF)
+				continue;
 
-	return paths;
+			float cost = distances[sourceNodeIndex] + weight(sourceNodeIndex, nodeIndex);
+
+			if (cost < distances[nodeIndex])
+			{
+				distances[nodeIndex] = cost;
+				parents[nodeIndex] = AFFECTED - 1 - static_cast<int>(sourceNodeIndex);   // still marked affected until all candidates are known
+			}
+		}
+	}
+
+	for (unsigned int nodeIndex : affected)
+	{
+		parents[nodeIndex] = parents[nodeIndex] == AFFECTED ? -1 : AFFECTED - 1 - parents[nodeIndex];
+
+		if (distances[nodeIndex] != ShortestPathTree::INF)
+			push(distances[nodeIndex], nodeIndex);
+	}
+
+	// 3. shortened edges improve their destination directly
+	for (const EdgeWeightUpdate *update = updates; update != updates + numUpdates; ++update)
+	{
+		float cost = distances[update->mSourceNodeIndex] + weight(update->mSourceNodeIndex, update->mDestinationNodeIndex);
+
+		if (distances[update->mSourceNodeIndex] != ShortestPathTree::INF && cost < distances[update->mDestinationNodeIndex])
+		{
+			distances[update->mDestinationNodeIndex] = cost;
+			parents[update->mDestinationNodeIndex] = update->mSourceNodeIndex;
+			push(cost, update->mDestinationNodeIndex);
+		}
+	}
+
+	// 4. propagate the changes, Dijkstra restricted to the nodes whose distance changed
+	while (!heap.Empty())
+	{
+		Entry entry = heap.First();
+		std::pop_heap(heap.Begin(), heap.End());
+		heap.RemoveLast();
+
+		if (entry.mCost != distances[entry.mNodeIndex])
+			continue;
+
+		for (const Adjacency &adjacency : mAdjacencyList[entry.mNodeIndex])
+		{
+			float cost = entry.mCost + adjacency.mWeight;
+
+			if (cost < distances[adjacency.mConnectedNodeIndex])
+			{
+				distances[adjacency.mConnectedNodeIndex] = cost;
+				parents[adjacency.mConnectedNodeIndex] = entry.mNodeIndex;
+				push(cost, adjacency.mConnectedNodeIndex);
+			}
+		}
+	}
 }
 
 template <typename T, typename Heuristic>
 Vector<const typename Graph<T, Heuristic>::Node*> Graph<T, Heuristic>::DijkstraShortestPath(unsigned int startNodeIndex, unsigned int endNodeIndex) const
 {
-	auto comparator = [this](unsigned int nodeIndex1, unsigned int nodeIndex2) { return mNodes[nodeIndex1].mCost < mNodes[nodeIndex2].mCost; };
+	auto comparator = [this](unsigned int nodeIndex1, unsigned int nodeIndex2) { return mNodeStates.Cost(nodeIndex1) < mNodeStates.Cost(nodeIndex2); };
 	PriorityQueue<unsigned int, decltype(comparator)> queue(comparator);
 
-	mNodes[startNodeIndex].mCost = 0.0f;
+	mNodeStates.Cost(startNodeIndex) = 0.0f;
 
 	queue.Insert(startNodeIndex);
 
@@ -358,25 +918,25 @@ Vector<const typename Graph<T, Heuristic>::Node*> Graph<T, Heuristic>::DijkstraS
 
 		for (auto &adjacency : mAdjacencyList[currentNodeIndex])
 		{
-			if (mNodes[adjacency.mConnectedNodeIndex].mVisited)
+			if (mNodeStates.Visited(adjacency.mConnectedNodeIndex))
 				continue;
 
 			float weight = adjacency.mWeight;
-			float newCost = mNodes[currentNodeIndex].mCost + weight;
+			float newCost = mNodeStates.Cost(currentNodeIndex) + weight;
 
-			if (newCost < mNodes[adjacency.mConnectedNodeIndex].mCost)
+			if (newCost < mNodeStates.Cost(adjacency.mConnectedNodeIndex))
 			{
                 if (queue.Find(adjacency.mConnectedNodeIndex))
                     queue.Remove(adjacency.mConnectedNodeIndex);
 
-				mNodes[adjacency.mConnectedNodeIndex].mCost = newCost;
-				mNodes[adjacency.mConnectedNodeIndex].mParentNodeIndex = currentNodeIndex;
+				mNodeStates.Cost(adjacency.mConnectedNodeIndex) = newCost;
+				mNodeStates.Parent(adjacency.mConnectedNodeIndex) = currentNodeIndex;
 
 				queue.Insert(adjacency.mConnectedNodeIndex);
 			}
 		}
 
-		mNodes[currentNodeIndex].mVisited = true;  // all node's neighbours have been examined from it
+		mNodeStates.SetVisited(currentNodeIndex);  // all node's neighbours have been examined from it
 		queue.Remove();
 	}
 
@@ -387,7 +947,7 @@ Vector<const typename Graph<T, Heuristic>::Node*> Graph<T, Heuristic>::DijkstraS
 	while (currentNodeIndex != -1)
 	{
 		path.InsertFirst(&mNodes[currentNodeIndex]);
-		currentNodeIndex = mNodes[currentNodeIndex].mParentNodeIndex;
+		currentNodeIndex = mNodeStates.Parent(currentNodeIndex);
 	}
 
 	Reset();
@@ -398,21 +958,18 @@ Vector<const typename Graph<T, Heuristic>::Node*> Graph<T, Heuristic>::DijkstraS
 template <typename T, typename Heuristic>
 Vector<const typename Graph<T, Heuristic>::Node*> Graph<T, Heuristic>::AStar(unsigned int startNodeIndex, unsigned int endNodeIndex) const
 {
-	for (unsigned int i = 0U; i < mNodes.Size(); i++)
-		mNodes[i].mHeuristic = Heuristic()(this, i, endNodeIndex);
-
-	auto comparator = [this](unsigned int nodeIndex1, unsigned int nodeIndex2) { return mNodes[nodeIndex1].mCost < mNodes[nodeIndex2].mCost; };
+	// nodes are ordered by cost + heuristic, the heuristic of a node is evaluated when the node is first reached
+	auto comparator = [this](unsigned int nodeIndex1, unsigned int nodeIndex2) { return mNodeStates.Cost(nodeIndex1) + mNodeStates.Heuristic(nodeIndex1) < mNodeStates.Cost(nodeIndex2) + mNodeStates.Heuristic(nodeIndex2); };
 	PriorityQueue<unsigned int, decltype(comparator)> queue(comparator);
 
-	const Node &startNode = mNodes[startNodeIndex];
-	startNode.mCost = 0.0f;
+	mNodeStates.Cost(startNodeIndex) = 0.0f;
+	mNodeStates.Heuristic(startNodeIndex) = mHeuristic(this, startNodeIndex, endNodeIndex);
 
 	queue.Insert(startNodeIndex);
 
 	while (!queue.Empty())
 	{
 		unsigned int currentNodeIndex = queue.Peek();
-		const Node &currentNode = mNodes[currentNodeIndex];
 
 		if (currentNodeIndex == endNodeIndex)
 			break;
@@ -420,27 +977,28 @@ Vector<const typename Graph<T, Heuristic>::Node*> Graph<T, Heuristic>::AStar(uns
 		for (auto &adjacency : mAdjacencyList[currentNodeIndex])
 		{
 			unsigned int adjacentNodeIndex = adjacency.mConnectedNodeIndex;
-			const Node &adjacentNode = mNodes[adjacentNodeIndex];
 
-			// if (adjacentNode.mVisited)
+			// if (mNodeStates.Visited(adjacentNodeIndex))
 			// 	continue;
 
 			float weight = adjacency.mWeight;
-			float newCost = currentNode.mCost + weight;
+			float newCost = mNodeStates.Cost(currentNodeIndex) + weight;
 
-			if (newCost < adjacentNode.mCost)
+			if (newCost < mNodeStates.Cost(adjacentNodeIndex))
 			{
                 if (queue.Find(adjacentNodeIndex))
                     queue.Remove(adjacentNodeIndex);
+				else if (mNodeStates.Cost(adjacentNodeIndex) == NodeStates::INF)
+					mNodeStates.Heuristic(adjacentNodeIndex) = mHeuristic(this, adjacentNodeIndex, endNodeIndex);
 
-				adjacentNode.mCost = newCost;
-				adjacentNode.mParentNodeIndex = currentNodeIndex;
+				mNodeStates.Cost(adjacentNodeIndex) = newCost;
+				mNodeStates.Parent(adjacentNodeIndex) = currentNodeIndex;
 
 				queue.Insert(adjacentNodeIndex);
 			}
 		}
 
-		currentNode.mVisited = true;
+		mNodeStates.SetVisited(currentNodeIndex);
 		queue.Remove();
 	}
 
@@ -451,7 +1009,7 @@ Vector<const typename Graph<T, Heuristic>::Node*> Graph<T, Heuristic>::AStar(uns
 	while (currentNodeIndex != -1)
 	{
 		path.InsertFirst(&mNodes[currentNodeIndex]);
-		currentNodeIndex = mNodes[currentNodeIndex].mParentNodeIndex;
+		currentNodeIndex = mNodeStates.Parent(currentNodeIndex);
 	}
 
 	Reset();
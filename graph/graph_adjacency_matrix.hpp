@@ -1,4 +1,9 @@
 #include "../vector/vector.hpp"
+#include "../disjoint set/disjoint_set.hpp"
+#include "node_states.hpp"
+#include "shortest_path_tree.hpp"
+#include "all_pairs_shortest_paths.hpp"
+#include "minimum_spanning_tree.hpp"
 #include <limits>
 
 template <typename T, typename Heuristic>
@@ -22,13 +27,9 @@ class Graph
 friend Heuristic;
 
 public:
-    struct Node
+    struct Node   // payload only, traversal state lives in mNodeStates
     {
         T data;
-        mutable bool visited;
-        mutable float distance;
-        mutable int parentNodeIndex;
-        mutable float heuristic;
     };
 
 public:
@@ -39,6 +40,8 @@ public:
 
     void AddEdge(unsigned int nodeIndex1, unsigned int nodeIndex2, float weight = 1.0f, bool directed = false);
 
+    bool Reachable(unsigned int nodeIndex1, unsigned int nodeIndex2) const { return mComponents.Connected(nodeIndex1, nodeIndex2); }   // ignoring edge direction, near O(1)
+
     int GetUnvisitedAdjacentNodeIndex(unsigned int nodeIndex) const;
 
     template <typename F>
@@ -50,16 +53,22 @@ public:
     template <typename F>
     void DepthFirstSearchRecursive(unsigned int nodeIndex, const F&f);
 
-    Vector<Path> DijkstraShortestPath(unsigned int startNodeIndex) const;
+    ShortestPathTree DijkstraShortestPath(unsigned int startNodeIndex) const;
     
     Path DijkstraShortestPath(unsigned int startNodeIndex, unsigned int endNodeIndex) const; 
 
     Path AStar(unsigned int startNodeIndex, unsigned int endNodeIndex) const;
 
+    AllPairsShortestPaths FloydWarshall() const;
+
+    Vector<SpanningTreeEdge> MinimumSpanningTree() const;   // dense Prim, O(V^2), edges are treated as undirected
+
 private:
     static const float INF;
     Vector<Node> mNodes;
+    mutable NodeStates mNodeStates;
     Vector<Vector<float>> mAdjacencyMatrix;
+    DisjointSet mComponents;   // connected components, updated incrementally as edges are added
 };
 
 template <typename T, typename Heuristic>
@@ -69,11 +78,14 @@ template <typename T, typename Heuristic>
 void Graph<T, Heuristic>::AddNode(const T &data)
 {
     mNodes.InsertLast(Node{data});
+    mNodeStates.AddNode();
 
     mAdjacencyMatrix.InsertLast(Vector<float>());
     
     for (Vector<float> &vector : mAdjacencyMatrix)
         vector.Resize(mAdjacencyMatrix.Size(), INF);
+
+    mComponents.MakeSet();
 }
 
 template <typename T, typename Heuristic>
@@ -85,6 +97,8 @@ void Graph<T, Heuristic>::AddEdge(unsigned int nodeIndex1, unsigned int nodeInde
 
         if (!directed)
             mAdjacencyMatrix[nodeIndex2][nodeIndex1] = weight;
+
+        mComponents.Union(nodeIndex1, nodeIndex2);
     }
 }
 
@@ -92,12 +106,18 @@ template <typename T, typename Heuristic>
 int Graph<T, Heuristic>::GetUnvisitedAdjacentNodeIndex(unsigned int nodeIndex) const
 {
     for (unsigned int i = 0; i < mAdjacencyMatrix[nodeIndex].Size(); i++)
-        if (mAdjacencyMatrix[nodeIndex][i] != INF && !mNodes[i].visited)
+        if (mAdjacencyMatrix[nodeIndex][i] != INF && !mNodeStates.Visited(i))
             return i;
 
     return -1;
 }
 
+template <typename T, typename Heuristic>
+Vector<SpanningTreeEdge> Graph<T, Heuristic>::MinimumSpanningTree() const
+{
+    return DensePrimMinimumSpanningTree(mNodes.Size(), [this](unsigned int nodeIndex1, unsigned int nodeIndex2) { return mAdjacencyMatrix[nodeIndex1][nodeIndex2]; }, INF);
+}
+
 #include "../ADT/queue/queue.hpp"
 
 template <typename T, typename Heuristic>
@@ -107,7 +127,7 @@ void Graph<T, Heuristic>::BreadthFirstSearch(unsigned int startNodeIndex, const
     Queue<unsigned int> nodeQueue;
 
     f(mNodes[startNodeIndex]);              // visit node
-    mNodes[startNodeIndex].visited = true;  // mark as visited
+    mNodeStates.SetVisited(startNodeIndex); // mark as visited
     nodeQueue.Enqueue(startNodeIndex);      // insert node into queue
 
     while (!nodeQueue.Empty())
@@ -118,15 +138,14 @@ void Graph<T, Heuristic>::BreadthFirstSearch(unsigned int startNodeIndex, const
         while ((unvisitedAdjacentNodeIndex = GetUnvisitedAdjacentNodeIndex(currentNodeIndex)) != -1)
         {
             f(mNodes[unvisitedAdjacentNodeIndex]);                                      // visit node
-            mNodes[unvisitedAdjacentNodeIndex].visited = true;                          // mark as visited
+            mNodeStates.SetVisited(unvisitedAdjacentNodeIndex);                         // mark as visited
             nodeQueue.Enqueue(static_cast<unsigned>(unvisitedAdjacentNodeIndex));       // insert node into queue
         }
 
         nodeQueue.Dequeue();
     }
 
-    for (const Node &node : mNodes)   // reset visited flag
-        node.visited = false;
+    mNodeStates.Reset();   // reset visited flags
 }
 
 #include "../ADT/stack/stack.hpp"
@@ -138,7 +157,7 @@ void Graph<T, Heuristic>::DepthFirstSearch(unsigned int startNodeIndex, const F
     Stack<unsigned int> nodeStack;
 
     f(mNodes[startNodeIndex]);                  // visit node
-    mNodes[startNodeIndex].visited = true;      // mark node as visited
+    mNodeStates.SetVisited(startNodeIndex);     // mark node as visited
     nodeStack.Push(startNodeIndex);             // push node onto stack
 
     while (!nodeStack.Empty())
@@ -149,15 +168,14 @@ void Graph<T, Heuristic>::DepthFirstSearch(unsigned int startNodeIndex, const F
         if ((unvisitedAdjacentNodeIndex = GetUnvisitedAdjacentNodeIndex(currentNodeIndex)) != -1)
         {
             f(mNodes[unvisitedAdjacentNodeIndex]);                                    // visit node
-            mNodes[unvisitedAdjacentNodeIndex].visited = true;                        // mark node as visited
+            mNodeStates.SetVisited(unvisitedAdjacentNodeIndex);                       // mark node as visited
             nodeStack.Push(static_cast<unsigned>(unvisitedAdjacentNodeIndex));        // push node onto stack
         }
         else    
             nodeStack.Pop();
     }
 
-    for (Node const &node : mNodes)  // reset visited flag
-        node.visited = false;
+    mNodeStates.Reset();   // reset visited flags
 }
 
 template <typename T, typename Heuristic>
@@ -169,7 +187,7 @@ void Graph<T, Heuristic>::DepthFirstSearchRecursive(unsigned int nodeIndex, cons
     level++;
 
     f(mNodes[nodeIndex]);                // visit node
-    mNodes[nodeIndex].visited = true;    // mark node as visited
+    mNodeStates.SetVisited(nodeIndex);   // mark node as visited
 
     unsigned int nextNode;
     while ((nextNode = GetUnvisitedAdjacentNodeIndex(nodeIndex)) != -1)
@@ -178,24 +196,19 @@ void Graph<T, Heuristic>::DepthFirstSearchRecursive(unsigned int nodeIndex, cons
     level--;
 
     if (level == 0U)
-        for (Node const &node : mNodes)  // reset visited flag
-            node.visited = false;
+        mNodeStates.Reset();   // reset visited flags
 }
 
 #define TYPE_PARAM_HEAP_QUEUE
 #include "../ADT/priority queue/priority_queue.hpp"
 
 template <typename T, typename Heuristic>
-Vector<typename Graph<T, Heuristic>::Path> Graph<T, Heuristic>::DijkstraShortestPath(unsigned int startNodeIndex) const
+ShortestPathTree Graph<T, Heuristic>::DijkstraShortestPath(unsigned int startNodeIndex) const
 {
-    for (unsigned int i = 0; i < mNodes.Size(); i++)
-    {
-        mNodes[i].distance = i == startNodeIndex ? 0.0f : INF;  // all nodes but starting node start with INF as distance
-        mNodes[i].visited = false;
-        mNodes[i].parentNodeIndex = -1;
-    }
+    mNodeStates.Reset();
+    mNodeStates.Cost(startNodeIndex) = 0.0f;   // all nodes but starting node start with INF as distance
 
-    auto comparator = [this](unsigned int v1, unsigned int v2) -> bool { return this->mNodes[v1].distance < this->mNodes[v2].distance; };
+    auto comparator = [this](unsigned int v1, unsigned int v2) -> bool { return mNodeStates.Cost(v1) < mNodeStates.Cost(v2); };
     PriorityQueue<unsigned int, decltype(comparator)> nodePriorityQueue(comparator);
 
     nodePriorityQueue.Insert(startNodeIndex);                                // insert start node index into priority queue
@@ -205,63 +218,45 @@ Vector<typename Graph<T, Heuristic>::Path> Graph<T, Heuristic>::DijkstraShortest
         unsigned int currentNodeIndex = nodePriorityQueue.Peek();            // get first node in priority queue
 
         nodePriorityQueue.Remove();                                          // remove node from priority queue
-        mNodes[currentNodeIndex].visited = true;                             // mark node as visited
+        mNodeStates.SetVisited(currentNodeIndex);                            // mark node as visited
 
         for (unsigned int i = 0; i < mNodes.Size(); i++)                     // find all unvisited adjacent nodes
-            if (i != currentNodeIndex && mAdjacencyMatrix[currentNodeIndex][i] != INF && !mNodes[i].visited)
+            if (i != currentNodeIndex && mAdjacencyMatrix[currentNodeIndex][i] != INF && !mNodeStates.Visited(i))
             {
-                float currentDistance = mNodes[i].distance;
-                float newDistance = mNodes[currentNodeIndex].distance + mAdjacencyMatrix[currentNodeIndex][i];
+                float currentDistance = mNodeStates.Cost(i);
+                float newDistance = mNodeStates.Cost(currentNodeIndex) + mAdjacencyMatrix[currentNodeIndex][i];
 
                 if (newDistance < currentDistance)                           // if distance is shorter relax edge 
                 {
                     if (nodePriorityQueue.Find(i))
                         nodePriorityQueue.Remove(i);
 
-                    mNodes[i].distance = newDistance;
-                    mNodes[i].parentNodeIndex = currentNodeIndex;
+                    mNodeStates.Cost(i) = newDistance;
+                    mNodeStates.Parent(i) = currentNodeIndex;
                 
                     nodePriorityQueue.Insert(i);                             // insert node into queue
                 }
             }
     }
 
-    Vector<Path> paths;
-    paths.Resize(mNodes.Size());
+    ShortestPathTree shortestPathTree(mNodes.Size(), startNodeIndex);
 
     for (unsigned int i = 0; i < mNodes.Size(); i++)
     {
-        if (i == startNodeIndex)
-        {
-            paths[i].InsertFirst(&mNodes[i]);
-            continue;
-        }
-
-        unsigned int currentNodeIndex = i;
-        do 
-        {
-            paths[i].InsertFirst(&mNodes[currentNodeIndex]);
-            currentNodeIndex = mNodes[currentNodeIndex].parentNodeIndex;
-        } while (currentNodeIndex != startNodeIndex);
-
-        paths[i].InsertFirst(&mNodes[startNodeIndex]);
+        shortestPathTree.Distances()[i] = mNodeStates.Cost(i);
+        shortestPathTree.Parents()[i] = mNodeStates.Parent(i);
     }
     
-    return paths;
+    return shortestPathTree;
 }
 
 template <typename T, typename Heuristic>
 typename Graph<T, Heuristic>::Path Graph<T, Heuristic>::DijkstraShortestPath(unsigned int startNodeIndex, unsigned int endNodeIndex) const
 {
-    for (const Node &node : mNodes)
-    {
-        node.visited = false;
-        node.distance = INF;
-        node.parentNodeIndex = -1;
-    }
-    mNodes[startNodeIndex].distance = 0.0f;
+    mNodeStates.Reset();
+    mNodeStates.Cost(startNodeIndex) = 0.0f;
 
-    auto const &comparator = [this] (unsigned int nodeIndex1, unsigned int nodeIndex2) { return mNodes[nodeIndex1].distance < mNodes[nodeIndex2].distance;};
+    auto const &comparator = [this] (unsigned int nodeIndex1, unsigned int nodeIndex2) { return mNodeStates.Cost(nodeIndex1) < mNodeStates.Cost(nodeIndex2);};
     PriorityQueue<unsigned int, decltype(comparator)> nodePriorityQueue(comparator);
 
     nodePriorityQueue.Insert(startNodeIndex);
@@ -274,25 +269,25 @@ typename Graph<T, Heuristic>::Path Graph<T, Heuristic>::DijkstraShortestPath(uns
             break;
 
         nodePriorityQueue.Remove();
-        mNodes[currentNodeIndex].visited = true;
+        mNodeStates.SetVisited(currentNodeIndex);
 
         for (unsigned int i = 0; i < mNodes.Size(); i++) 
         {
-            if (i == currentNodeIndex || mAdjacencyMatrix[currentNodeIndex][i] == INF || mNodes[i].visited)
+            if (i == currentNodeIndex || mAdjacencyMatrix[currentNodeIndex][i] == INF || mNodeStates.Visited(i))
                 continue;
             
             unsigned int unvisitedAdjacentNodeIndex = i;
             
-            float currentDistance = mNodes[unvisitedAdjacentNodeIndex].distance;
-            float newDistance = mNodes[currentNodeIndex].distance + mAdjacencyMatrix[currentNodeIndex][unvisitedAdjacentNodeIndex];
+            float currentDistance = mNodeStates.Cost(unvisitedAdjacentNodeIndex);
+            float newDistance = mNodeStates.Cost(currentNodeIndex) + mAdjacencyMatrix[currentNodeIndex][unvisitedAdjacentNodeIndex];
             
             if (newDistance < currentDistance)
             {
                 if (nodePriorityQueue.Find(unvisitedAdjacentNodeIndex))
                     nodePriorityQueue.Remove(unvisitedAdjacentNodeIndex);
                     
-                mNodes[unvisitedAdjacentNodeIndex].distance = newDistance;
-                mNodes[unvisitedAdjacentNodeIndex].parentNodeIndex = currentNodeIndex;
+                mNodeStates.Cost(unvisitedAdjacentNodeIndex) = newDistance;
+                mNodeStates.Parent(unvisitedAdjacentNodeIndex) = currentNodeIndex;
 
                 nodePriorityQueue.Insert(unvisitedAdjacentNodeIndex);
             }
@@ -306,7 +301,7 @@ typename Graph<T, Heuristic>::Path Graph<T, Heuristic>::DijkstraShortestPath(uns
     while (nodeIndex != startNodeIndex)
     {
         path.InsertFirst(&mNodes[nodeIndex]);
-        nodeIndex = mNodes[nodeIndex].parentNodeIndex;
+        nodeIndex = mNodeStates.Parent(nodeIndex);
     }
 
     path.InsertFirst(&mNodes[startNodeIndex]);
@@ -317,16 +312,11 @@ typename Graph<T, Heuristic>::Path Graph<T, Heuristic>::DijkstraShortestPath(uns
 template <typename T, typename Heuristic>
 typename Graph<T, Heuristic>::Path Graph<T, Heuristic>::AStar(unsigned int startNodeIndex, unsigned int endNodeIndex) const
 {
-    for (Node const &node : mNodes)
-    {
-        node.visited = false;
-        node.distance = INF;
-        node.parentNodeIndex = -1;
-        node.heuristic = 0.0f;
-    }
-    mNodes[startNodeIndex].distance = 0.0f;
+    mNodeStates.Reset();
+    mNodeStates.Cost(startNodeIndex) = 0.0f;
+    mNodeStates.Heuristic(startNodeIndex) = 0.0f;
 
-    auto comparator = [this](unsigned int nodeIndex1, unsigned int nodeIndex2) -> bool { return mNodes[nodeIndex1].distance + mNodes[nodeIndex1].heuristic < mNodes[nodeIndex2].distance + mNodes[nodeIndex2].heuristic; };
+    auto comparator = [this](unsigned int nodeIndex1, unsigned int nodeIndex2) -> bool { return mNodeStates.Cost(nodeIndex1) + mNodeStates.Heuristic(nodeIndex1) < mNodeStates.Cost(nodeIndex2) + mNodeStates.Heuristic(nodeIndex2); };
     PriorityQueue<unsigned int, decltype(comparator)> nodePriorityQueue(comparator);
 
     nodePriorityQueue.Insert(startNodeIndex);
@@ -339,7 +329,7 @@ typename Graph<T, Heuristic>::Path Graph<T, Heuristic>::AStar(unsigned int start
             break;
 
         nodePriorityQueue.Remove();
-        mNodes[currentNodeIndex].visited = true;
+        mNodeStates.SetVisited(currentNodeIndex);
 
         for (unsigned int i = 0; i < mNodes.Size(); i++) 
         {
@@ -348,18 +338,18 @@ typename Graph<T, Heuristic>::Path Graph<T, Heuristic>::AStar(unsigned int start
             
             unsigned int adjacentNodeIndex = i;
 
-            float currentDistance = mNodes[adjacentNodeIndex].distance;
-            float newDistance = mNodes[currentNodeIndex].distance + mAdjacencyMatrix[currentNodeIndex][adjacentNodeIndex];
+            float currentDistance = mNodeStates.Cost(adjacentNodeIndex);
+            float newDistance = mNodeStates.Cost(currentNodeIndex) + mAdjacencyMatrix[currentNodeIndex][adjacentNodeIndex];
 
             if (newDistance < currentDistance)
             {
                 if (nodePriorityQueue.Find(adjacentNodeIndex))
                     nodePriorityQueue.Remove(adjacentNodeIndex);
 
-                mNodes[adjacentNodeIndex].distance = newDistance;
-                mNodes[adjacentNodeIndex].parentNodeIndex = currentNodeIndex;
+                mNodeStates.Cost(adjacentNodeIndex) = newDistance;
+                mNodeStates.Parent(adjacentNodeIndex) = currentNodeIndex;
 
-                mNodes[adjacentNodeIndex].heuristic = Heuristic()(this, adjacentNodeIndex, endNodeIndex);  // calculate node's heuristic 
+                mNodeStates.Heuristic(adjacentNodeIndex) = Heuristic()(this, adjacentNodeIndex, endNodeIndex);  // calculate node's heuristic 
 
                 nodePriorityQueue.Insert(adjacentNodeIndex);                                   // insert into priority queue
             }
@@ -372,7 +362,7 @@ typename Graph<T, Heuristic>::Path Graph<T, Heuristic>::AStar(unsigned int start
     while (nodeIndex != startNodeIndex)
     {
         path.InsertFirst(&mNodes[nodeIndex]);
-        nodeIndex = mNodes[nodeIndex].parentNodeIndex;
+        nodeIndex = mNodeStates.Parent(nodeIndex);
     }
 
     path.InsertFirst(&mNodes[startNodeIndex]);
@@ -380,3 +370,16 @@ typename Graph<T, Heuristic>::Path Graph<T, Heuristic>::AStar(unsigned int start
     return path;
 }
 
+template <typename T, typename Heuristic>
+AllPairsShortestPaths Graph<T, Heuristic>::FloydWarshall() const
+{
+    AllPairsShortestPaths allPairsShortestPaths;
+
+    allPairsShortestPaths.Compute(mNodes.Size(), [this](unsigned int nodeIndex1, unsigned int nodeIndex2)
+    {
+        float weight = mAdjacencyMatrix[nodeIndex1][nodeIndex2];
+        return weight == INF ? AllPairsShortestPaths::INF : weight;
+    });
+
+    return allPairsShortestPaths;
+}
@@ -0,0 +1,373 @@
+#ifndef GRAPH_ANALYTICS_H
+#define GRAPH_ANALYTICS_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "../vector/vector.hpp"
+#include "../parallel/parallel_for.hpp"
+#include "csr_graph.hpp"
+
+/**** pull based sparse matrix-vector product: every row gathers the values of its columns, rows are written by a single
+      thread (no atomics, results do not depend on the number of threads) ****/
+// the pulled matrix is a CSR graph whose row i lists the sources of the edges entering node i (the transpose of the
+// graph), so Multiply computes y = A^T x of the adjacency matrix A. rows are split in ranges of similar work (1 + degree)
+// once, then every product runs the ranges in parallel
+class SpMVKernel
+{
+public:
+    explicit SpMVKernel(const CsrView &pull, unsigned int rangesPerThread = 4);
+
+    unsigned int Size() const { return mPull.Size(); }
+    unsigned int NumRanges() const { return mRangeBounds.Size() - 1; }
+
+    // y[i] = sum of weight(j -> i) * x[j] over the in-edges of i (weight 1 when weighted is false)
+    void Multiply(const float *x, float *y, bool weighted = true) const;
+
+    // f(range, rowBegin, rowEnd) for every row range, ranges run in parallel (per range partial results indexed by range
+    // and combined in range order make reductions deterministic)
+    template <typename F>
+    void ForEachRange(const F &f) const;
+
+    static float RowSum(const unsigned int *columns, unsigned int numColumns, const float *x);
+    static float RowDot(const unsigned int *columns, const float *weights, unsigned int numColumns, const float *x);
+
+private:
+    CsrView mPull;
+    Vector<unsigned int> mRangeBounds;   // NumRanges() + 1 row indices
+};
+
+inline SpMVKernel::SpMVKernel(const CsrView &pull, unsigned int rangesPerThread) : mPull(pull)
+{
+    unsigned int numRows = pull.Size();
+    unsigned int numRanges = std::max(1U, std::min(HardwareConcurrency() * std::max(rangesPerThread, 1U), numRows));
+
+    // the work before row i is offsets[i] + i (monotonic), each bound is found by binary search
+    const std::uint64_t *offsets = pull.Offsets();
+    std::uint64_t totalWork = pull.NumEdges() + numRows;
+
+    mRangeBounds.Reserve(numRanges + 1);
+    mRangeBounds.InsertLast(0U);
+
+    for (unsigned int i = 1; i < numRanges; i++)
+    {
+        std::uint64_t work = totalWork * i / numRanges;
+        unsigned int low = mRangeBounds.Last(), high = numRows;
+
+        while (low < high)
+        {
+            unsigned int middle = low + (high - low) / 2;
+
+            if (offsets[middle] + middle < work)
+                low = middle + 1;
+            else
+                high = middle;
+        }
+
+        mRangeBounds.InsertLast(low);
+    }
+
+    mRangeBounds.InsertLast(numRows);
+}
+
+template <typename F>
+void SpMVKernel::ForEachRange(const F &f) const
+{
+    ParallelFor(0, NumRanges(), [this, &f](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; i++)
+            f(static_cast<unsigned int>(i), mRangeBounds[i], mRangeBounds[i + 1]);
+    });
+}
+
+// gathers with several independent accumulators (8 lanes with AVX2, 4 scalar chains otherwise) so that the additions
+// do not wait on each other, the lanes are summed in a fixed order
+inline float SpMVKernel::RowSum(const unsigned int *columns, unsigned int numColumns, const float *x)
+{
+    unsigned int k = 0;
+
+#if defined(__AVX2__)   // node indices below 2^31
+    __m256 sum8 = _mm256_setzero_ps();
+
+    for (; k + 8 <= numColumns; k += 8)
+    {
+        __m256i indices = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(columns + k));
+        sum8 = _mm256_add_ps(sum8, _mm256_i32gather_ps(x, indices, 4));
+    }
+
+    alignas(32) float lanes[8];
+    _mm256_store_ps(lanes, sum8);
+
+    float sum0 = (lanes[0] + lanes[4]) + (lanes[1] + lanes[5]);
+    float sum1 = (lanes[2] + lanes[6]) + (lanes[3] + lanes[7]);
+    float sum2 = 0.0f, sum3 = 0.0f;
+#else
+    float sum0 = 0.0f, sum1 = 0.0f, sum2 = 0.0f, sum3 = 0.0f;
+
+    for (; k + 4 <= numColumns; k += 4)
+    {
+        sum0 += x[columns[k]];
+        sum1 += x[columns[k + 1]];
+        sum2 += x[columns[k + 2]];
+        sum3 += x[columns[k + 3]];
+    }
+#endif
+
+    for (; k < numColumns; k++)
+        sum0 += x[columns[k]];
+
+    return (sum0 + sum1) + (sum2 + sum3);
+}
+
+inline float SpMVKernel::RowDot(const unsigned int *columns, const float *weights, unsigned int numColumns, const float *x)
+{
+    unsigned int k = 0;
+
+#if defined(__AVX2__)
+    __m256 sum8 = _mm256_setzero_ps();
+
+    for (; k + 8 <= numColumns; k += 8)
+    {
+        __m256i indices = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(columns + k));
+        sum8 = _mm256_add_ps(sum8, _mm256_mul_ps(_mm256_loadu_ps(weights + k), _mm256_i32gather_ps(x, indices, 4)));
+    }
+
+    alignas(32) float lanes[8];
+    _mm256_store_ps(lanes, sum8);
+
+    float sum0 = (lanes[0] + lanes[4]) + (lanes[1] + lanes[5]);
+    float sum1 = (lanes[2] + lanes[6]) + (lanes[3] + lanes[7]);
+    float sum2 = 0.0f, sum3 = 0.0f;
+#else
+    float sum0 = 0.0f, sum1 = 0.0f, sum2 = 0.0f, sum3 = 0.0f;
+
+    for (; k + 4 <= numColumns; k += 4)
+    {
+        sum0 += weights[k] * x[columns[k]];
+        sum1 += weights[k + 1] * x[columns[k + 1]];
+        sum2 += weights[k + 2] * x[columns[k + 2]];
+        sum3 += weights[k + 3] * x[columns[k + 3]];
+    }
+#endif
+
+    for (; k < numColumns; k++)
+        sum0 += weights[k] * x[columns[k]];
+
+    return (sum0 + sum1) + (sum2 + sum3);
+}
+
+inline void SpMVKernel::Multiply(const float *x, float *y, bool weighted) const
+{
+    ForEachRange([this, x, y, weighted](unsigned int range, unsigned int rowBegin, unsigned int rowEnd)
+    {
+        (void)range;
+
+        for (unsigned int i = rowBegin; i < rowEnd; i++)
+            y[i] = weighted ? RowDot(mPull.TargetsBegin(i), mPull.Weights(i), mPull.Degree(i), x) : RowSum(mPull.TargetsBegin(i), mPull.Degree(i), x);
+    });
+}
+
+/**** iterative analytics on top of the kernel ****/
+
+struct IterationResult
+{
+    unsigned int mNumIterations;
+    double mResidual;   // L1 change of the ranks for PageRank, number of changed labels for label propagation
+    bool mConverged;
+};
+
+// PageRank of every node (ranks sum to 1, edge weights are ignored), iterates until the L1 change of the ranks is below
+// tolerance or maxIterations is reached. personalization (numNodes entries summing to 1) receives the teleport and the
+// mass of the dangling nodes (no out-edge), nullptr for the uniform distribution. ranks is used as the starting point if
+// it already holds numNodes values
+inline IterationResult PageRank(const CsrView &csr, const CsrView &transpose, Vector<float> &ranks, float damping = 0.85f,
+                                double tolerance = 1e-6, unsigned int maxIterations = 100, const float *personalization = nullptr)
+{
+    unsigned int numNodes = csr.Size();
+    IterationResult result{0U, 0.0, numNodes == 0};
+
+    if (numNodes == 0)
+    {
+        ranks.Clear();
+        return result;
+    }
+
+    float uniform = 1.0f / numNodes;
+
+    if (ranks.Size() != numNodes)
+    {
+        ranks.Clear();
+        ranks.Resize(numNodes);
+
+        for (unsigned int i = 0; i < numNodes; i++)
+            ranks[i] = personalization ? personalization[i] : uniform;
+    }
+
+    SpMVKernel kernel(transpose);
+
+    Vector<float> contributions;   // rank / out degree
+    contributions.Resize(numNodes);
+    Vector<float> newRanks;
+    newRanks.Resize(numNodes);
+    Vector<double> partials;       // per range sums, combined in range order
+    partials.Resize(kernel.NumRanges());
+
+    while (result.mNumIterations < maxIterations)
+    {
+        kernel.ForEachRange([&](unsigned int range, unsigned int rowBegin, unsigned int rowEnd)
+        {
+            double dangling = 0.0;
+
+            for (unsigned int i = rowBegin; i < rowEnd; i++)
+            {
+                unsigned int degree = csr.Degree(i);
+
+                contributions[i] = degree ? ranks[i] / degree : 0.0f;
+
+                if (!degree)
+                    dangling += ranks[i];
+            }
+
+            partials[range] = dangling;
+        });
+
+        double dangling = 0.0;
+        for (double partial : partials)
+            dangling += partial;
+
+        float teleport = static_cast<float>(1.0 - damping + damping * dangling);   // mass spread over the personalization
+
+        kernel.ForEachRange([&](unsigned int range, unsigned int rowBegin, unsigned int rowEnd)
+        {
+            double residual = 0.0;
+
+            for (unsigned int i = rowBegin; i < rowEnd; i++)
+            {
+                float rank = damping * SpMVKernel::RowSum(transpose.TargetsBegin(i), transpose.Degree(i), contributions.Data())
+                             + teleport * (personalization ? personalization[i] : uniform);
+
+                residual += std::fabs(rank - ranks[i]);
+                newRanks[i] = rank;
+            }
+
+            partials[range] = residual;
+        });
+
+        ranks.Swap(newRanks);
+        result.mNumIterations++;
+
+        result.mResidual = 0.0;
+        for (double partial : partials)
+            result.mResidual += partial;
+
+        if (result.mResidual < tolerance)
+        {
+            result.mConverged = true;
+            break;
+        }
+    }
+
+    return result;
+}
+
+// weakly connected components by label propagation: every node takes the minimum label of itself, its in and out
+// neighbours and its label's label (pointer jumping shortens the chains), labels end as the minimum node index of each
+// component. labels are double buffered so that an iteration only reads the previous one
+inline IterationResult LabelPropagationComponents(const CsrView &csr, const CsrView &transpose, Vector<unsigned int> &labels, unsigned int maxIterations = 1000)
+{
+    unsigned int numNodes = csr.Size();
+    IterationResult result{0U, 0.0, false};
+
+    labels.Clear();
+    labels.Resize(numNodes);
+
+    for (unsigned int i = 0; i < numNodes; i++)
+        labels[i] = i;
+
+    if (numNodes == 0)
+    {
+        result.mConverged = true;
+        return result;
+    }
+
+    SpMVKernel kernel(transpose);
+
+    Vector<unsigned int> newLabels;
+    newLabels.Resize(numNodes);
+    Vector<unsigned int> changed;   // per range counts
+    changed.Resize(kernel.NumRanges());
+
+    auto minLabel = [](const unsigned int *begin, const unsigned int *end, const unsigned int *labels, unsigned int label)
+    {
+        for (const unsigned int *neighbour = begin; neighbour != end; ++neighbour)
+            label = std::min(label, labels[*neighbour]);
+
+        return label;
+    };
+
+    while (result.mNumIterations < maxIterations)
+    {
+        kernel.ForEachRange([&](unsigned int range, unsigned int rowBegin, unsigned int rowEnd)
+        {
+            unsigned int numChanged = 0;
+
+            for (unsigned int i = rowBegin; i < rowEnd; i++)
+            {
+                unsigned int label = labels[labels[i]];
+
+                label = minLabel(transpose.TargetsBegin(i), transpose.TargetsEnd(i), labels.Data(), label);
+                label = minLabel(csr.TargetsBegin(i), csr.TargetsEnd(i), labels.Data(), label);
+
+                numChanged += label != labels[i];
+                newLabels[i] = label;
+            }
+
+            changed[range] = numChanged;
+        });
+
+        labels.Swap(newLabels);
+        result.mNumIterations++;
+
+        result.mResidual = 0.0;
+        for (unsigned int numChanged : changed)
+            result.mResidual += numChanged;
+
+        if (result.mResidual == 0.0)
+        {
+            result.mConverged = true;
+            break;
+        }
+    }
+
+    return result;
+}
+
+/**** convenience overloads for any graph exposing Size() and GetAdjacencies(nodeIndex) (CSR copies are built once) ****/
+
+template <typename G>
+IterationResult PageRank(const G &graph, Vector<float> &ranks, float damping = 0.85f, double tolerance = 1e-6,
+                         unsigned int maxIterations = 100, const float *personalization = nullptr)
+{
+    CsrGraph csr;
+    csr.Build(graph);
+    CsrGraph transpose = csr.Transpose();
+
+    return PageRank(csr.View(), transpose.View(), ranks, damping, tolerance, maxIterations, personalization);
+}
+
+template <typename G>
+IterationResult LabelPropagationComponents(const G &graph, Vector<unsigned int> &labels, unsigned int maxIterations = 1000)
+{
+    CsrGraph csr;
+    csr.Build(graph);
+    CsrGraph transpose = csr.Transpose();
+
+    return LabelPropagationComponents(csr.View(), transpose.View(), labels, maxIterations);
+}
+
+#endif  // GRAPH_ANALYTICS_H
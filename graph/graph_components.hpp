@@ -0,0 +1,466 @@
+#ifndef GRAPH_COMPONENTS_H
+#define GRAPH_COMPONENTS_H
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <mutex>
+
+#include "../vector/vector.hpp"
+#include "../parallel/parallel_for.hpp"
+#include "csr_graph.hpp"
+#include "graph_traversal.hpp"
+
+/**** strongly connected components, topological order and condensation of directed graphs (CSR input, all iterative) ****/
+
+static const unsigned int NO_COMPONENT = std::numeric_limits<unsigned int>::max();
+
+// iterative Tarjan over the nodes accepted by inSubset(nodeIndex), started from every node in [rootsBegin, rootsEnd)
+// (visit arrays must hold NO_COMPONENT for the subset nodes), a new component id is taken from newComponent() when a
+// component is complete: components are completed in reverse topological order (sinks first)
+template <typename Subset, typename NewComponent>
+void TarjanVisit(const CsrView &csr, const unsigned int *rootsBegin, const unsigned int *rootsEnd, const Subset &inSubset,
+                 const NewComponent &newComponent, unsigned int *components, unsigned int *indices, unsigned int *lowLinks)
+{
+    Vector<DepthFirstFrame> frames;
+    Vector<unsigned int> stack;   // nodes visited but not yet assigned to a component (visited && no component <=> on stack)
+    unsigned int nextIndex = 0;
+
+    auto discover = [&](unsigned int nodeIndex)
+    {
+        indices[nodeIndex] = lowLinks[nodeIndex] = nextIndex++;
+        stack.InsertLast(nodeIndex);
+        frames.InsertLast(DepthFirstFrame{nodeIndex, 0U});
+    };
+
+    for (const unsigned int *root = rootsBegin; root != rootsEnd; ++root)
+    {
+        if (indices[*root] != NO_COMPONENT)
+            continue;
+
+        discover(*root);
+
+        while (!frames.Empty())
+        {
+            DepthFirstFrame &frame = frames.Last();
+            unsigned int nodeIndex = frame.mNodeIndex;
+
+            if (frame.mNextAdjacency < csr.Degree(nodeIndex))
+            {
+                unsigned int adjacentNodeIndex = csr.TargetsBegin(nodeIndex)[frame.mNextAdjacency++];
+
+                if (!inSubset(adjacentNodeIndex))
+                    continue;
+
+                if (indices[adjacentNodeIndex] == NO_COMPONENT)
+                    discover(adjacentNodeIndex);   // invalidates frame
+                else if (components[adjacentNodeIndex] == NO_COMPONENT)   // on stack: back or cross edge inside the current component
+                    lowLinks[nodeIndex] = std::min(lowLinks[nodeIndex], indices[adjacentNodeIndex]);
+
+                continue;
+            }
+
+            frames.RemoveLast();
+
+            if (lowLinks[nodeIndex] == indices[nodeIndex])   // root of a component: everything above it on the stack
+            {
+                unsigned int component = newComponent();
+                unsigned int member;
+
+                do
+                {
+                    member = stack.Last();
+                    stack.RemoveLast();
+                    components[member] = component;
+                } while (member != nodeIndex);
+            }
+
+            if (!frames.Empty())
+            {
+                unsigned int parentNodeIndex = frames.Last().mNodeIndex;
+                lowLinks[parentNodeIndex] = std::min(lowLinks[parentNodeIndex], lowLinks[nodeIndex]);
+            }
+        }
+    }
+}
+
+// component of every node accepted by inSubset(nodeIndex) (NO_COMPONENT for the others), ids in reverse topological order
+// of the condensation (an edge between two components goes from the higher id to the lower one), returns the number of components
+template <typename Subset>
+unsigned int TarjanStronglyConnectedComponents(const CsrView &csr, Vector<unsigned int> &components, const Subset &inSubset)
+{
+    unsigned int numNodes = csr.Size();
+
+    components.Clear();
+    components.Resize(numNodes, NO_COMPONENT);
+
+    Vector<unsigned int> indices, lowLinks, roots;
+    indices.Resize(numNodes, NO_COMPONENT);
+    lowLinks.Resize(numNodes);
+    roots.Reserve(numNodes);
+
+    for (unsigned int i = 0; i < numNodes; i++)
+        if (inSubset(i))
+            roots.InsertLast(i);
+
+    unsigned int numComponents = 0;
+
+    TarjanVisit(csr, roots.Begin(), roots.End(), inSubset, [&numComponents]() { return numComponents++; },
+                components.Data(), indices.Data(), lowLinks.Data());
+
+    return numComponents;
+}
+
+inline unsigned int TarjanStronglyConnectedComponents(const CsrView &csr, Vector<unsigned int> &components)
+{
+    return TarjanStronglyConnectedComponents(csr, components, [](unsigned int) { return true; });
+}
+
+// component of every node, ids in topological order of the condensation (an edge between two components goes from the
+// lower id to the higher one), transpose is the graph with every edge reversed, returns the number of components
+inline unsigned int KosarajuStronglyConnectedComponents(const CsrView &csr, const CsrView &transpose, Vector<unsigned int> &components)
+{
+    unsigned int numNodes = csr.Size();
+
+    // 1. depth first finish order on the graph
+    Vector<unsigned int> finishOrder;
+    finishOrder.Reserve(numNodes);
+
+    Vector<DepthFirstFrame> frames;
+    VisitMarks visitMarks;
+    visitMarks.Reset(numNodes);
+
+    for (unsigned int root = 0; root < numNodes; root++)
+    {
+        if (visitMarks.Visited(root))
+            continue;
+
+        visitMarks.Visit(root);
+        frames.InsertLast(DepthFirstFrame{root, 0U});
+
+        while (!frames.Empty())
+        {
+            DepthFirstFrame &frame = frames.Last();
+
+            if (frame.mNextAdjacency < csr.Degree(frame.mNodeIndex))
+            {
+                unsigned int adjacentNodeIndex = csr.TargetsBegin(frame.mNodeIndex)[frame.mNextAdjacency++];
+
+                if (!visitMarks.Visited(adjacentNodeIndex))
+                {
+                    visitMarks.Visit(adjacentNodeIndex);
+                    frames.InsertLast(DepthFirstFrame{adjacentNodeIndex, 0U});   // invalidates frame
+                }
+            }
+            else
+            {
+                finishOrder.InsertLast(frame.mNodeIndex);
+                frames.RemoveLast();
+            }
+        }
+    }
+
+    // 2. reverse finish order on the transpose: each search collects exactly one component
+    components.Clear();
+    components.Resize(numNodes, NO_COMPONENT);
+
+    Vector<unsigned int> stack;
+    unsigned int numComponents = 0;
+
+    for (unsigned int i = numNodes; i-- > 0;)
+    {
+        unsigned int root = finishOrder[i];
+
+        if (components[root] != NO_COMPONENT)
+            continue;
+
+        components[root] = numComponents;
+        stack.InsertLast(root);
+
+        while (!stack.Empty())
+        {
+            unsigned int nodeIndex = stack.Last();
+            stack.RemoveLast();
+
+            for (const unsigned int *source = transpose.TargetsBegin(nodeIndex); source != transpose.TargetsEnd(nodeIndex); ++source)
+                if (components[*source] == NO_COMPONENT)
+                {
+                    components[*source] = numComponents;
+                    stack.InsertLast(*source);
+                }
+        }
+
+        numComponents++;
+    }
+
+    return numComponents;
+}
+
+// Kahn: the nodes accepted by inSubset(nodeIndex) in an order where every edge goes forward (edges must stay inside the
+// subset), returns false (partial order) if the graph has a cycle
+template <typename Subset>
+bool TopologicalSort(const CsrView &csr, Vector<unsigned int> &order, const Subset &inSubset)
+{
+    unsigned int numNodes = csr.Size();
+    unsigned int numSubsetNodes = 0;
+
+    Vector<unsigned int> inDegrees;
+    inDegrees.Resize(numNodes, 0U);
+
+    for (std::uint64_t i = 0; i < csr.NumEdges(); i++)
+        inDegrees[csr.Targets()[i]]++;
+
+    order.Clear();
+    order.Reserve(numNodes);   // doubles as the queue of nodes without remaining incoming edges
+
+    for (unsigned int i = 0; i < numNodes; i++)
+    {
+        if (!inSubset(i))
+            continue;
+
+        numSubsetNodes++;
+
+        if (inDegrees[i] == 0)
+            order.InsertLast(i);
+    }
+
+    for (unsigned int front = 0; front < order.Size(); front++)
+    {
+        unsigned int nodeIndex = order[front];
+
+        for (const unsigned int *target = csr.TargetsBegin(nodeIndex); target != csr.TargetsEnd(nodeIndex); ++target)
+            if (--inDegrees[*target] == 0)
+                order.InsertLast(*target);
+    }
+
+    return order.Size() == numSubsetNodes;
+}
+
+inline bool TopologicalSort(const CsrView &csr, Vector<unsigned int> &order)
+{
+    return TopologicalSort(csr, order, [](unsigned int) { return true; });
+}
+
+// directed acyclic graph of the components: one edge per connected pair of components (lightest weight kept)
+inline CsrGraph CondensationGraph(const CsrView &csr, const Vector<unsigned int> &components, unsigned int numComponents)
+{
+    Vector<CsrGraph::Edge> edges;
+
+    for (unsigned int i = 0; i < csr.Size(); i++)
+    {
+        const float *weights = csr.Weights(i);
+
+        for (const unsigned int *target = csr.TargetsBegin(i); target != csr.TargetsEnd(i); ++target, ++weights)
+            if (components[i] != components[*target])
+                edges.InsertLast(CsrGraph::Edge{components[i], components[*target], *weights});
+    }
+
+    std::sort(edges.Begin(), edges.End(), [](const CsrGraph::Edge &edge1, const CsrGraph::Edge &edge2)
+    {
+        if (edge1.sourceNodeIndex != edge2.sourceNodeIndex)
+            return edge1.sourceNodeIndex < edge2.sourceNodeIndex;
+        if (edge1.destinationNodeIndex != edge2.destinationNodeIndex)
+            return edge1.destinationNodeIndex < edge2.destinationNodeIndex;
+
+        return edge1.weight < edge2.weight;
+    });
+
+    // first of each run of parallel edges is the lightest
+    unsigned int numEdges = 0;
+
+    for (unsigned int i = 0; i < edges.Size(); i++)
+        if (numEdges == 0 || edges[i].sourceNodeIndex != edges[numEdges - 1].sourceNodeIndex || edges[i].destinationNodeIndex != edges[numEdges - 1].destinationNodeIndex)
+            edges[numEdges++] = edges[i];
+
+    while (edges.Size() > numEdges)
+        edges.RemoveLast();
+
+    CsrGraph condensation;
+    condensation.Build(numComponents, edges);
+
+    return condensation;
+}
+
+/**** parallel forward-backward strongly connected components ****/
+// trivial components (no incoming or no outgoing edge) are trimmed first, then a task holds a set of nodes sharing a
+// color: the nodes reached both forward and backward from a pivot form a component and the three remaining sets become
+// independent tasks run on the shared thread pool, tasks smaller than sequentialSize are finished with Tarjan,
+// component ids are not ordered
+inline unsigned int ParallelStronglyConnectedComponents(const CsrView &csr, const CsrView &transpose, Vector<unsigned int> &components,
+                                                        unsigned int sequentialSize = 4096)
+{
+    unsigned int numNodes = csr.Size();
+
+    components.Clear();
+    components.Resize(numNodes, NO_COMPONENT);
+
+    Vector<std::atomic<unsigned int>> colors(numNodes);   // nodes are written by the task owning them, read by any task
+    std::atomic<unsigned int> nextColor{1};
+    std::atomic<unsigned int> numComponents{0};
+
+    // 1. trim: repeatedly peel nodes without remaining incoming or outgoing edges (each is a component on its own)
+    Vector<unsigned int> inDegrees, outDegrees, trimmed;
+    inDegrees.Resize(numNodes);
+    outDegrees.Resize(numNodes);
+
+    for (unsigned int i = 0; i < numNodes; i++)
+    {
+        colors[i].store(0, std::memory_order_relaxed);
+        inDegrees[i] = transpose.Degree(i);
+        outDegrees[i] = csr.Degree(i);
+
+        if (inDegrees[i] == 0 || outDegrees[i] == 0)
+        {
+            components[i] = numComponents++;
+            trimmed.InsertLast(i);
+        }
+    }
+
+    for (unsigned int front = 0; front < trimmed.Size(); front++)
+    {
+        unsigned int nodeIndex = trimmed[front];
+
+        for (const unsigned int *target = csr.TargetsBegin(nodeIndex); target != csr.TargetsEnd(nodeIndex); ++target)
+            if (components[*target] == NO_COMPONENT && --inDegrees[*target] == 0)
+            {
+                components[*target] = numComponents++;
+                trimmed.InsertLast(*target);
+            }
+
+        for (const unsigned int *source = transpose.TargetsBegin(nodeIndex); source != transpose.TargetsEnd(nodeIndex); ++source)
+            if (components[*source] == NO_COMPONENT && --outDegrees[*source] == 0)
+            {
+                components[*source] = numComponents++;
+                trimmed.InsertLast(*source);
+            }
+    }
+
+    // 2. forward-backward tasks
+    struct Task
+    {
+        unsigned int mColor;
+        Vector<unsigned int> mNodes;
+    };
+
+    Task firstTask{0U, Vector<unsigned int>()};
+
+    for (unsigned int i = 0; i < numNodes; i++)
+        if (components[i] == NO_COMPONENT)
+            firstTask.mNodes.InsertLast(i);
+
+    for (unsigned int nodeIndex : trimmed)
+        colors[nodeIndex].store(NO_COMPONENT, std::memory_order_relaxed);
+
+    Vector<unsigned int> indices, lowLinks;   // Tarjan arrays, disjoint parts are used by concurrent tasks
+    indices.Resize(numNodes, NO_COMPONENT);
+    lowLinks.Resize(numNodes);
+
+    Vector<Task> tasks;   // tasks of the current round, their subtasks make the next round
+    std::mutex mutex;
+
+    if (!firstTask.mNodes.Empty())
+        tasks.InsertLast(std::move(firstTask));
+
+    auto newComponent = [&numComponents]() { return numComponents.fetch_add(1, std::memory_order_relaxed); };
+
+    auto run = [&](Task &task, Vector<Task> &nextTasks)
+    {
+        unsigned int color = task.mColor;
+        auto hasColor = [&colors](unsigned int nodeIndex, unsigned int expectedColor) { return colors[nodeIndex].load(std::memory_order_relaxed) == expectedColor; };
+
+        if (task.mNodes.Size() < sequentialSize)
+        {
+            TarjanVisit(csr, task.mNodes.Begin(), task.mNodes.End(), [&](unsigned int nodeIndex) { return hasColor(nodeIndex, color); },
+                        newComponent, components.Data(), indices.Data(), lowLinks.Data());
+            return;
+        }
+
+        unsigned int forwardColor = nextColor.fetch_add(3, std::memory_order_relaxed);   // forward only, both, backward only
+        unsigned int bothColor = forwardColor + 1;
+        unsigned int backwardColor = forwardColor + 2;
+
+        unsigned int pivot = task.mNodes[task.mNodes.Size() / 2];
+        Vector<unsigned int> stack;
+
+        // forward closure of the pivot inside the task
+        colors[pivot].store(forwardColor, std::memory_order_relaxed);
+        stack.InsertLast(pivot);
+
+        while (!stack.Empty())
+        {
+            unsigned int nodeIndex = stack.Last();
+            stack.RemoveLast();
+
+            for (const unsigned int *target = csr.TargetsBegin(nodeIndex); target != csr.TargetsEnd(nodeIndex); ++target)
+                if (hasColor(*target, color))
+                {
+                    colors[*target].store(forwardColor, std::memory_order_relaxed);
+                    stack.InsertLast(*target);
+                }
+        }
+
+        // backward closure: forward nodes reached again are the pivot's component
+        colors[pivot].store(bothColor, std::memory_order_relaxed);
+        stack.InsertLast(pivot);
+
+        while (!stack.Empty())
+        {
+            unsigned int nodeIndex = stack.Last();
+            stack.RemoveLast();
+
+            for (const unsigned int *source = transpose.TargetsBegin(nodeIndex); source != transpose.TargetsEnd(nodeIndex); ++source)
+            {
+                unsigned int sourceColor = colors[*source].load(std::memory_order_relaxed);
+
+                if (sourceColor == color || sourceColor == forwardColor)
+                {
+                    colors[*source].store(sourceColor == color ? backwardColor : bothColor, std::memory_order_relaxed);
+                    stack.InsertLast(*source);
+                }
+            }
+        }
+
+        // split the task by color
+        Task subtasks[3] = { {forwardColor, Vector<unsigned int>()}, {backwardColor, Vector<unsigned int>()}, {color, Vector<unsigned int>()} };
+        unsigned int component = newComponent();
+
+        for (unsigned int nodeIndex : task.mNodes)
+        {
+            unsigned int nodeColor = colors[nodeIndex].load(std::memory_order_relaxed);
+
+            if (nodeColor == bothColor)
+            {
+                components[nodeIndex] = component;
+                colors[nodeIndex].store(NO_COMPONENT, std::memory_order_relaxed);
+            }
+            else
+                subtasks[nodeColor == forwardColor ? 0 : nodeColor == backwardColor ? 1 : 2].mNodes.InsertLast(nodeIndex);
+        }
+
+        task.mNodes.Clear();
+
+        std::lock_guard<std::mutex> lock(mutex);
+
+        for (Task &subtask : subtasks)
+            if (!subtask.mNodes.Empty())
+                nextTasks.InsertLast(std::move(subtask));
+    };
+
+    // rounds on the shared pool, one task per chunk (task sizes are very uneven)
+    while (!tasks.Empty())
+    {
+        Vector<Task> nextTasks;
+
+        ThreadPool::Shared().Run(0, tasks.Size(), 1, [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+                run(tasks[i], nextTasks);
+        });
+
+        tasks = std::move(nextTasks);
+    }
+
+    return numComponents.load();
+}
+
+#endif  // GRAPH_COMPONENTS_H
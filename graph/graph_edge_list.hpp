@@ -1,5 +1,11 @@
 #include "../vector/vector.hpp"
+#include "../disjoint set/disjoint_set.hpp"
+#include "shortest_path_tree.hpp"
+#include "minimum_spanning_tree.hpp"
 #include <limits>
+#include <exception>
+
+class NegativeCycleException : public std::exception {};
 
 template <typename T, typename Heuristic>
 class Graph;
@@ -38,11 +44,24 @@ public:
         float weight;
     };
 
+    class EdgeRange   // contiguous range of edges with the same source node
+    {
+    public:
+        EdgeRange(const Edge *begin, const Edge *end) : mBegin(begin), mEnd(end) {}
+
+        const Edge *begin() const { return mBegin; }
+        const Edge *end() const { return mEnd; }
+        unsigned int Size() const { return static_cast<unsigned int>(mEnd - mBegin); }
+    private:
+        const Edge *mBegin;
+        const Edge *mEnd;
+    };
+
 public:
     using Path = Vector<Graph::Node const *>;
 
 public:
-    void AddNode(const T &data) { mNodes.InsertLast(Node{data}); }
+    void AddNode(const T &data) { mNodes.InsertLast(Node{data}); mComponents.MakeSet(); mSorted = false; }
 
     void AddEdge(unsigned int nodeIndex1, unsigned int nodeIndex2, float weight = 1.0f, bool directed = false) 
     { 
@@ -52,9 +71,21 @@ public:
 
             if (!directed)
                 mEdges.InsertLast(Edge{nodeIndex2, nodeIndex1, weight}); 
+
+            mComponents.Union(nodeIndex1, nodeIndex2);
+            mSorted = false;
         }
     }
 
+    bool Reachable(unsigned int nodeIndex1, unsigned int nodeIndex2) const { return mComponents.Connected(nodeIndex1, nodeIndex2); }   // ignoring edge direction, near O(1)
+
+    // sort edges by source node index and build offsets index. done lazily by the first neighbour lookup after AddNode or
+    // AddEdge, which writes the edge list from a const method: call SortEdges() once loading is done before sharing the
+    // graph between threads, GetAdjacentEdges only reads after that (the searches still write per node traversal state)
+    void SortEdges() const;
+
+    EdgeRange GetAdjacentEdges(unsigned int nodeIndex) const;   // O(deg) once edges are sorted, sorts them first otherwise
+
     int GetUnvisitedAdjacentNodeIndex(unsigned int nodeIndex) const;
 
     template <class F>
@@ -66,16 +97,27 @@ public:
     template <typename F>
     void DepthFirstSearchRecursive(unsigned int nodeIndex, const F&f);
 
-    Vector<Path> DijkstraShortestPath(unsigned int startNodeIndex) const;
+    ShortestPathTree DijkstraShortestPath(unsigned int startNodeIndex) const;
 
     Path DijkstraShortestPath(unsigned int startNodeIndex, unsigned int endNodeIndex) const; 
 
     Path AStar(unsigned int startNodeIndex, unsigned int endNodeIndex) const;
 
+    ShortestPathTree BellmanFordShortestPath(unsigned int startNodeIndex) const;   // negative weights allowed, throws NegativeCycleException
+
+    Vector<SpanningTreeEdge> KruskalMinimumSpanningTree() const;   // edges are treated as undirected, returns a spanning forest if graph is disconnected
+
+    Vector<unsigned int> ConnectedComponents(unsigned int *numComponents = nullptr) const;   // component label (0, 1, ...) of each node
+
 private:
     static const float INF;
-    Vector<Node> mNodes;   // list of nodes
-    Vector<Edge> mEdges;   // list of edges
+    Vector<Node> mNodes;           // list of nodes
+    mutable Vector<Edge> mEdges;   // list of edges (sorted lazily by source node index)
+
+    mutable Vector<unsigned int> mOffsets;   // edges of node i are in [mOffsets[i], mOffsets[i + 1]) once sorted
+    mutable bool mSorted = false;
+
+    DisjointSet mComponents;   // connected components, updated incrementally as edges are added
 
     void GetHeuristic(unsigned int nodeIndex, unsigned int startNodeIndex) const;
 };
@@ -83,11 +125,56 @@ private:
 template <typename T, typename Heuristic>
 const float Graph<T, Heuristic>::INF = std::numeric_limits<float>::max();
 
+// in-place counting sort (single pass radix sort with one bucket per source node): count edges per source node,
+// prefix sum the counts into bucket offsets, then swap each edge into its bucket following permutation cycles
 template <typename T, typename Heuristic>
-int Graph<T, Heuristic>::GetUnvisitedAdjacentNodeIndex(unsigned int nodeIndex) const
+void Graph<T, Heuristic>::SortEdges() const
 {
+    unsigned int numNodes = mNodes.Size();
+
+    mOffsets.Clear();
+    mOffsets.Resize(numNodes + 1, 0U);
+
     for (const Edge &edge : mEdges)
-        if (nodeIndex == edge.sourceNodeIndex && !mNodes[edge.destinationNodeIndex].visited)
+        mOffsets[edge.sourceNodeIndex + 1]++;
+
+    for (unsigned int i = 0; i < numNodes; i++)
+        mOffsets[i + 1] += mOffsets[i];
+
+    Vector<unsigned int> next(mOffsets);   // next free slot of each bucket
+
+    for (unsigned int bucket = 0; bucket < numNodes; bucket++)
+        while (next[bucket] < mOffsets[bucket + 1])
+        {
+            Edge &edge = mEdges[next[bucket]];
+
+            if (edge.sourceNodeIndex == bucket)
+                next[bucket]++;
+            else   // swap edge into its own bucket
+            {
+                Edge temp = edge;
+                edge = mEdges[next[temp.sourceNodeIndex]];
+                mEdges[next[temp.sourceNodeIndex]++] = temp;
+            }
+        }
+
+    mSorted = true;
+}
+
+template <typename T, typename Heuristic>
+typename Graph<T, Heuristic>::EdgeRange Graph<T, Heuristic>::GetAdjacentEdges(unsigned int nodeIndex) const
+{
+    if (!mSorted)
+        SortEdges();
+
+    return EdgeRange(mEdges.Data() + mOffsets[nodeIndex], mEdges.Data() + mOffsets[nodeIndex + 1]);
+}
+
+template <typename T, typename Heuristic>
+int Graph<T, Heuristic>::GetUnvisitedAdjacentNodeIndex(unsigned int nodeIndex) const
+{
+    for (const Edge &edge : GetAdjacentEdges(nodeIndex))
+        if (!mNodes[edge.destinationNodeIndex].visited)
             return edge.destinationNodeIndex;
 
     return -1;
@@ -181,7 +268,7 @@ void Graph<T, Heuristic>::DepthFirstSearchRecursive(unsigned int nodeIndex, cons
 #include "../ADT/priority queue/priority_queue.hpp"
 
 template <typename T, typename Heuristic>
-Vector<typename Graph<T, Heuristic>::Path> Graph<T, Heuristic>::DijkstraShortestPath(unsigned int startNodeIndex) const
+ShortestPathTree Graph<T, Heuristic>::DijkstraShortestPath(unsigned int startNodeIndex) const
 {
     for (unsigned int i = 0; i < mNodes.Size(); i++)
     {
@@ -201,9 +288,9 @@ Vector<typename Graph<T, Heuristic>::Path> Graph<T, Heuristic>::DijkstraShortest
         nodePriorityQueue.Remove();                                           // remove current node from priority queue
         mNodes[currentNodeIndex].visited = true;                              // mark node as visited
 
-        for (const Edge &edge : mEdges)                                       // find all unvisited adjacent nodes
+        for (const Edge &edge : GetAdjacentEdges(currentNodeIndex))          // find all unvisited adjacent nodes
         {
-            if (currentNodeIndex != edge.sourceNodeIndex || mNodes[edge.destinationNodeIndex].visited)
+            if (mNodes[edge.destinationNodeIndex].visited)
                 continue;
             
             unsigned int unvisitedAdjacentNodeIndex = edge.destinationNodeIndex;
@@ -224,24 +311,15 @@ Vector<typename Graph<T, Heuristic>::Path> Graph<T, Heuristic>::DijkstraShortest
         }
     }
 
-    // create shortest paths
-    Vector<Path> paths;
-    paths.Resize(mNodes.Size());
+    ShortestPathTree shortestPathTree(mNodes.Size(), startNodeIndex);
 
     for (unsigned int i = 0; i < mNodes.Size(); i++)
     {
-        unsigned int currentNodeIndex = i;
-
-        while (currentNodeIndex != startNodeIndex)
-        {
-            paths[i].InsertFirst(&mNodes[currentNodeIndex]);
-            currentNodeIndex = mNodes[currentNodeIndex].parentNodeIndex;
-        } 
-
-        paths[i].InsertFirst(&mNodes[startNodeIndex]);
+        shortestPathTree.Distances()[i] = mNodes[i].distance;
+        shortestPathTree.Parents()[i] = mNodes[i].parentNodeIndex;
     }
     
-    return paths;
+    return shortestPathTree;
 }
 
 template <typename T, typename Heuristic>
@@ -270,9 +348,9 @@ typename Graph<T, Heuristic>::Path Graph<T, Heuristic>::DijkstraShortestPath(uns
         nodePriorityQueue.Remove();
         mNodes[currentNodeIndex].visited = true;
 
-        for (const Edge &edge : mEdges) 
+        for (const Edge &edge : GetAdjacentEdges(currentNodeIndex)) 
         {
-            if (currentNodeIndex != edge.sourceNodeIndex || mNodes[edge.destinationNodeIndex].visited)
+            if (mNodes[edge.destinationNodeIndex].visited)
                 continue;
             
             unsigned int unvisitedAdjacentNodeIndex = edge.destinationNodeIndex;
@@ -335,11 +413,8 @@ typename Graph<T, Heuristic>::Path Graph<T, Heuristic>::AStar(unsigned int start
         nodePriorityQueue.Remove();
         mNodes[currentNodeIndex].visited = true;
 
-        for (const Edge &edge : mEdges) 
+        for (const Edge &edge : GetAdjacentEdges(currentNodeIndex)) 
         {
-            if (currentNodeIndex != edge.sourceNodeIndex)
-                continue;
-            
             unsigned int adjacentNodeIndex = edge.destinationNodeIndex;
 
             float currentDistance = mNodes[adjacentNodeIndex].distance;
@@ -373,3 +448,153 @@ typename Graph<T, Heuristic>::Path Graph<T, Heuristic>::AStar(unsigned int start
 
     return path;
 }
+
+
+#include "../parallel/parallel_for.hpp"
+#include <atomic>
+
+// edges are streamed in source order and relaxed in place by all threads (atomic min on destination distance),
+// rounds stop as soon as a round relaxes no edge, a relaxation in round |V| means a negative cycle
+template <typename T, typename Heuristic>
+ShortestPathTree Graph<T, Heuristic>::BellmanFordShortestPath(unsigned int startNodeIndex) const
+{
+    if (!mSorted)
+        SortEdges();
+
+    unsigned int numNodes = mNodes.Size();
+
+    Vector<std::atomic<float>> distances(numNodes);
+    for (unsigned int i = 0; i < numNodes; i++)
+        distances[i].store(i == startNodeIndex ? 0.0f : INF, std::memory_order_relaxed);
+
+    std::atomic<bool> relaxed{true};
+
+    for (unsigned int round = 0; relaxed.load(); round++)
+    {
+        if (round == numNodes)
+            throw NegativeCycleException();
+
+        relaxed.store(false);
+
+        ParallelFor(0, mEdges.Size(), [this, &distances, &relaxed](size_t begin, size_t end)
+        {
+            bool relaxedChunk = false;
+
+            for (size_t i = begin; i < end; i++)
+            {
+                const Edge &edge = mEdges[i];
+
+                float sourceDistance = distances[edge.sourceNodeIndex].load(std::memory_order_relaxed);
+                if (sourceDistance == INF)
+                    continue;
+
+                float newDistance = sourceDistance + edge.weight;
+                std::atomic<float> &destinationDistance = distances[edge.destinationNodeIndex];
+
+                float currentDistance = destinationDistance.load(std::memory_order_relaxed);
+                while (newDistance < currentDistance)   // atomic min
+                    if (destinationDistance.compare_exchange_weak(currentDistance, newDistance, std::memory_order_relaxed))
+                    {
+                        relaxedChunk = true;
+                        break;
+                    }
+            }
+
+            if (relaxedChunk)
+                relaxed.store(true);
+        }, 4096);
+    }
+
+    ShortestPathTree shortestPathTree(numNodes, startNodeIndex);
+
+    float *treeDistances = shortestPathTree.Distances();
+    int *treeParents = shortestPathTree.Parents();
+
+    for (unsigned int i = 0; i < numNodes; i++)
+    {
+        treeDistances[i] = distances[i].load(std::memory_order_relaxed);
+        mNodes[i].visited = false;
+    }
+
+    // parent links: breadth first over tight edges (distance[source] + weight == distance[destination]) from start node,
+    // following tight edges guarantees a tree even with zero weight cycles
+    Queue<unsigned int> nodeQueue;
+
+    mNodes[startNodeIndex].visited = true;
+    nodeQueue.Enqueue(startNodeIndex);
+
+    while (!nodeQueue.Empty())
+    {
+        unsigned int currentNodeIndex = nodeQueue.Front();
+        nodeQueue.Dequeue();
+
+        for (const Edge &edge : GetAdjacentEdges(currentNodeIndex))
+        {
+            const Node &adjacentNode = mNodes[edge.destinationNodeIndex];
+
+            if (!adjacentNode.visited && treeDistances[currentNodeIndex] + edge.weight == treeDistances[edge.destinationNodeIndex])
+            {
+                adjacentNode.visited = true;
+                treeParents[edge.destinationNodeIndex] = currentNodeIndex;
+                nodeQueue.Enqueue(edge.destinationNodeIndex);
+            }
+        }
+    }
+
+    for (unsigned int i = 0; i < numNodes; i++)
+        mNodes[i].visited = false;
+
+    return shortestPathTree;
+}
+
+#include <algorithm>
+
+template <typename T, typename Heuristic>
+Vector<SpanningTreeEdge> Graph<T, Heuristic>::KruskalMinimumSpanningTree() const
+{
+    Vector<Edge> edges(mEdges);   // sorted copy, graph edges stay sorted by source node
+
+    std::sort(edges.Begin(), edges.End(), [](const Edge &edge1, const Edge &edge2) { return edge1.weight < edge2.weight; });
+
+    DisjointSet components(mNodes.Size());
+
+    Vector<SpanningTreeEdge> spanningTree;
+    spanningTree.Reserve(mNodes.Size() ? mNodes.Size() - 1 : 0);
+
+    for (const Edge &edge : edges)   // lightest edge joining two different trees is always safe
+    {
+        if (components.NumSets() == 1)
+            break;
+
+        if (components.Union(edge.sourceNodeIndex, edge.destinationNodeIndex))
+            spanningTree.InsertLast(SpanningTreeEdge{edge.sourceNodeIndex, edge.destinationNodeIndex, edge.weight});
+    }
+
+    return spanningTree;
+}
+
+template <typename T, typename Heuristic>
+Vector<unsigned int> Graph<T, Heuristic>::ConnectedComponents(unsigned int *numComponents) const
+{
+    // components are maintained incrementally by AddEdge: relabel roots as 0, 1, ... in order of first appearance
+    Vector<unsigned int> labels(mNodes.Size());
+    Vector<int> rootLabels;
+    rootLabels.Resize(mNodes.Size(), -1);
+
+    unsigned int numLabels = 0;
+
+    for (unsigned int i = 0; i < mNodes.Size(); i++)
+    {
+        unsigned int root = mComponents.Find(i);
+
+        if (rootLabels[root] == -1)
+            rootLabels[root] = numLabels++;
+
+        labels[i] = rootLabels[root];
+    }
+
+    if (numComponents)
+        *numComponents = numLabels;
+
+    return labels;
+}
@@ -0,0 +1,324 @@
+#ifndef GRAPH_LOADER_H
+#define GRAPH_LOADER_H
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <exception>
+
+#include "../vector/vector.hpp"
+#include "../memory_mapped_file.hpp"
+#include "csr_graph.hpp"
+
+class GraphFileException : public std::exception {};
+
+enum class EdgeListFormat
+{
+    TEXT,     // one edge per line: "source destination [weight]", lines starting with '#' or '%' are comments
+    BINARY    // packed records of { uint32 source, uint32 destination, float weight } (native byte order)
+};
+
+/**** streaming edge list reader: the file is read in fixed size chunks, f(source, destination, weight) is called for each edge ****/
+template <typename F>
+void ReadEdgeList(const char *path, EdgeListFormat format, const F &f)
+{
+    static const size_t CHUNK_SIZE = 1 << 20;
+
+    std::FILE *file = std::fopen(path, "rb");
+
+    if (!file)
+        throw GraphFileException();
+
+    Vector<char> buffer(CHUNK_SIZE + 1);   // + 1 for the terminator of the last line
+    char *data = buffer.Data();
+    size_t numBytes = 0;                   // bytes in buffer (a partial record is carried over to the next chunk)
+
+    while (true)
+    {
+        size_t numRead = std::fread(data + numBytes, 1, CHUNK_SIZE - numBytes, file);
+        numBytes += numRead;
+
+        bool endOfFile = numRead == 0;
+        size_t consumed = 0;
+
+        if (format == EdgeListFormat::BINARY)
+        {
+            static const size_t RECORD_SIZE = 2 * sizeof(std::uint32_t) + sizeof(float);
+
+            for (; consumed + RECORD_SIZE <= numBytes; consumed += RECORD_SIZE)
+            {
+                std::uint32_t source, destination;
+                float weight;
+
+                std::memcpy(&source, data + consumed, sizeof(source));
+                std::memcpy(&destination, data + consumed + sizeof(source), sizeof(destination));
+                std::memcpy(&weight, data + consumed + 2 * sizeof(source), sizeof(weight));
+
+                f(source, destination, weight);
+            }
+
+            if (endOfFile && consumed != numBytes)   // truncated record
+            {
+                std::fclose(file);
+                throw GraphFileException();
+            }
+        }
+        else
+        {
+            while (consumed < numBytes)
+            {
+                char *line = data + consumed;
+                char *lineEnd = static_cast<char*>(std::memchr(line, '\n', numBytes - consumed));
+
+                if (!lineEnd)
+                {
+                    if (!endOfFile)   // incomplete line, wait for the next chunk
+                        break;
+
+                    lineEnd = data + numBytes;   // last line without newline
+                }
+
+                *lineEnd = '\0';
+                consumed = lineEnd - data + 1;
+
+                while (*line == ' ' || *line == '\t')
+                    line++;
+
+                if (*line == '\0' || *line == '\r' || *line == '#' || *line == '%')
+                    continue;
+
+                char *end;
+                unsigned long source = std::strtoul(line, &end, 10);
+                if (end == line)
+                {
+                    std::fclose(file);
+                    throw GraphFileException();
+                }
+
+                line = end;
+                unsigned long destination = std::strtoul(line, &end, 10);
+                if (end == line)
+                {
+                    std::fclose(file);
+                    throw GraphFileException();
+                }
+
+                line = end;
+                float weight = std::strtof(line, &end);
+                if (end == line)   // weight is optional
+                    weight = 1.0f;
+
+                f(static_cast<unsigned int>(source), static_cast<unsigned int>(destination), weight);
+            }
+
+            if (consumed > numBytes)
+                consumed = numBytes;
+
+            if (consumed == 0 && numBytes == CHUNK_SIZE)   // line longer than a chunk
+            {
+                std::fclose(file);
+                throw GraphFileException();
+            }
+        }
+
+        if (endOfFile)
+            break;
+
+        // carry the partial record over to the front of the buffer
+        std::memmove(data, data + consumed, numBytes - consumed);
+        numBytes -= consumed;
+    }
+
+    std::fclose(file);
+}
+
+// load an edge list as a CSR graph (number of nodes is the largest node index + 1)
+inline CsrGraph LoadEdgeList(const char *path, EdgeListFormat format = EdgeListFormat::TEXT, bool directed = true)
+{
+    Vector<CsrGraph::Edge> edges;
+    unsigned int numNodes = 0;
+
+    ReadEdgeList(path, format, [&edges, &numNodes, directed](unsigned int source, unsigned int destination, float weight)
+    {
+        edges.InsertLast(CsrGraph::Edge{source, destination, weight});
+
+        if (!directed)
+            edges.InsertLast(CsrGraph::Edge{destination, source, weight});
+
+        if (source >= numNodes)
+            numNodes = source + 1;
+        if (destination >= numNodes)
+            numNodes = destination + 1;
+    });
+
+    CsrGraph graph;
+    graph.Build(numNodes, edges);
+
+    return graph;
+}
+
+// bulk load a CSR graph into a graph class (nodes are given the same data, edges are added as directed)
+template <typename G, typename T>
+void BuildGraph(const CsrView &csr, G &graph, const T &data = T())
+{
+    graph.Reserve(graph.Size() + csr.Size());
+
+    unsigned int firstNodeIndex = graph.Size();
+
+    for (unsigned int i = 0; i < csr.Size(); i++)
+        graph.AddNode(data);
+
+    for (unsigned int i = 0; i < csr.Size(); i++)
+    {
+        graph.ReserveEdges(firstNodeIndex + i, csr.Degree(i));
+
+        const float *weights = csr.Weights(i);
+
+        for (const unsigned int *target = csr.TargetsBegin(i); target != csr.TargetsEnd(i); ++target, ++weights)
+            graph.AddEdge(firstNodeIndex + i, firstNodeIndex + *target, *weights, true);
+    }
+}
+
+/**** binary graph file (version 1) ****/
+// header followed by the CSR arrays, each array starts at a 64 byte aligned offset so the file can be used in place once mapped:
+//     uint64 offsets[numNodes + 1] | uint32 targets[numEdges] | float weights[numEdges]
+struct GraphFileHeader
+{
+    static const std::uint32_t MAGIC = 0x48505247;   // "GRPH"
+    static const std::uint32_t VERSION = 1;
+    static const std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint32_t byteOrderMark;
+    std::uint32_t numNodes;
+    std::uint64_t numEdges;
+    std::uint64_t offsetsOffset;    // byte offset of each array from the start of the file
+    std::uint64_t targetsOffset;
+    std::uint64_t weightsOffset;
+    std::uint64_t fileSize;
+    std::uint64_t reserved;
+};
+
+inline std::uint64_t AlignGraphFileOffset(std::uint64_t offset)
+{
+    return (offset + 63) & ~std::uint64_t(63);
+}
+
+inline void WriteGraphFile(const char *path, const CsrView &csr)
+{
+    GraphFileHeader header{};
+    header.magic = GraphFileHeader::MAGIC;
+    header.version = GraphFileHeader::VERSION;
+    header.byteOrderMark = GraphFileHeader::BYTE_ORDER_MARK;
+    header.numNodes = csr.Size();
+    header.numEdges = csr.NumEdges();
+    header.offsetsOffset = AlignGraphFileOffset(sizeof(GraphFileHeader));
+    header.targetsOffset = AlignGraphFileOffset(header.offsetsOffset + (header.numNodes + 1) * sizeof(std::uint64_t));
+    header.weightsOffset = AlignGraphFileOffset(header.targetsOffset + header.numEdges * sizeof(unsigned int));
+    header.fileSize = header.weightsOffset + header.numEdges * sizeof(float);
+
+    std::FILE *file = std::fopen(path, "wb");
+
+    if (!file)
+        throw GraphFileException();
+
+    static const char padding[64] = {};
+    std::uint64_t position = 0;
+
+    auto write = [file, &position](std::uint64_t offset, const void *data, std::uint64_t size)
+    {
+        bool ok = std::fwrite(padding, 1, offset - position, file) == offset - position && std::fwrite(data, 1, size, file) == size;
+        position = offset + size;
+
+        return ok;
+    };
+
+    bool ok = write(0, &header, sizeof(header)) &&
+              write(header.offsetsOffset, csr.Offsets(), (header.numNodes + 1) * sizeof(std::uint64_t)) &&
+              write(header.targetsOffset, csr.Targets(), header.numEdges * sizeof(unsigned int)) &&
+              write(header.weightsOffset, csr.Weights(), header.numEdges * sizeof(float));
+
+    if (std::fclose(file) != 0 || !ok)
+        throw GraphFileException();
+}
+
+/**** read-only graph mapped directly from a binary graph file (no parsing, no copy: pages are loaded on first access) ****/
+class MappedGraph
+{
+public:
+    MappedGraph() = default;
+    MappedGraph(const char *path) { Open(path); }
+
+    void Open(const char *path);   // checks the header and the array bounds only: O(1), no page of the arrays is read
+    void Close() { mFile.Close(); mView = CsrView(); }
+
+    // O(V + E) check of the arrays (offsets do not decrease, targets are nodes), reads the whole file: call it once on
+    // files that may be corrupt, traversals of an unchecked file can read out of the mapping
+    void Validate() const;
+
+    CsrView View() const { return mView; }
+
+    unsigned int Size() const { return mView.Size(); }
+    std::uint64_t NumEdges() const { return mView.NumEdges(); }
+
+private:
+    MemoryMappedFile mFile;
+    CsrView mView;
+};
+
+inline void MappedGraph::Open(const char *path)
+{
+    mFile.Open(path, MemoryMappedFile::Mode::READ_ONLY);
+
+    GraphFileHeader header;
+
+    if (mFile.Size() < sizeof(header))
+        throw GraphFileException();
+
+    std::memcpy(&header, mFile.Data(), sizeof(header));
+
+    // every array must be aligned and lie inside the file (computed without overflow)
+    auto fits = [&header](std::uint64_t offset, std::uint64_t count, std::uint64_t elementSize)
+    {
+        return offset % elementSize == 0 && offset <= header.fileSize && count <= (header.fileSize - offset) / elementSize;
+    };
+
+    if (header.magic != GraphFileHeader::MAGIC || header.version != GraphFileHeader::VERSION || header.byteOrderMark != GraphFileHeader::BYTE_ORDER_MARK || header.fileSize > mFile.Size() ||
+        !fits(header.offsetsOffset, std::uint64_t(header.numNodes) + 1, sizeof(std::uint64_t)) ||
+        !fits(header.targetsOffset, header.numEdges, sizeof(unsigned int)) ||
+        !fits(header.weightsOffset, header.numEdges, sizeof(float)))
+    {
+        Close();
+        throw GraphFileException();
+    }
+
+    const char *data = mFile.Data();
+    const std::uint64_t *offsets = reinterpret_cast<const std::uint64_t*>(data + header.offsetsOffset);
+    const unsigned int *targets = reinterpret_cast<const unsigned int*>(data + header.targetsOffset);
+
+    if (offsets[0] != 0 || offsets[header.numNodes] != header.numEdges)
+    {
+        Close();
+        throw GraphFileException();
+    }
+
+    mView = CsrView(header.numNodes, header.numEdges, offsets, targets, reinterpret_cast<const float*>(data + header.weightsOffset));
+}
+
+inline void MappedGraph::Validate() const
+{
+    const std::uint64_t *offsets = mView.Offsets();
+    const unsigned int *targets = mView.Targets();
+
+    for (unsigned int i = 0; i < mView.Size(); i++)
+        if (offsets[i] > offsets[i + 1])
+            throw GraphFileException();
+
+    for (std::uint64_t i = 0; i < mView.NumEdges(); i++)
+        if (targets[i] >= mView.Size())
+            throw GraphFileException();
+}
+
+#endif  // GRAPH_LOADER_H
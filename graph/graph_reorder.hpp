@@ -0,0 +1,299 @@
+#ifndef GRAPH_REORDER_H
+#define GRAPH_REORDER_H
+
+#include <algorithm>
+
+#include "../vector/vector.hpp"
+#include "graph_traversal.hpp"
+
+/**** node orderings for cache locality: nodes that are traversed together get close indices ****/
+// all orderings work on any graph exposing Size() and GetAdjacencies(nodeIndex) and return an old to new index map
+// (newIndices[oldNodeIndex]), edges are followed in their stored direction and every component is ordered
+
+enum class NodeOrder
+{
+    REVERSE_CUTHILL_MCKEE,   // breadth first from a minimum degree node, neighbours by increasing degree, reversed (small bandwidth)
+    DEGREE_DESCENDING,       // hubs first (stable)
+    BREADTH_FIRST,           // breadth first discovery order
+    DEPTH_FIRST,             // depth first discovery order
+    GORDER                   // greedy: next node is the one sharing most edges and neighbours with the last placed nodes
+};
+
+// old to new index map of a sequence of old indices listed in their new order
+inline Vector<unsigned int> OrderToIndexMap(const Vector<unsigned int> &order)
+{
+    Vector<unsigned int> newIndices;
+    newIndices.Resize(order.Size());
+
+    for (unsigned int i = 0; i < order.Size(); i++)
+        newIndices[order[i]] = i;
+
+    return newIndices;
+}
+
+template <typename G>
+Vector<unsigned int> DegreeDescendingOrder(const G &graph)
+{
+    unsigned int numNodes = graph.Size();
+    unsigned int maxDegree = 0;
+
+    for (unsigned int i = 0; i < numNodes; i++)
+        maxDegree = std::max(maxDegree, static_cast<unsigned int>(graph.GetAdjacencies(i).Size()));
+
+    // counting sort by degree
+    Vector<unsigned int> counts;
+    counts.Resize(maxDegree + 2, 0U);
+
+    for (unsigned int i = 0; i < numNodes; i++)
+        counts[maxDegree - graph.GetAdjacencies(i).Size() + 1]++;
+
+    for (unsigned int i = 1; i < counts.Size(); i++)
+        counts[i] += counts[i - 1];
+
+    Vector<unsigned int> newIndices;
+    newIndices.Resize(numNodes);
+
+    for (unsigned int i = 0; i < numNodes; i++)
+        newIndices[i] = counts[maxDegree - graph.GetAdjacencies(i).Size()]++;
+
+    return newIndices;
+}
+
+template <typename G>
+Vector<unsigned int> BreadthFirstOrder(const G &graph, bool reverseCuthillMcKee = false)
+{
+    unsigned int numNodes = graph.Size();
+
+    Vector<unsigned int> order;   // doubles as the breadth first queue
+    order.Reserve(numNodes);
+
+    VisitMarks visitMarks;
+    visitMarks.Reset(numNodes);
+
+    Vector<unsigned int> roots;   // candidate roots of each component
+    roots.Resize(numNodes);
+
+    for (unsigned int i = 0; i < numNodes; i++)
+        roots[i] = i;
+
+    auto degree = [&graph](unsigned int nodeIndex) { return graph.GetAdjacencies(nodeIndex).Size(); };
+
+    if (reverseCuthillMcKee)   // peripheral nodes (low degree) make good roots
+        std::stable_sort(roots.Begin(), roots.End(), [&degree](unsigned int nodeIndex1, unsigned int nodeIndex2) { return degree(nodeIndex1) < degree(nodeIndex2); });
+
+    for (unsigned int root : roots)
+    {
+        if (visitMarks.Visited(root))
+            continue;
+
+        unsigned int front = order.Size();
+
+        visitMarks.Visit(root);
+        order.InsertLast(root);
+
+        while (front < order.Size())
+        {
+            unsigned int nodeIndex = order[front++];
+            unsigned int firstChild = order.Size();
+
+            for (const auto &adjacency : graph.GetAdjacencies(nodeIndex))
+                if (!visitMarks.Visited(adjacency.mConnectedNodeIndex))
+                {
+                    visitMarks.Visit(adjacency.mConnectedNodeIndex);
+                    order.InsertLast(adjacency.mConnectedNodeIndex);
+                }
+
+            if (reverseCuthillMcKee)
+                std::stable_sort(order.Begin() + firstChild, order.End(), [&degree](unsigned int nodeIndex1, unsigned int nodeIndex2) { return degree(nodeIndex1) < degree(nodeIndex2); });
+        }
+    }
+
+    if (reverseCuthillMcKee)
+        std::reverse(order.Begin(), order.End());
+
+    return OrderToIndexMap(order);
+}
+
+template <typename G>
+Vector<unsigned int> DepthFirstOrder(const G &graph)
+{
+    unsigned int numNodes = graph.Size();
+
+    Vector<unsigned int> newIndices;
+    newIndices.Resize(numNodes);
+    unsigned int nextIndex = 0;
+
+    Vector<DepthFirstFrame> stack;
+    VisitMarks visitMarks;
+    visitMarks.Reset(numNodes);
+
+    for (unsigned int root = 0; root < numNodes; root++)
+    {
+        if (visitMarks.Visited(root))
+            continue;
+
+        visitMarks.Visit(root);
+        newIndices[root] = nextIndex++;
+        stack.InsertLast(DepthFirstFrame{root, 0U});
+
+        while (!stack.Empty())
+        {
+            DepthFirstFrame &frame = stack.Last();
+            const auto &adjacencies = graph.GetAdjacencies(frame.mNodeIndex);
+
+            while (frame.mNextAdjacency < adjacencies.Size() && visitMarks.Visited(adjacencies[frame.mNextAdjacency].mConnectedNodeIndex))
+                frame.mNextAdjacency++;
+
+            if (frame.mNextAdjacency < adjacencies.Size())
+            {
+                unsigned int adjacentNodeIndex = adjacencies[frame.mNextAdjacency++].mConnectedNodeIndex;
+
+                visitMarks.Visit(adjacentNodeIndex);
+                newIndices[adjacentNodeIndex] = nextIndex++;
+                stack.InsertLast(DepthFirstFrame{adjacentNodeIndex, 0U});   // invalidates frame
+            }
+            else
+                stack.RemoveLast();
+        }
+    }
+
+    return newIndices;
+}
+
+// simplified Gorder: the score of a candidate is the number of edges and common neighbours it shares with the last
+// window placed nodes, scores are updated incrementally as nodes enter and leave the window and the best candidate is
+// taken from a lazy max heap (stale entries are skipped), hubs above maxHubDegree do not contribute sibling scores
+template <typename G>
+Vector<unsigned int> GorderOrder(const G &graph, unsigned int window = 5, unsigned int maxHubDegree = 64)
+{
+    struct Entry
+    {
+        int score;
+        unsigned int nodeIndex;
+
+        bool operator<(const Entry &other) const { return score < other.score || (score == other.score && nodeIndex > other.nodeIndex); }
+    };
+
+    unsigned int numNodes = graph.Size();
+
+    Vector<unsigned int> order;
+    order.Reserve(numNodes);
+
+    Vector<int> scores;
+    scores.Resize(numNodes, 0);
+
+    VisitMarks placed;
+    placed.Reset(numNodes);
+
+    Vector<Entry> heap;
+
+    // every neighbour and sibling (node sharing a neighbour, through non hub nodes) of nodeIndex gets delta
+    auto update = [&](unsigned int nodeIndex, int delta)
+    {
+        auto add = [&](unsigned int candidateIndex)
+        {
+            if (placed.Visited(candidateIndex))
+                return;
+
+            scores[candidateIndex] += delta;
+            heap.InsertLast(Entry{scores[candidateIndex], candidateIndex});
+            std::push_heap(heap.Begin(), heap.End());
+        };
+
+        for (const auto &adjacency : graph.GetAdjacencies(nodeIndex))
+        {
+            add(adjacency.mConnectedNodeIndex);
+
+            const auto &siblings = graph.GetAdjacencies(adjacency.mConnectedNodeIndex);
+
+            if (siblings.Size() <= maxHubDegree)
+                for (const auto &sibling : siblings)
+                    if (sibling.mConnectedNodeIndex != nodeIndex)
+                        add(sibling.mConnectedNodeIndex);
+        }
+    };
+
+    unsigned int nextRoot = 0;   // fallback when no candidate is connected to the window (next component)
+
+    while (order.Size() < numNodes)
+    {
+        unsigned int nodeIndex = numNodes;
+
+        while (!heap.Empty())
+        {
+            Entry entry = heap.First();
+            std::pop_heap(heap.Begin(), heap.End());
+            heap.RemoveLast();
+
+            if (!placed.Visited(entry.nodeIndex) && entry.score == scores[entry.nodeIndex] && entry.score > 0)
+            {
+                nodeIndex = entry.nodeIndex;
+                break;
+            }
+        }
+
+        if (nodeIndex == numNodes)
+        {
+            while (placed.Visited(nextRoot))
+                nextRoot++;
+
+            nodeIndex = nextRoot;
+        }
+
+        placed.Visit(nodeIndex);
+        order.InsertLast(nodeIndex);
+
+        update(nodeIndex, 1);
+
+        if (order.Size() > window)   // node leaving the window
+            update(order[order.Size() - window - 1], -1);
+    }
+
+    return OrderToIndexMap(order);
+}
+
+template <typename G>
+Vector<unsigned int> ComputeNodeOrder(const G &graph, NodeOrder nodeOrder)
+{
+    switch (nodeOrder)
+    {
+    case NodeOrder::REVERSE_CUTHILL_MCKEE:
+        return BreadthFirstOrder(graph, true);
+    case NodeOrder::DEGREE_DESCENDING:
+        return DegreeDescendingOrder(graph);
+    case NodeOrder::BREADTH_FIRST:
+        return BreadthFirstOrder(graph);
+    case NodeOrder::DEPTH_FIRST:
+        return DepthFirstOrder(graph);
+    default:
+        return GorderOrder(graph);
+    }
+}
+
+// apply an old to new index map to an array in place by following the permutation cycles (elements are swapped, not copied),
+// any indexable container (Vector, SegmentedVector)
+template <typename C>
+void PermuteInPlace(C &elements, const Vector<unsigned int> &newIndices)
+{
+    using std::swap;
+
+    VisitMarks placed;
+    placed.Reset(elements.Size());
+
+    for (unsigned int i = 0; i < elements.Size(); i++)
+    {
+        if (placed.Visited(i))
+            continue;
+
+        // carry element i along its cycle, element at slot i is always the one to place next
+        for (unsigned int j = newIndices[i]; j != i; j = newIndices[j])
+        {
+            swap(elements[i], elements[j]);
+            placed.Visit(j);
+        }
+
+        placed.Visit(i);
+    }
+}
+
+#endif  // GRAPH_REORDER_H
@@ -0,0 +1,94 @@
+#ifndef GRAPH_TRAVERSAL_H
+#define GRAPH_TRAVERSAL_H
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "../vector/vector.hpp"
+
+using std::size_t;
+
+/**** visited set cleared in O(1): a node is visited if its mark equals the current generation ****/
+class VisitMarks
+{
+public:
+    void Reset(size_t size);   // new traversal over size nodes (grows, never shrinks)
+
+    bool Visited(unsigned int nodeIndex) const { return mMarks[nodeIndex] == mGeneration; }
+    void Visit(unsigned int nodeIndex) { mMarks[nodeIndex] = mGeneration; }
+
+private:
+    Vector<unsigned int> mMarks;
+    unsigned int mGeneration = 0;
+};
+
+inline void VisitMarks::Reset(size_t size)
+{
+    if (mMarks.Size() < size)
+        mMarks.Resize(size, 0U);
+
+    if (++mGeneration == 0)   // generation counter wrapped around: clear marks once every 2^32 traversals
+    {
+        for (unsigned int &mark : mMarks)
+            mark = 0;
+
+        mGeneration = 1;
+    }
+}
+
+/**** depth first search frame: node and cursor to its next unexamined adjacency ****/
+struct DepthFirstFrame
+{
+    unsigned int mNodeIndex;
+    unsigned int mNextAdjacency;
+};
+
+/**** reusable scratch buffers of an iterative depth first traversal ****/
+struct DepthFirstScratch
+{
+    Vector<DepthFirstFrame> mStack;
+    VisitMarks mVisitMarks;
+};
+
+/**** borrow shared scratch buffers for the duration of a traversal, a nested traversal (started from a visitor) gets private buffers ****/
+template <typename S>
+class ScratchLease
+{
+public:
+    ScratchLease(S &shared, bool &inUse) : mInUse(inUse), mOwner(!inUse), mScratch(mOwner ? shared : mLocal) { mInUse = true; }
+    ScratchLease(const ScratchLease &other) = delete;
+
+    ~ScratchLease() { if (mOwner) mInUse = false; }
+
+    ScratchLease &operator=(const ScratchLease &other) = delete;
+
+    S &Get() { return mScratch; }
+
+private:
+    bool &mInUse;
+    bool mOwner;
+    S mLocal;
+    S &mScratch;
+};
+
+// call a traversal visitor: visitors return false to stop the traversal, visitors returning void never stop it
+template <typename F, typename... Args>
+bool CallVisitor(const F &visitor, Args&&... args)
+{
+    if constexpr (std::is_void<decltype(visitor(std::forward<Args>(args)...))>::value)
+    {
+        visitor(std::forward<Args>(args)...);
+        return true;
+    }
+    else
+        return static_cast<bool>(visitor(std::forward<Args>(args)...));
+}
+
+struct NullVisitor
+{
+    template <typename... Args>
+    bool operator()(Args&&...) const { return true; }
+};
+
+#endif  // GRAPH_TRAVERSAL_H
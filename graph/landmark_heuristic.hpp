@@ -0,0 +1,217 @@
+#ifndef LANDMARK_HEURISTIC_H
+#define LANDMARK_HEURISTIC_H
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#include "../vector/vector.hpp"
+#include "../parallel/parallel_for.hpp"
+#include "csr_graph.hpp"
+
+/**** ALT (A*, landmarks, triangle inequality) heuristic: lower bound of the distance between any two nodes from
+      precomputed distances to and from a few landmark nodes, works on any graph with non negative weights ****/
+// by the triangle inequality, for every landmark L: d(v, t) >= d(L, t) - d(L, v) and d(v, t) >= d(v, L) - d(t, L),
+// the heuristic is the best of these bounds over all landmarks (consistent, so A* with a closed set stays exact)
+class LandmarkHeuristic
+{
+public:
+    static constexpr float INF = std::numeric_limits<float>::max();
+
+public:
+    // select numLandmarks landmarks by farthest point sampling and compute their distance tables (one shortest path search
+    // from and one to each landmark, the searches to the landmarks run in parallel), graph exposes Size() and GetAdjacencies()
+    template <typename G>
+    void Build(const G &graph, unsigned int numLandmarks);
+
+    void Clear();   // no landmark: every bound is 0 until the next Build
+
+    // move the row of every node i to newIndices[i] (a permutation, distances do not change)
+    void Relabel(const Vector<unsigned int> &newIndices);
+
+    unsigned int NumLandmarks() const { return mLandmarks.Size(); }
+    unsigned int Landmark(unsigned int landmark) const { return mLandmarks[landmark]; }
+
+    // lower bound of the distance, 0 if nothing is known (nodes added after Build). the bounds hold while distances do not
+    // shrink: Build again after adding edges or lowering weights
+    float Distance(unsigned int nodeIndex, unsigned int endNodeIndex) const;
+
+    // drop-in heuristic for AStar
+    template <typename G>
+    float operator()(G const *, unsigned int nodeIndex, unsigned int endNodeIndex) const { return Distance(nodeIndex, endNodeIndex); }
+
+private:
+    unsigned int mNumNodes = 0;   // rows of the tables
+    Vector<unsigned int> mLandmarks;
+
+    // node major tables: the numLandmarks distances of a node are contiguous (one cache line for up to 16 landmarks)
+    Vector<float> mFromLandmarks;   // [nodeIndex * numLandmarks + landmark] = d(landmark, nodeIndex)
+    Vector<float> mToLandmarks;     // [nodeIndex * numLandmarks + landmark] = d(nodeIndex, landmark)
+
+    struct Entry
+    {
+        float mCost;
+        unsigned int mNodeIndex;
+
+        bool operator<(const Entry &other) const { return mCost > other.mCost; }   // min heap
+    };
+
+    // single source distances over a CSR graph, distances[i * stride] receives d(source, i)
+    static void ShortestDistances(const CsrView &csr, unsigned int source, float *distances, unsigned int stride, Vector<Entry> &heap);
+};
+
+inline void LandmarkHeuristic::ShortestDistances(const CsrView &csr, unsigned int source, float *distances, unsigned int stride, Vector<Entry> &heap)
+{
+    for (unsigned int i = 0; i < csr.Size(); i++)
+        distances[i * stride] = INF;
+
+    distances[source * stride] = 0.0f;
+
+    heap.Resize(0);
+    heap.InsertLast(Entry{0.0f, source});
+
+    while (!heap.Empty())
+    {
+        Entry entry = heap.First();
+        std::pop_heap(heap.Begin(), heap.End());
+        heap.RemoveLast();
+
+        if (entry.mCost != distances[entry.mNodeIndex * stride])   // stale entry
+            continue;
+
+        const float *weights = csr.Weights(entry.mNodeIndex);
+
+        for (const unsigned int *target = csr.TargetsBegin(entry.mNodeIndex); target != csr.TargetsEnd(entry.mNodeIndex); ++target, ++weights)
+        {
+            float cost = entry.mCost + *weights;
+
+            if (cost < distances[*target * stride])
+            {
+                distances[*target * stride] = cost;
+                heap.InsertLast(Entry{cost, *target});
+                std::push_heap(heap.Begin(), heap.End());
+            }
+        }
+    }
+}
+
+template <typename G>
+void LandmarkHeuristic::Build(const G &graph, unsigned int numLandmarks)
+{
+    CsrGraph forward;
+    forward.Build(graph);
+    CsrGraph backward = forward.Transpose();
+
+    unsigned int numNodes = forward.Size();
+
+    if (numLandmarks > numNodes)
+        numLandmarks = numNodes;
+
+    mNumNodes = numNodes;
+    mLandmarks.Clear();
+    mFromLandmarks.Clear();
+    mFromLandmarks.Resize(numNodes * numLandmarks);
+    mToLandmarks.Clear();
+    mToLandmarks.Resize(numNodes * numLandmarks);
+
+    // farthest point sampling: the next landmark is the node farthest from all landmarks so far (unreachable nodes first,
+    // which also spreads landmarks over the components), the search from a landmark fills its column of the from table
+    Vector<float> nearest;
+    nearest.Resize(numNodes, INF);
+
+    Vector<Entry> heap;
+    unsigned int landmark = 0;
+
+    for (unsigned int i = 0; i < numLandmarks; i++)
+    {
+        mLandmarks.InsertLast(landmark);
+
+        ShortestDistances(forward.View(), landmark, mFromLandmarks.Data() + i, numLandmarks, heap);
+
+        unsigned int farthest = landmark;
+        nearest[landmark] = -1.0f;   // never selected again
+
+        for (unsigned int j = 0; j < numNodes; j++)
+        {
+            nearest[j] = std::min(nearest[j], mFromLandmarks[j * numLandmarks + i]);
+
+            if (nearest[j] > nearest[farthest])
+                farthest = j;
+        }
+
+        landmark = farthest;
+    }
+
+    // searches to the landmarks are independent: one per thread, each writes its own column
+    ParallelFor(0, numLandmarks, [this, &backward, numLandmarks](size_t begin, size_t end)
+    {
+        Vector<Entry> heap;
+
+        for (size_t i = begin; i < end; i++)
+            ShortestDistances(backward.View(), mLandmarks[i], mToLandmarks.Data() + i, numLandmarks, heap);
+    });
+}
+
+inline void LandmarkHeuristic::Clear()
+{
+    mNumNodes = 0;
+    mLandmarks.Clear();
+    mFromLandmarks.Clear();
+    mToLandmarks.Clear();
+}
+
+inline void LandmarkHeuristic::Relabel(const Vector<unsigned int> &newIndices)
+{
+    unsigned int numLandmarks = mLandmarks.Size();
+
+    if (newIndices.Size() != mNumNodes)   // not the graph the tables were built on
+    {
+        Clear();
+        return;
+    }
+
+    Vector<float> fromLandmarks, toLandmarks;
+    fromLandmarks.Resize(mFromLandmarks.Size());
+    toLandmarks.Resize(mToLandmarks.Size());
+
+    for (unsigned int i = 0; i < mNumNodes; i++)
+        for (unsigned int j = 0; j < numLandmarks; j++)
+        {
+            fromLandmarks[newIndices[i] * numLandmarks + j] = mFromLandmarks[i * numLandmarks + j];
+            toLandmarks[newIndices[i] * numLandmarks + j] = mToLandmarks[i * numLandmarks + j];
+        }
+
+    mFromLandmarks = std::move(fromLandmarks);
+    mToLandmarks = std::move(toLandmarks);
+
+    for (unsigned int &landmark : mLandmarks)
+        landmark = newIndices[landmark];
+}
+
+inline float LandmarkHeuristic::Distance(unsigned int nodeIndex, unsigned int endNodeIndex) const
+{
+    unsigned int numLandmarks = mLandmarks.Size();
+
+    if (nodeIndex >= mNumNodes || endNodeIndex >= mNumNodes)
+        return 0.0f;
+
+    const float *fromNode = mFromLandmarks.Data() + nodeIndex * numLandmarks;
+    const float *fromEnd = mFromLandmarks.Data() + endNodeIndex * numLandmarks;
+    const float *toNode = mToLandmarks.Data() + nodeIndex * numLandmarks;
+    const float *toEnd = mToLandmarks.Data() + endNodeIndex * numLandmarks;
+
+    float bound = 0.0f;
+
+    for (unsigned int i = 0; i < numLandmarks; i++)
+    {
+        if (fromEnd[i] != INF && fromNode[i] != INF)   // d(L, t) - d(L, v)
+            bound = std::max(bound, fromEnd[i] - fromNode[i]);
+
+        if (toNode[i] != INF && toEnd[i] != INF)       // d(v, L) - d(t, L)
+            bound = std::max(bound, toNode[i] - toEnd[i]);
+    }
+
+    return bound;
+}
+
+#endif  // LANDMARK_HEURISTIC_H
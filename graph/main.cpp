@@ -74,10 +74,10 @@ int main(int argc, char **argv)
 
     auto shortestPaths = gi.DijkstraShortestPath(0);
 
-    for (auto path : shortestPaths)
+    for (unsigned int i = 0; i < shortestPaths.Size(); i++)
     {
-        for (auto node : path)
-            std::cout << node->data << " ";
+        for (auto nodeIndex : shortestPaths.GetPath(i))
+            std::cout << gi.GetData(nodeIndex) << " ";
 
         std::cout << '\n';
     }
@@ -144,5 +144,173 @@ int main(int argc, char **argv)
 
     std::cout << '\n';
 
+    std::cout << "A* shortest path from 0,0 to 2,0 (landmark heuristic)" << '\n';
+
+    Graph<Vector2D, LandmarkHeuristic> gl;
+
+    for (unsigned int i = 0; i < gv.Size(); i++)
+        gl.AddNode(gv.GetData(i));
+
+    for (unsigned int i = 0; i < gv.Size(); i++)
+        for (auto &adjacency : gv.GetAdjacencies(i))
+            gl.AddEdge(i, adjacency.mConnectedNodeIndex, adjacency.mWeight, true);
+
+    LandmarkHeuristic landmarks;
+    landmarks.Build(gl, 2);
+    gl.SetHeuristic(landmarks);
+
+    for (auto node : gl.AStar(0, 2))
+        std::cout << node->data << " ";
+
+    std::cout << '\n';
+
+    std::cout << "same query after reordering the nodes (the landmark tables follow) and adding a node (no bound for it)" << '\n';
+
+    auto reordered = gl.Reorder(NodeOrder::DEGREE_DESCENDING);
+
+    gl.AddNode(Vector2D(3.0f, 0.0f));
+    gl.AddEdge(reordered[2], gl.Size() - 1, 1.0f, true);
+
+    for (auto node : gl.AStar(reordered[0], reordered[2]))
+        std::cout << node->data << " ";
+
+    std::cout << '\n';
+
+    for (auto node : gl.AStar(reordered[0], gl.Size() - 1))
+        std::cout << node->data << " ";
+
+    std::cout << '\n';
+
+    std::cout << "shortest path tree from 0,0 repaired after 0,0 -> 1,0 drops to 0.5 and 1,0 -> 2,0 rises to 4" << '\n';
+
+    auto shortestPathTree = gv.DijkstraShortestPath(0);
+
+    Vector<Graph<Vector2D>::EdgeWeightUpdate> updates;
+    updates.InsertLast(Graph<Vector2D>::EdgeWeightUpdate{0, 1, 0.5f});
+    updates.InsertLast(Graph<Vector2D>::EdgeWeightUpdate{1, 2, 4.0f});
+
+    gv.UpdateEdgeWeights(updates);
+    gv.RepairShortestPathTree(shortestPathTree, updates);
+
+    for (unsigned int i = 0; i < shortestPathTree.Size(); i++)
+        std::cout << gv.GetData(i) << shortestPathTree.Distance(i) << '\n';
+
+    std::cout << "hop distances from A and from D" << '\n';
+
+    Vector<unsigned int> sources;
+    sources.InsertLast(0U);
+    sources.InsertLast(3U);
+
+    auto distances = gi.BreadthFirstDistances(sources);
+
+    for (unsigned int i = 0; i < sources.Size(); i++)
+    {
+        for (unsigned int nodeIndex = 0; nodeIndex < gi.Size(); nodeIndex++)
+        {
+            unsigned int distance = distances[i * gi.Size() + nodeIndex];
+
+            if (distance == MultiSourceBreadthFirstSearch<>::UNREACHED)
+                std::cout << gi.GetData(nodeIndex) << ":- ";
+            else
+                std::cout << gi.GetData(nodeIndex) << ":" << distance << " ";
+        }
+
+        std::cout << '\n';
+    }
+
+    std::cout << "topological order" << '\n';
+
+    Vector<unsigned int> order;
+
+    if (gi.TopologicalSort(order))
+        for (auto nodeIndex : order)
+            std::cout << gi.GetData(nodeIndex) << " ";
+
+    std::cout << '\n';
+
+    std::cout << "strongly connected components after adding G -> A" << '\n';
+
+    gi.AddEdge(6, 0, 1.0f, true);
+
+    unsigned int numComponents;
+    auto components = gi.StronglyConnectedComponents(&numComponents);
+
+    for (unsigned int component = 0; component < numComponents; component++)
+    {
+        std::cout << "{ ";
+
+        for (unsigned int nodeIndex = 0; nodeIndex < gi.Size(); nodeIndex++)
+            if (components[nodeIndex] == component)
+                std::cout << gi.GetData(nodeIndex) << " ";
+
+        std::cout << "} ";
+    }
+
+    std::cout << '\n';
+
+    std::cout << "remove edge G -> A, node B and compact" << '\n';
+
+    gi.RemoveEdge(6, 0, true);
+    gi.RemoveNode(1);
+
+    auto newIndices = gi.Compact();
+
+    for (unsigned int nodeIndex = 0; nodeIndex < newIndices.Size(); nodeIndex++)
+        std::cout << nodeIndex << " -> " << newIndices[nodeIndex] << " ";
+
+    std::cout << '\n';
+
+    for (unsigned int nodeIndex = 0; nodeIndex < gi.Size(); nodeIndex++)
+    {
+        std::cout << gi.GetData(nodeIndex) << ": ";
+
+        for (auto &adjacency : gi.GetAdjacencies(nodeIndex))
+            std::cout << gi.GetData(adjacency.mConnectedNodeIndex) << " ";
+
+        std::cout << '\n';
+    }
+
+    Graph<std::string> gu;   // undirected
+
+    gu.AddNode("A");
+    gu.AddNode("B");
+    gu.AddNode("C");
+    gu.AddNode("D");
+    gu.AddNode("E");
+
+    gu.AddEdge(0, 1, 4.0f);
+    gu.AddEdge(0, 2, 1.0f);
+    gu.AddEdge(1, 2, 2.0f);
+    gu.AddEdge(1, 3, 5.0f);
+    gu.AddEdge(2, 3, 8.0f);
+    gu.AddEdge(3, 4, 3.0f);
+
+    std::cout << "minimum spanning tree (Prim)" << '\n';
+
+    auto spanningTree = gu.MinimumSpanningTree();
+
+    for (auto &edge : spanningTree)
+        std::cout << gu.GetData(edge.mNodeIndex1) << "-" << gu.GetData(edge.mNodeIndex2) << " ";
+
+    std::cout << "weight " << SpanningTreeWeight(spanningTree) << '\n';
+
+    std::cout << "minimum spanning tree (parallel Boruvka)" << '\n';
+
+    spanningTree = gu.ParallelMinimumSpanningTree();
+
+    for (auto &edge : spanningTree)
+        std::cout << gu.GetData(edge.mNodeIndex1) << "-" << gu.GetData(edge.mNodeIndex2) << " ";
+
+    std::cout << "weight " << SpanningTreeWeight(spanningTree) << '\n';
+
+    std::cout << "reverse Cuthill-McKee order" << '\n';
+
+    gu.Reorder(NodeOrder::REVERSE_CUTHILL_MCKEE);
+
+    for (unsigned int nodeIndex = 0; nodeIndex < gu.Size(); nodeIndex++)
+        std::cout << gu.GetData(nodeIndex) << " ";
+
+    std::cout << '\n';
+
     return 0;
 }
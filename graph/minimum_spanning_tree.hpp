@@ -0,0 +1,231 @@
+#ifndef MINIMUM_SPANNING_TREE_H
+#define MINIMUM_SPANNING_TREE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+#include "../vector/vector.hpp"
+#include "../heap/indexed_heap.hpp"
+#include "../disjoint set/disjoint_set.hpp"
+#include "../parallel/parallel_for.hpp"
+#include "csr_graph.hpp"
+
+/**** minimum spanning trees (forests if the graph is disconnected) of undirected graphs, every algorithm returns the tree
+      as a compact list of edges ****/
+// undirected edges are expected in both directions (as AddEdge stores them), self loops are ignored
+
+struct SpanningTreeEdge
+{
+    unsigned int mNodeIndex1;   // node already in the tree when the edge was selected (Prim), smaller index otherwise
+    unsigned int mNodeIndex2;
+    float mWeight;
+};
+
+inline double SpanningTreeWeight(const Vector<SpanningTreeEdge> &spanningTree)
+{
+    double weight = 0.0;
+
+    for (const SpanningTreeEdge &edge : spanningTree)
+        weight += edge.mWeight;
+
+    return weight;
+}
+
+// Prim with an indexed heap, O(E log V): every node outside the tree is in the heap at most once, keyed by its lightest
+// edge to the tree. forEachAdjacency(nodeIndex, f) calls f(adjacentNodeIndex, weight) for every edge of nodeIndex
+template <typename F>
+Vector<SpanningTreeEdge> PrimMinimumSpanningTree(unsigned int numNodes, const F &forEachAdjacency)
+{
+    Vector<SpanningTreeEdge> spanningTree;
+    spanningTree.Reserve(numNodes ? numNodes - 1 : 0);
+
+    Vector<bool> inTree;
+    inTree.Resize(numNodes, false);
+    Vector<unsigned int> parents;
+    parents.Resize(numNodes);
+
+    IndexedHeap<float> heap;
+    heap.Reset(numNodes);
+
+    for (unsigned int root = 0; root < numNodes; root++)   // one tree per component
+    {
+        if (inTree[root])
+            continue;
+
+        unsigned int nodeIndex = root;
+
+        while (true)
+        {
+            inTree[nodeIndex] = true;
+
+            forEachAdjacency(nodeIndex, [&](unsigned int adjacentNodeIndex, float weight)
+            {
+                if (!inTree[adjacentNodeIndex] && heap.PushOrDecrease(adjacentNodeIndex, weight))
+                    parents[adjacentNodeIndex] = nodeIndex;
+            });
+
+            if (heap.Empty())
+                break;
+
+            float weight = heap.TopKey();
+            nodeIndex = heap.Pop();
+
+            spanningTree.InsertLast(SpanningTreeEdge{parents[nodeIndex], nodeIndex, weight});
+        }
+    }
+
+    return spanningTree;
+}
+
+inline Vector<SpanningTreeEdge> PrimMinimumSpanningTree(const CsrView &csr)
+{
+    return PrimMinimumSpanningTree(csr.Size(), [&csr](unsigned int nodeIndex, const auto &f)
+    {
+        const float *weights = csr.Weights(nodeIndex);
+
+        for (const unsigned int *target = csr.TargetsBegin(nodeIndex); target != csr.TargetsEnd(nodeIndex); ++target, ++weights)
+            f(*target, *weights);
+    });
+}
+
+// dense Prim, O(V^2) without heap: best choice when E is close to V^2 (adjacency matrix), weight(nodeIndex1, nodeIndex2)
+// returns noEdge when the nodes are not adjacent
+template <typename W>
+Vector<SpanningTreeEdge> DensePrimMinimumSpanningTree(unsigned int numNodes, const W &weight, float noEdge = std::numeric_limits<float>::max())
+{
+    Vector<SpanningTreeEdge> spanningTree;
+    spanningTree.Reserve(numNodes ? numNodes - 1 : 0);
+
+    Vector<float> keys;   // lightest edge to the tree of every node outside the tree
+    keys.Resize(numNodes, noEdge);
+    Vector<unsigned int> parents;
+    parents.Resize(numNodes);
+    Vector<bool> inTree;
+    inTree.Resize(numNodes, false);
+
+    for (unsigned int i = 0; i < numNodes; i++)
+    {
+        unsigned int nodeIndex = numNodes;
+
+        for (unsigned int j = 0; j < numNodes; j++)
+            if (!inTree[j] && (nodeIndex == numNodes || keys[j] < keys[nodeIndex]))
+                nodeIndex = j;
+
+        inTree[nodeIndex] = true;
+
+        if (keys[nodeIndex] != noEdge)   // otherwise first node of a new component
+            spanningTree.InsertLast(SpanningTreeEdge{parents[nodeIndex], nodeIndex, keys[nodeIndex]});
+
+        for (unsigned int j = 0; j < numNodes; j++)
+        {
+            float edgeWeight = weight(nodeIndex, j);
+
+            if (!inTree[j] && edgeWeight != noEdge && edgeWeight < keys[j])
+            {
+                keys[j] = edgeWeight;
+                parents[j] = nodeIndex;
+            }
+        }
+    }
+
+    return spanningTree;
+}
+
+// Boruvka: every round, each component selects its lightest outgoing edge and all selected edges are merged, so the number
+// of components at least halves. the O(E) scan for the lightest edge of every node runs in parallel, the per component
+// selection and the merges are O(V) and sequential. ties are broken by node indices (a strict total order on the edges,
+// so components can never select a cycle) and the result does not depend on the number of threads
+inline Vector<SpanningTreeEdge> ParallelBoruvkaMinimumSpanningTree(const CsrView &csr)
+{
+    static const std::uint64_t NO_EDGE = std::numeric_limits<std::uint64_t>::max();
+
+    struct Candidate
+    {
+        unsigned int mNodeIndex;
+        std::uint64_t mEdge;   // position in the CSR arrays
+    };
+
+    unsigned int numNodes = csr.Size();
+    const unsigned int *targets = csr.Targets();
+    const float *weights = csr.Weights();
+
+    auto lighter = [targets, weights](unsigned int source1, std::uint64_t edge1, unsigned int source2, std::uint64_t edge2)
+    {
+        if (weights[edge1] != weights[edge2])
+            return weights[edge1] < weights[edge2];
+
+        unsigned int low1 = std::min(source1, targets[edge1]), low2 = std::min(source2, targets[edge2]);
+
+        if (low1 != low2)
+            return low1 < low2;
+
+        return std::max(source1, targets[edge1]) < std::max(source2, targets[edge2]);
+    };
+
+    Vector<SpanningTreeEdge> spanningTree;
+    spanningTree.Reserve(numNodes ? numNodes - 1 : 0);
+
+    DisjointSet components(numNodes);
+
+    Vector<unsigned int> labels;   // component of every node during a round
+    labels.Resize(numNodes);
+    Vector<std::uint64_t> lightestEdges;   // per node
+    lightestEdges.Resize(numNodes);
+    Vector<Candidate> candidates;   // per component (indexed by root)
+    candidates.Resize(numNodes, Candidate{0U, NO_EDGE});
+
+    bool merged = true;
+
+    while (merged)
+    {
+        merged = false;
+
+        for (unsigned int i = 0; i < numNodes; i++)
+            labels[i] = components.Find(i);
+
+        ParallelFor(0, numNodes, [&](size_t begin, size_t end)
+        {
+            for (unsigned int i = begin; i < end; i++)
+            {
+                std::uint64_t lightest = NO_EDGE;
+
+                for (std::uint64_t edge = csr.Offsets()[i]; edge < csr.Offsets()[i + 1]; edge++)
+                    if (labels[targets[edge]] != labels[i] && (lightest == NO_EDGE || lighter(i, edge, i, lightest)))
+                        lightest = edge;
+
+                lightestEdges[i] = lightest;
+            }
+        }, 1024);
+
+        for (unsigned int i = 0; i < numNodes; i++)
+        {
+            Candidate &candidate = candidates[labels[i]];
+
+            if (lightestEdges[i] != NO_EDGE && (candidate.mEdge == NO_EDGE || lighter(i, lightestEdges[i], candidate.mNodeIndex, candidate.mEdge)))
+                candidate = Candidate{i, lightestEdges[i]};
+        }
+
+        for (unsigned int i = 0; i < numNodes; i++)
+        {
+            Candidate &candidate = candidates[i];
+
+            if (candidate.mEdge == NO_EDGE)
+                continue;
+
+            unsigned int source = candidate.mNodeIndex, target = targets[candidate.mEdge];
+
+            if (components.Union(source, target))   // false when both components selected the same edge
+            {
+                spanningTree.InsertLast(SpanningTreeEdge{std::min(source, target), std::max(source, target), weights[candidate.mEdge]});
+                merged = true;
+            }
+
+            candidate.mEdge = NO_EDGE;
+        }
+    }
+
+    return spanningTree;
+}
+
+#endif  // MINIMUM_SPANNING_TREE_H
@@ -0,0 +1,194 @@
+#ifndef MULTI_SOURCE_BFS_H
+#define MULTI_SOURCE_BFS_H
+
+#include <cstdint>
+#include <limits>
+
+#include "../vector/vector.hpp"
+#include "csr_graph.hpp"
+
+/**** multi source breadth first search (MS-BFS): up to 64 * NUM_WORDS sources advance together, every node holds one bit
+      per source in three bitsets (seen, frontier, next frontier), so one scan of an adjacency serves all the sources ****/
+// a level ORs the frontier bits of every frontier node into its neighbours, then keeps the bits not seen yet: a node
+// reached by k sources at the same level is expanded once instead of k times. NUM_WORDS = 1 gives 64 sources per batch,
+// NUM_WORDS = 4 gives 256 (the word loops on a 256 bit set compile to single SIMD operations)
+template <unsigned int NUM_WORDS = 4>
+class MultiSourceBreadthFirstSearch
+{
+public:
+    static constexpr unsigned int BATCH_SIZE = 64 * NUM_WORDS;
+    static constexpr unsigned int UNREACHED = std::numeric_limits<unsigned int>::max();
+
+public:
+    // hop distances from every source: distances[source * numNodes + nodeIndex] (UNREACHED if not reachable), any number of
+    // sources (processed by batches of BATCH_SIZE), graph is a CsrView or exposes Size() and GetAdjacencies(nodeIndex)
+    template <typename G>
+    void Run(const G &graph, const unsigned int *sources, unsigned int numSources, unsigned int *distances);
+
+    template <typename G>
+    Vector<unsigned int> Run(const G &graph, const Vector<unsigned int> &sources);
+
+private:
+    struct SourceSet
+    {
+        std::uint64_t mWords[NUM_WORDS];
+
+        bool Any() const;
+    };
+
+    // scratch reused across runs (cleared per batch, only the frontier nodes are visited at each level)
+    Vector<SourceSet> mSeen;
+    Vector<SourceSet> mFrontier;
+    Vector<SourceSet> mNextFrontier;
+    Vector<unsigned int> mFrontierNodes;
+    Vector<unsigned int> mNextFrontierNodes;
+
+    template <typename G>
+    void RunBatch(const G &graph, const unsigned int *sources, unsigned int numSources, unsigned int *distances);
+
+    template <typename F>
+    static void ForEachAdjacentNode(const CsrView &csr, unsigned int nodeIndex, const F &f);
+
+    template <typename G, typename F>
+    static void ForEachAdjacentNode(const G &graph, unsigned int nodeIndex, const F &f);
+};
+
+template <unsigned int NUM_WORDS>
+bool MultiSourceBreadthFirstSearch<NUM_WORDS>::SourceSet::Any() const
+{
+    std::uint64_t any = 0;
+
+    for (unsigned int i = 0; i < NUM_WORDS; i++)
+        any |= mWords[i];
+
+    return any != 0;
+}
+
+template <unsigned int NUM_WORDS>
+template <typename F>
+void MultiSourceBreadthFirstSearch<NUM_WORDS>::ForEachAdjacentNode(const CsrView &csr, unsigned int nodeIndex, const F &f)
+{
+    for (const unsigned int *target = csr.TargetsBegin(nodeIndex); target != csr.TargetsEnd(nodeIndex); ++target)
+        f(*target);
+}
+
+template <unsigned int NUM_WORDS>
+template <typename G, typename F>
+void MultiSourceBreadthFirstSearch<NUM_WORDS>::ForEachAdjacentNode(const G &graph, unsigned int nodeIndex, const F &f)
+{
+    for (const auto &adjacency : graph.GetAdjacencies(nodeIndex))
+        f(adjacency.mConnectedNodeIndex);
+}
+
+template <unsigned int NUM_WORDS>
+template <typename G>
+void MultiSourceBreadthFirstSearch<NUM_WORDS>::Run(const G &graph, const unsigned int *sources, unsigned int numSources, unsigned int *distances)
+{
+    unsigned int numNodes = graph.Size();
+
+    mSeen.Resize(numNodes);
+    mFrontier.Resize(numNodes);
+    mNextFrontier.Resize(numNodes);
+
+    for (unsigned int first = 0; first < numSources; first += BATCH_SIZE)
+    {
+        unsigned int batchSize = numSources - first < BATCH_SIZE ? numSources - first : BATCH_SIZE;
+
+        RunBatch(graph, sources + first, batchSize, distances + static_cast<size_t>(first) * numNodes);
+    }
+}
+
+template <unsigned int NUM_WORDS>
+template <typename G>
+Vector<unsigned int> MultiSourceBreadthFirstSearch<NUM_WORDS>::Run(const G &graph, const Vector<unsigned int> &sources)
+{
+    Vector<unsigned int> distances;
+    distances.Resize(static_cast<size_t>(sources.Size()) * graph.Size());
+
+    Run(graph, sources.Data(), sources.Size(), distances.Data());
+
+    return distances;
+}
+
+template <unsigned int NUM_WORDS>
+template <typename G>
+void MultiSourceBreadthFirstSearch<NUM_WORDS>::RunBatch(const G &graph, const unsigned int *sources, unsigned int numSources, unsigned int *distances)
+{
+    unsigned int numNodes = graph.Size();
+
+    for (size_t i = 0; i < static_cast<size_t>(numSources) * numNodes; i++)
+        distances[i] = UNREACHED;
+
+    SourceSet empty = {};
+
+    for (unsigned int i = 0; i < numNodes; i++)   // frontiers are left empty by the previous batch
+        mSeen[i] = empty;
+
+    mFrontierNodes.Resize(0);
+
+    for (unsigned int i = 0; i < numSources; i++)
+    {
+        unsigned int source = sources[i];
+
+        if (!mFrontier[source].Any())
+            mFrontierNodes.InsertLast(source);
+
+        mSeen[source].mWords[i / 64] |= std::uint64_t(1) << (i % 64);
+        mFrontier[source].mWords[i / 64] |= std::uint64_t(1) << (i % 64);
+        distances[static_cast<size_t>(i) * numNodes + source] = 0;
+    }
+
+    for (unsigned int level = 1; !mFrontierNodes.Empty(); level++)
+    {
+        mNextFrontierNodes.Resize(0);
+
+        // push: every frontier node hands its source bits to its neighbours
+        for (unsigned int nodeIndex : mFrontierNodes)
+        {
+            const SourceSet &frontier = mFrontier[nodeIndex];
+
+            ForEachAdjacentNode(graph, nodeIndex, [this, &frontier](unsigned int adjacentNodeIndex)
+            {
+                SourceSet &next = mNextFrontier[adjacentNodeIndex];
+
+                if (!next.Any())
+                    mNextFrontierNodes.InsertLast(adjacentNodeIndex);
+
+                for (unsigned int i = 0; i < NUM_WORDS; i++)
+                    next.mWords[i] |= frontier.mWords[i];
+            });
+        }
+
+        for (unsigned int nodeIndex : mFrontierNodes)
+            mFrontier[nodeIndex] = empty;
+
+        // keep the bits of the sources reaching a node for the first time, they get this level as distance
+        mFrontierNodes.Resize(0);
+
+        for (unsigned int nodeIndex : mNextFrontierNodes)
+        {
+            SourceSet &next = mNextFrontier[nodeIndex];
+            SourceSet &seen = mSeen[nodeIndex];
+            SourceSet &frontier = mFrontier[nodeIndex];
+
+            for (unsigned int i = 0; i < NUM_WORDS; i++)
+            {
+                frontier.mWords[i] = next.mWords[i] & ~seen.mWords[i];
+                seen.mWords[i] |= frontier.mWords[i];
+
+                for (std::uint64_t bits = frontier.mWords[i]; bits; bits &= bits - 1)
+                {
+                    unsigned int source = i * 64 + __builtin_ctzll(bits);
+                    distances[static_cast<size_t>(source) * numNodes + nodeIndex] = level;
+                }
+            }
+
+            next = empty;
+
+            if (frontier.Any())
+                mFrontierNodes.InsertLast(nodeIndex);
+        }
+    }
+}
+
+#endif  // MULTI_SOURCE_BFS_H
@@ -0,0 +1,92 @@
+#ifndef NODE_STATES_H
+#define NODE_STATES_H
+
+#include <limits>
+
+#include "../vector/vector.hpp"
+
+/**** traversal state of the graph nodes, one dense array per field (struct of arrays) kept apart from the node payload:
+      a shortest path search only touches costs, parents and flags (9 bytes per node) whatever the size of the payload ****/
+class NodeStates
+{
+public:
+    static constexpr float INF = std::numeric_limits<float>::max();
+
+    enum Flag : unsigned char
+    {
+        VISITED = 1,    // all adjacencies of the node have been examined
+        IN_QUEUE = 2    // node is waiting in a search queue
+    };
+
+public:
+    unsigned int Size() const { return mCosts.Size(); }
+
+    void AddNode();   // new node in reset state
+    void Reserve(unsigned int numNodes);
+    void Clear();
+
+    void Reset();   // every node unvisited, out of queue, INF cost and no parent
+
+    bool Visited(unsigned int nodeIndex) const { return mFlags[nodeIndex] & VISITED; }
+    void SetVisited(unsigned int nodeIndex) { mFlags[nodeIndex] |= VISITED; }
+
+    bool InQueue(unsigned int nodeIndex) const { return mFlags[nodeIndex] & IN_QUEUE; }
+    void SetInQueue(unsigned int nodeIndex) { mFlags[nodeIndex] |= IN_QUEUE; }
+
+    float &Cost(unsigned int nodeIndex) { return mCosts[nodeIndex]; }
+    float Cost(unsigned int nodeIndex) const { return mCosts[nodeIndex]; }
+
+    int &Parent(unsigned int nodeIndex) { return mParents[nodeIndex]; }
+    int Parent(unsigned int nodeIndex) const { return mParents[nodeIndex]; }
+
+    float &Heuristic(unsigned int nodeIndex) { return mHeuristics[nodeIndex]; }   // A* only
+    float Heuristic(unsigned int nodeIndex) const { return mHeuristics[nodeIndex]; }
+
+    const float *Costs() const { return mCosts.Data(); }
+    const int *Parents() const { return mParents.Data(); }
+
+private:
+    Vector<float> mCosts;
+    Vector<int> mParents;
+    Vector<unsigned char> mFlags;
+    Vector<float> mHeuristics;
+};
+
+inline void NodeStates::AddNode()
+{
+    mCosts.InsertLast(INF);
+    mParents.InsertLast(-1);
+    mFlags.InsertLast(static_cast<unsigned char>(0));
+    mHeuristics.InsertLast(0.0f);
+}
+
+inline void NodeStates::Reserve(unsigned int numNodes)
+{
+    mCosts.Reserve(numNodes);
+    mParents.Reserve(numNodes);
+    mFlags.Reserve(numNodes);
+    mHeuristics.Reserve(numNodes);
+}
+
+inline void NodeStates::Clear()
+{
+    mCosts.Clear();
+    mParents.Clear();
+    mFlags.Clear();
+    mHeuristics.Clear();
+}
+
+inline void NodeStates::Reset()
+{
+    // separate tight loops over each array (vectorizable), heuristics are recomputed by every A* search
+    for (float &cost : mCosts)
+        cost = INF;
+
+    for (int &parent : mParents)
+        parent = -1;
+
+    for (unsigned char &flags : mFlags)
+        flags = 0;
+}
+
+#endif  // NODE_STATES_H
@@ -0,0 +1,126 @@
+#ifndef SHORTEST_PATH_TREE_H
+#define SHORTEST_PATH_TREE_H
+
+#include <limits>
+
+#include "../vector/vector.hpp"
+
+/**** single source shortest paths: distance and parent of every node (paths are walked lazily from the parent links) ****/
+class ShortestPathTree
+{
+public:
+    static constexpr float INF = std::numeric_limits<float>::max();   // distance of unreachable nodes
+
+    class ReversePathIterator   // forward iterator from a node up to the source
+    {
+    public:
+        ReversePathIterator(const int *parents, int nodeIndex) : mParents(parents), mNodeIndex(nodeIndex) {}
+
+        unsigned int operator*() const { return static_cast<unsigned int>(mNodeIndex); }
+        ReversePathIterator &operator++() { mNodeIndex = mParents[mNodeIndex]; return *this; }
+        ReversePathIterator operator++(int) { ReversePathIterator temp = *this; ++*this; return temp; }
+        bool operator==(const ReversePathIterator &other) const { return mNodeIndex == other.mNodeIndex; }
+        bool operator!=(const ReversePathIterator &other) const { return mNodeIndex != other.mNodeIndex; }
+    private:
+        const int *mParents;
+        int mNodeIndex;
+    };
+
+    class ReversePath   // range of nodes from a node up to the source (empty if unreachable)
+    {
+    public:
+        ReversePath(const int *parents, int nodeIndex) : mParents(parents), mNodeIndex(nodeIndex) {}
+
+        ReversePathIterator begin() const { return ReversePathIterator(mParents, mNodeIndex); }
+        ReversePathIterator end() const { return ReversePathIterator(mParents, -1); }
+    private:
+        const int *mParents;
+        int mNodeIndex;
+    };
+
+public:
+    ShortestPathTree() : mSourceNodeIndex(0U) {}
+    ShortestPathTree(unsigned int numNodes, unsigned int sourceNodeIndex) { Reset(numNodes, sourceNodeIndex); }
+
+    void Reset(unsigned int numNodes, unsigned int sourceNodeIndex);   // every node unreachable but the source
+
+    unsigned int Size() const { return mDistances.Size(); }
+    unsigned int SourceNodeIndex() const { return mSourceNodeIndex; }
+
+    float Distance(unsigned int nodeIndex) const { return mDistances[nodeIndex]; }
+    int Parent(unsigned int nodeIndex) const { return mParents[nodeIndex]; }   // -1 for the source and unreachable nodes
+    bool Reachable(unsigned int nodeIndex) const { return nodeIndex == mSourceNodeIndex || mParents[nodeIndex] != -1; }
+
+    unsigned int PathLength(unsigned int nodeIndex) const;   // number of nodes on the path, 0 if unreachable
+
+    ReversePath GetReversePath(unsigned int nodeIndex) const { return ReversePath(mParents.Data(), Reachable(nodeIndex) ? static_cast<int>(nodeIndex) : -1); }
+
+    // write the path from the source to nodeIndex into a caller provided buffer, returns the number of nodes on the path
+    // (nothing is written if the path is longer than capacity)
+    unsigned int CopyPath(unsigned int nodeIndex, unsigned int *path, unsigned int capacity) const;
+
+    Vector<unsigned int> GetPath(unsigned int nodeIndex) const;   // source first
+
+    /**** raw arrays written by the shortest path algorithms ****/
+    float *Distances() { return mDistances.Data(); }
+    const float *Distances() const { return mDistances.Data(); }
+    int *Parents() { return mParents.Data(); }
+    const int *Parents() const { return mParents.Data(); }
+
+private:
+    unsigned int mSourceNodeIndex;
+    Vector<float> mDistances;
+    Vector<int> mParents;
+};
+
+inline void ShortestPathTree::Reset(unsigned int numNodes, unsigned int sourceNodeIndex)
+{
+    mSourceNodeIndex = sourceNodeIndex;
+
+    mDistances.Clear();
+    mDistances.Resize(numNodes, INF);
+    mParents.Clear();
+    mParents.Resize(numNodes, -1);
+
+    if (sourceNodeIndex < numNodes)
+        mDistances[sourceNodeIndex] = 0.0f;
+}
+
+inline unsigned int ShortestPathTree::PathLength(unsigned int nodeIndex) const
+{
+    unsigned int length = 0;
+
+    for (unsigned int pathNodeIndex : GetReversePath(nodeIndex))
+    {
+        (void)pathNodeIndex;
+        length++;
+    }
+
+    return length;
+}
+
+inline unsigned int ShortestPathTree::CopyPath(unsigned int nodeIndex, unsigned int *path, unsigned int capacity) const
+{
+    unsigned int length = PathLength(nodeIndex);
+
+    if (length > capacity)
+        return length;
+
+    unsigned int position = length;
+    for (unsigned int pathNodeIndex : GetReversePath(nodeIndex))   // fill from the back
+        path[--position] = pathNodeIndex;
+
+    return length;
+}
+
+inline Vector<unsigned int> ShortestPathTree::GetPath(unsigned int nodeIndex) const
+{
+    Vector<unsigned int> path;
+    path.Resize(PathLength(nodeIndex));
+
+    CopyPath(nodeIndex, path.Data(), path.Size());
+
+    return path;
+}
+
+#endif  // SHORTEST_PATH_TREE_H
@@ -5,6 +5,8 @@
 #include <exception>
 #include <utility>
 #include <new>
+#include "../vector/simd_search.hpp"
+#include "../allocation_policy.hpp"
 #include "../../function/function.hpp"
 
 using std::size_t;
@@ -25,13 +27,13 @@ bool Less(const T &a, const T &b)
 }
 
 /**** binary heap class vector implementation (using type erasure for comparator function) ****/
-template <typename T>
+template <typename T, typename A = DefaultAllocation>   // A: allocation policy of the array
 class Heap
 {
 public:
     Heap(const Function<bool(const T&, const T&)> &comparator = Less<T>) : mHeapArray(nullptr), mCapacity(0), mNumElements(0), mComparator(comparator) {}
 
-    ~Heap() { for (size_t i = 0; i < mNumElements; i++) Remove(); operator delete(mHeapArray); }
+    ~Heap() { for (size_t i = 0; i < mNumElements; i++) Remove(); A::Deallocate(mHeapArray, mCapacity * sizeof(T), alignof(T)); }
 
     bool Empty() const { return mNumElements == 0; }
     
@@ -70,17 +72,15 @@ private:
     void TrickleDownCopy(size_t index);
 };
 
-template <typename T>
-void Heap<T>::Reserve(size_t size)
+template <typename T, typename A>
+void Heap<T, A>::Reserve(size_t size)
 {
     // if requested capacity is less than actual capacity return
     if (size <= mCapacity)
         return;
-    else
-        mCapacity = size;
 
-    // allocate new buffer (operator new)
-    void *rawMem = operator new(size * sizeof(T));
+    // allocate new buffer (allocation policy)
+    void *rawMem = A::Allocate(size * sizeof(T), alignof(T));
 
     // copy elements to new buffer (placement-new)
     for (size_t i = 0; i < mNumElements; i++)
@@ -90,16 +90,17 @@ void Heap<T>::Reserve(size_t size)
     for (size_t i = 0; i < mNumElements; i++)
         mHeapArray[i].~T();
 
-    // deallocate old buffer (operator delete)
-    operator delete(mHeapArray);
+    // deallocate old buffer (allocation policy)
+    A::Deallocate(mHeapArray, mCapacity * sizeof(T), alignof(T));
 
-    // set new buffer
+    // set new buffer and capacity
     mHeapArray = static_cast<T*>(rawMem);
+    mCapacity = size;
 }
 
-template <typename T>
+template <typename T, typename A>
 template <typename U>
-void Heap<T>::Insert(U &&element)
+void Heap<T, A>::Insert(U &&element)
 {
     if (mCapacity <= mNumElements)
         Reserve(mCapacity ? mCapacity * 2 : 1);
@@ -113,8 +114,8 @@ void Heap<T>::Insert(U &&element)
     BubbleUpCopy(mNumElements - 1);
 }
 
-template <typename T>
-void Heap<T>::Remove()
+template <typename T, typename A>
+void Heap<T, A>::Remove()
 {
     if (Empty())
         throw HeapEmptyException();
@@ -138,8 +139,8 @@ void Heap<T>::Remove()
     }
 }
 
-template <typename T>
-bool Heap<T>::Remove(const T &element)
+template <typename T, typename A>
+bool Heap<T, A>::Remove(const T &element)
 {
     if (int index = Find(element); index != -1)
     {
@@ -162,9 +163,15 @@ bool Heap<T>::Remove(const T &element)
     return false;
 }
 
-template <typename T>
-int Heap<T>::Find(const T &element) const
+template <typename T, typename A>
+int Heap<T, A>::Find(const T &element) const
 {
+    if constexpr (SimdSearchable<T>::value)
+    {
+        size_t index = SimdFind(mHeapArray, mNumElements, element);
+        return index == mNumElements ? -1 : static_cast<int>(index);
+    }
+
     for (size_t i = 0; i < mNumElements; i++)
         if (element == mHeapArray[i])
             return static_cast<int>(i);
@@ -172,8 +179,8 @@ int Heap<T>::Find(const T &element) const
     return -1;
 }
 
-template <typename T>
-void Heap<T>::BubbleUpSwap(size_t index)
+template <typename T, typename A>
+void Heap<T, A>::BubbleUpSwap(size_t index)
 {
     // move the element up
     while (index > 0)
@@ -196,8 +203,8 @@ void Heap<T>::BubbleUpSwap(size_t index)
     }
 }
 
-template <typename T>
-void Heap<T>::BubbleUpCopy(size_t index)
+template <typename T, typename A>
+void Heap<T, A>::BubbleUpCopy(size_t index)
 {
     // save the element
     T temp = std::move(mHeapArray[index]);
@@ -221,8 +228,8 @@ void Heap<T>::BubbleUpCopy(size_t index)
     mHeapArray[index] = std::move(temp);
 }
 
-template <typename T>
-void Heap<T>::TrickleDownSwap(size_t index)
+template <typename T, typename A>
+void Heap<T, A>::TrickleDownSwap(size_t index)
 {
     // move the element down
     while (GetLeftChildIndex(index) < mNumElements)  // node has at least left child
@@ -255,8 +262,8 @@ void Heap<T>::TrickleDownSwap(size_t index)
     }
 }
 
-template <typename T>
-void Heap<T>::TrickleDownCopy(size_t index)
+template <typename T, typename A>
+void Heap<T, A>::TrickleDownCopy(size_t index)
 {
     // save the element
     T temp = std::move(mHeapArray[index]);
@@ -5,6 +5,8 @@
 #include <exception>
 #include <utility>
 #include <new>
+#include "../vector/simd_search.hpp"
+#include "../allocation_policy.hpp"
 
 using std::size_t;
 
@@ -17,13 +19,13 @@ bool Less(const T &a, const T &b)
 }
 
 /**** binary heap class vector implementation (using an additional template type parameter for comparator function object) ****/
-template <typename T, typename F = decltype(&Less<T>)>
+template <typename T, typename F = decltype(&Less<T>), typename A = DefaultAllocation>   // A: allocation policy of the array
 class Heap
 {
 public:
     Heap(const F &comparator = Less<T>) : mHeapArray(nullptr), mCapacity(0), mNumElements(0), mComparator(comparator) {}
 
-    ~Heap() { for (size_t i = 0; i < mNumElements; i++) Remove(); operator delete(mHeapArray); }
+    ~Heap() { for (size_t i = 0; i < mNumElements; i++) Remove(); A::Deallocate(mHeapArray, mCapacity * sizeof(T), alignof(T)); }
     
     bool Empty() const { return mNumElements == 0; }
     
@@ -62,17 +64,15 @@ private:
     void TrickleDownCopy(size_t index);
 };
 
-template <typename T, typename F>
-void Heap<T,F>::Reserve(size_t size)
+template <typename T, typename F, typename A>
+void Heap<T, F, A>::Reserve(size_t size)
 {
     // if requested capacity is less than actual capacity return
     if (size <= mCapacity)
         return;
-    else
-        mCapacity = size;
 
-    // allocate new buffer (operator new)
-    void *rawMem = operator new(size * sizeof(T));
+    // allocate new buffer (allocation policy)
+    void *rawMem = A::Allocate(size * sizeof(T), alignof(T));
 
     // copy elements to new buffer (placement-new)
     for (size_t i = 0; i < mNumElements; i++)
@@ -82,16 +82,17 @@ void Heap<T,F>::Reserve(size_t size)
     for (size_t i = 0; i < mNumElements; i++)
         mHeapArray[i].~T();
 
-    // deallocate old buffer (operator delete)
-    operator delete(mHeapArray);
+    // deallocate old buffer (allocation policy)
+    A::Deallocate(mHeapArray, mCapacity * sizeof(T), alignof(T));
 
-    // set new buffer
+    // set new buffer and capacity
     mHeapArray = static_cast<T*>(rawMem);
+    mCapacity = size;
 }
 
-template <typename T, typename F>
+template <typename T, typename F, typename A>
 template <typename U>
-void Heap<T,F>::Insert(U &&element)
+void Heap<T, F, A>::Insert(U &&element)
 {
     if (mCapacity <= mNumElements)
         Reserve(mCapacity ? mCapacity * 2 : 1);
@@ -105,8 +106,8 @@ void Heap<T,F>::Insert(U &&element)
     BubbleUpCopy(mNumElements - 1);
 }
 
-template <typename T, typename F>
-void Heap<T,F>::Remove()
+template <typename T, typename F, typename A>
+void Heap<T, F, A>::Remove()
 {
     if (Empty())
         throw HeapEmptyException();
@@ -130,8 +131,8 @@ void Heap<T,F>::Remove()
     }
 }
 
-template <typename T, typename F>
-bool Heap<T, F>::Remove(const T &element)
+template <typename T, typename F, typename A>
+bool Heap<T, F, A>::Remove(const T &element)
 {
     if (int index = Find(element); index != -1)
     {
@@ -154,9 +155,15 @@ bool Heap<T, F>::Remove(const T &element)
     return false;
 }
 
-template <typename T, typename F>
-int Heap<T, F>::Find(const T &element) const
+template <typename T, typename F, typename A>
+int Heap<T, F, A>::Find(const T &element) const
 {
+    if constexpr (SimdSearchable<T>::value)
+    {
+        size_t index = SimdFind(mHeapArray, mNumElements, element);
+        return index == mNumElements ? -1 : static_cast<int>(index);
+    }
+
     for (size_t i = 0; i < mNumElements; i++)
         if (element == mHeapArray[i])
             return static_cast<int>(i);
@@ -164,8 +171,8 @@ int Heap<T, F>::Find(const T &element) const
     return -1;
 }
 
-template <typename T, typename F>
-void Heap<T,F>::BubbleUpSwap(size_t index)
+template <typename T, typename F, typename A>
+void Heap<T, F, A>::BubbleUpSwap(size_t index)
 {
     // move the element up
     while (index > 0)
@@ -188,8 +195,8 @@ void Heap<T,F>::BubbleUpSwap(size_t index)
     }
 }
 
-template <typename T, typename F>
-void Heap<T,F>::BubbleUpCopy(size_t index)
+template <typename T, typename F, typename A>
+void Heap<T, F, A>::BubbleUpCopy(size_t index)
 {
     // save the element
     T temp = std::move(mHeapArray[index]);
@@ -213,8 +220,8 @@ void Heap<T,F>::BubbleUpCopy(size_t index)
     mHeapArray[index] = std::move(temp);
 }
 
-template <typename T, typename F>
-void Heap<T,F>::TrickleDownSwap(size_t index)
+template <typename T, typename F, typename A>
+void Heap<T, F, A>::TrickleDownSwap(size_t index)
 {
     // move the element down
     while (GetLeftChildIndex(index) < mNumElements)  // node has at least left child
@@ -247,8 +254,8 @@ void Heap<T,F>::TrickleDownSwap(size_t index)
     }
 }
 
-template <typename T, typename F>
-void Heap<T,F>::TrickleDownCopy(size_t index)
+template <typename T, typename F, typename A>
+void Heap<T, F, A>::TrickleDownCopy(size_t index)
 {
     // save the element
     T temp = std::move(mHeapArray[index]);
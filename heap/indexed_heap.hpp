@@ -0,0 +1,157 @@
+#ifndef INDEXED_HEAP_H
+#define INDEXED_HEAP_H
+
+#include <cstddef>
+#include <limits>
+
+#include "../vector/vector.hpp"
+
+using std::size_t;
+
+/**** binary min heap of ids in [0, capacity) with a key each: the position of every id is tracked, so the key of an id
+      already in the heap can be decreased in O(log n) (no duplicate or stale entries as with a plain heap) ****/
+template <typename Key = float>
+class IndexedHeap
+{
+public:
+    void Reset(unsigned int capacity);   // empty heap accepting ids below capacity
+
+    bool Empty() const { return mIds.Empty(); }
+    size_t Size() const { return mIds.Size(); }
+
+    bool Contains(unsigned int id) const { return mPositions[id] != NOT_IN_HEAP; }
+    Key const &GetKey(unsigned int id) const { return mKeys[id]; }   // last key given to id
+
+    void Push(unsigned int id, const Key &key);          // id must not be in the heap
+    void DecreaseKey(unsigned int id, const Key &key);   // id must be in the heap with a key not below key
+
+    // push id or lower its key, returns false (and does nothing) if id is in the heap with a key not above key
+    bool PushOrDecrease(unsigned int id, const Key &key);
+
+    unsigned int Top() const { return mIds[0]; }
+    Key const &TopKey() const { return mKeys[mIds[0]]; }
+
+    unsigned int Pop();   // remove and return the id with the smallest key
+
+private:
+    static constexpr unsigned int NOT_IN_HEAP = std::numeric_limits<unsigned int>::max();
+
+    Vector<unsigned int> mIds;         // heap ordered
+    Vector<unsigned int> mPositions;   // position of every id in mIds, NOT_IN_HEAP if absent
+    Vector<Key> mKeys;                 // key of every id
+
+    void BubbleUp(unsigned int position);
+    void TrickleDown(unsigned int position);
+};
+
+template <typename Key>
+void IndexedHeap<Key>::Reset(unsigned int capacity)
+{
+    mIds.Resize(0);
+    mPositions.Clear();
+    mPositions.Resize(capacity, NOT_IN_HEAP);
+    mKeys.Resize(capacity);
+}
+
+template <typename Key>
+void IndexedHeap<Key>::Push(unsigned int id, const Key &key)
+{
+    mKeys[id] = key;
+    mPositions[id] = mIds.Size();
+    mIds.InsertLast(id);
+
+    BubbleUp(mPositions[id]);
+}
+
+template <typename Key>
+void IndexedHeap<Key>::DecreaseKey(unsigned int id, const Key &key)
+{
+    mKeys[id] = key;
+
+    BubbleUp(mPositions[id]);
+}
+
+template <typename Key>
+bool IndexedHeap<Key>::PushOrDecrease(unsigned int id, const Key &key)
+{
+    if (!Contains(id))
+        Push(id, key);
+    else if (key < mKeys[id])
+        DecreaseKey(id, key);
+    else
+        return false;
+
+    return true;
+}
+
+template <typename Key>
+unsigned int IndexedHeap<Key>::Pop()
+{
+    unsigned int top = mIds[0];
+    mPositions[top] = NOT_IN_HEAP;
+
+    unsigned int last = mIds.Last();
+    mIds.RemoveLast();
+
+    if (!mIds.Empty())
+    {
+        mIds[0] = last;
+        mPositions[last] = 0;
+
+        TrickleDown(0);
+    }
+
+    return top;
+}
+
+// the moving id is held aside and written once at its final position (hole technique)
+template <typename Key>
+void IndexedHeap<Key>::BubbleUp(unsigned int position)
+{
+    unsigned int id = mIds[position];
+
+    while (position > 0)
+    {
+        unsigned int parentPosition = (position - 1) / 2;
+        unsigned int parentId = mIds[parentPosition];
+
+        if (!(mKeys[id] < mKeys[parentId]))
+            break;
+
+        mIds[position] = parentId;
+        mPositions[parentId] = position;
+        position = parentPosition;
+    }
+
+    mIds[position] = id;
+    mPositions[id] = position;
+}
+
+template <typename Key>
+void IndexedHeap<Key>::TrickleDown(unsigned int position)
+{
+    unsigned int id = mIds[position];
+    unsigned int size = mIds.Size();
+
+    while (2 * position + 1 < size)
+    {
+        unsigned int childPosition = 2 * position + 1;
+
+        if (childPosition + 1 < size && mKeys[mIds[childPosition + 1]] < mKeys[mIds[childPosition]])
+            childPosition++;
+
+        unsigned int childId = mIds[childPosition];
+
+        if (!(mKeys[childId] < mKeys[id]))
+            break;
+
+        mIds[position] = childId;
+        mPositions[childId] = position;
+        position = childPosition;
+    }
+
+    mIds[position] = id;
+    mPositions[id] = position;
+}
+
+#endif  // INDEXED_HEAP_H
@@ -0,0 +1,115 @@
+#ifndef HUGE_PAGE_ALLOCATION_H
+#define HUGE_PAGE_ALLOCATION_H
+
+#include <cstddef>
+#include <new>
+
+#include <sys/mman.h>      // Linux only (mmap, munmap, madvise, MAP_HUGETLB)
+#include <sys/syscall.h>   // mbind without libnuma
+#include <unistd.h>
+
+#include "allocation_policy.hpp"
+
+using std::size_t;
+
+enum class HugePages
+{
+    TRANSPARENT,   // 2 MB aligned anonymous mapping with madvise(MADV_HUGEPAGE), the kernel backs it with huge pages when it can
+    EXPLICIT       // MAP_HUGETLB from the reserved pool (vm.nr_hugepages), transparent when the pool is empty
+};
+
+constexpr int ANY_NUMA_NODE = -1;
+
+// arrays of at least one huge page get their own mapping, rounded up to whole 2 MB pages (one TLB entry covers 512 times
+// what a 4 KB page covers), smaller arrays come from AlignedAllocation<64>. with NUMA_NODE >= 0 the pages of the mappings
+// are bound to that node (mbind before first touch; ignored when the kernel has no NUMA support)
+template <HugePages HUGE_PAGES = HugePages::TRANSPARENT, int NUMA_NODE = ANY_NUMA_NODE>
+struct HugePageAllocation
+{
+    static_assert(NUMA_NODE < 1024, "NUMA node out of range");
+
+    static constexpr size_t HUGE_PAGE_SIZE = size_t(1) << 21;
+
+    static void *Allocate(size_t bytes, size_t alignment);
+    static void Deallocate(void *memory, size_t bytes, size_t alignment);
+
+private:
+    static size_t MappingSize(size_t bytes) { return (bytes + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1); }
+
+    static void *MapAligned(size_t size);
+    static void BindToNode(void *memory, size_t size);
+};
+
+template <HugePages HUGE_PAGES, int NUMA_NODE>
+void *HugePageAllocation<HUGE_PAGES, NUMA_NODE>::Allocate(size_t bytes, size_t alignment)
+{
+    if (bytes < HUGE_PAGE_SIZE || alignment > HUGE_PAGE_SIZE)
+        return AlignedAllocation<64>::Allocate(bytes, alignment);
+
+    size_t size = MappingSize(bytes);
+    void *memory = MAP_FAILED;
+
+#ifdef MAP_HUGETLB
+    if constexpr (HUGE_PAGES == HugePages::EXPLICIT)
+        memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+#endif
+
+    if (memory == MAP_FAILED)
+        memory = MapAligned(size);
+
+    if constexpr (NUMA_NODE >= 0)
+        BindToNode(memory, size);
+
+    return memory;
+}
+
+template <HugePages HUGE_PAGES, int NUMA_NODE>
+void HugePageAllocation<HUGE_PAGES, NUMA_NODE>::Deallocate(void *memory, size_t bytes, size_t alignment)
+{
+    if (bytes < HUGE_PAGE_SIZE || alignment > HUGE_PAGE_SIZE)
+        AlignedAllocation<64>::Deallocate(memory, bytes, alignment);
+    else
+        munmap(memory, MappingSize(bytes));
+}
+
+// map one huge page more than needed and unmap the unaligned head and the tail, so the kernel can use huge pages from
+// the first byte
+template <HugePages HUGE_PAGES, int NUMA_NODE>
+void *HugePageAllocation<HUGE_PAGES, NUMA_NODE>::MapAligned(size_t size)
+{
+    void *mapping = mmap(nullptr, size + HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if (mapping == MAP_FAILED)
+        throw std::bad_alloc();
+
+    char *begin = static_cast<char*>(mapping);
+    char *aligned = reinterpret_cast<char*>((reinterpret_cast<size_t>(begin) + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1));
+
+    if (aligned != begin)
+        munmap(begin, aligned - begin);
+
+    if (aligned + size != begin + size + HUGE_PAGE_SIZE)
+        munmap(aligned + size, begin + size + HUGE_PAGE_SIZE - (aligned + size));
+
+#ifdef MADV_HUGEPAGE
+    madvise(aligned, size, MADV_HUGEPAGE);
+#endif
+
+    return aligned;
+}
+
+template <HugePages HUGE_PAGES, int NUMA_NODE>
+void HugePageAllocation<HUGE_PAGES, NUMA_NODE>::BindToNode(void *memory, size_t size)
+{
+#ifdef SYS_mbind
+    static const int MPOL_BIND_MODE = 2;   // MPOL_BIND of <numaif.h>
+    static const unsigned long MAX_NODES = 1024;
+
+    unsigned long nodeMask[MAX_NODES / (8 * sizeof(unsigned long))] = {};
+    nodeMask[NUMA_NODE / (8 * sizeof(unsigned long))] = 1UL << (NUMA_NODE % (8 * sizeof(unsigned long)));
+
+    syscall(SYS_mbind, memory, size, MPOL_BIND_MODE, nodeMask, MAX_NODES + 1, 0);
+#endif
+}
+
+#endif  // HUGE_PAGE_ALLOCATION_H
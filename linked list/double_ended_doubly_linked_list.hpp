@@ -2,9 +2,12 @@
 #define DOUBLE_ENDED_DOUBLY_LINKED_LIST
 
 #include <cstddef>
+#include <functional>
 #include <utility>
 #include <exception>
 
+#include "../list_sort.hpp"
+
 using std::size_t;
 
 class ListEmptyException : public std::exception {};
@@ -117,6 +120,10 @@ public:
     /**** searching for an element is O(n) ****/
     Iterator Find(const T &key);
 
+    /**** sorting is O(n log n) and stable, the nodes are relinked (no element is copied or moved) ****/
+    template <typename C = std::less<>>
+    void Sort(const C &compare = C());
+
     /**** index/iterator conversion operations are O(n) ****/
     Iterator AtIndex(size_t index) const { Node *current = mFirst; while ((signed)index--) current = current->next; return Iterator(current, current ? current->previous : nullptr); }
     size_t IndexOf(const Iterator &iterator) const { Iterator it = Begin(); size_t count = 0; while (it != iterator) { count++; ++it;} return count; }
@@ -375,4 +382,22 @@ typename DoublyLinkedList<T>::Iterator DoublyLinkedList<T>::Find(const T &key)
     return End();      // not found: return off-the-end iterator
 }
 
+template <typename T>
+template <typename C>
+void DoublyLinkedList<T>::Sort(const C &compare)
+{
+    mFirst = ListSort(mFirst, compare);
+
+    // restore the backward links and the last node
+    Node *previous = nullptr;
+
+    for (Node *current = mFirst; current; current = current->next)
+    {
+        current->previous = previous;
+        previous = current;
+    }
+
+    mLast = previous;
+}
+
 #endif  // DOUBLE_ENDED_DOUBLY_LINKED_LIST
\ No newline at end of file
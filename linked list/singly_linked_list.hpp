@@ -2,9 +2,12 @@
 #define SINGLY_LINKED_LIST_H
 
 #include <cstddef>  
+#include <functional>
 #include <utility>
 #include <exception>
 
+#include "../list_sort.hpp"
+
 using std::size_t;
 
 class ListEmptyException : public std::exception {};
@@ -98,6 +101,10 @@ public:
     /**** searching for an element is O(n) ****/
     Iterator Find(const T &key) const;
 
+    /**** sorting is O(n log n) and stable, the nodes are relinked (no element is copied or moved) ****/
+    template <typename C = std::less<>>
+    void Sort(const C &compare = C());
+
     /**** index/iterator conversion operations are O(n) ****/
     Iterator AtIndex(size_t index) const { Node *current = mFirst; while ((signed)index--) current = current->next; return Iterator(current, current ? current->previous : nullptr); }
     size_t IndexOf(const Iterator &iterator) const { Iterator it = Begin(); size_t count = 0; while (it != iterator) { count++; ++it;} return count; }
@@ -268,4 +275,11 @@ typename SinglyLinkedList<T>::Iterator SinglyLinkedList<T>::Find(const T &key) c
     return Iterator(current, previous);
 }
 
+template <typename T>
+template <typename C>
+void SinglyLinkedList<T>::Sort(const C &compare)
+{
+    mFirst = ListSort(mFirst, compare);
+}
+
 #endif  // SINGLY_LINKED_LIST_H
\ No newline at end of file
@@ -0,0 +1,69 @@
+#ifndef LIST_SORT_H
+#define LIST_SORT_H
+
+/**** stable merge sort of a null terminated chain of nodes (members data and next), shared by the linked lists: the
+      nodes are relinked, no element is copied or moved. the list fixes its own last node and backward links ****/
+
+// merge two sorted chains, on ties the node of first comes first
+template <typename Node, typename C>
+Node *ListMerge(Node *first, Node *second, const C &compare)
+{
+    Node *head = nullptr, **tail = &head;
+
+    while (first && second)
+    {
+        if (compare(second->data, first->data))
+        {
+            *tail = second;
+            second = second->next;
+        }
+        else
+        {
+            *tail = first;
+            first = first->next;
+        }
+
+        tail = &(*tail)->next;
+    }
+
+    *tail = first ? first : second;
+
+    return head;
+}
+
+// bottom up: bins[i] holds a sorted chain of 2^i nodes (or none), every node is merged in like a carry in a binary
+// counter, so the chains merged always have close sizes. a bin holds nodes that came before those of lower bins and
+// ListMerge takes the earlier node first on ties, which keeps the sort stable. returns the new first node
+template <typename Node, typename C>
+Node *ListSort(Node *first, const C &compare)
+{
+    static const int MAX_BINS = 64;
+
+    Node *bins[MAX_BINS] = {};
+
+    while (first)
+    {
+        Node *run = first;
+        first = first->next;
+        run->next = nullptr;
+
+        int i = 0;
+        for (; bins[i]; i++)
+        {
+            run = ListMerge(bins[i], run, compare);
+            bins[i] = nullptr;
+        }
+
+        bins[i] = run;
+    }
+
+    Node *sorted = nullptr;
+
+    for (int i = 0; i < MAX_BINS; i++)
+        if (bins[i])
+            sorted = sorted ? ListMerge(bins[i], sorted, compare) : bins[i];
+
+    return sorted;
+}
+
+#endif  // LIST_SORT_H
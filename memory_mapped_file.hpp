@@ -0,0 +1,162 @@
+#ifndef MEMORY_MAPPED_FILE_H
+#define MEMORY_MAPPED_FILE_H
+
+#include <cstddef>
+#include <exception>
+
+#include <fcntl.h>      // POSIX only (open, mmap, ftruncate, msync)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using std::size_t;
+
+class MemoryMappedFileException : public std::exception {};
+
+/**** file mapped in memory (shared mapping: writes go to the file, pages are loaded lazily on first access) ****/
+class MemoryMappedFile
+{
+public:
+    enum class Mode { READ_ONLY, READ_WRITE };
+
+public:
+    MemoryMappedFile() : mData(nullptr), mSize(0), mFileDescriptor(-1), mMode(Mode::READ_ONLY) {}
+    MemoryMappedFile(const char *path, Mode mode = Mode::READ_ONLY) : MemoryMappedFile() { Open(path, mode); }
+    MemoryMappedFile(const MemoryMappedFile &other) = delete;
+    MemoryMappedFile(MemoryMappedFile &&other);
+
+    ~MemoryMappedFile() { Close(); }
+
+    MemoryMappedFile &operator=(const MemoryMappedFile &other) = delete;
+    MemoryMappedFile &operator=(MemoryMappedFile &&other);
+
+    void Open(const char *path, Mode mode = Mode::READ_ONLY);   // read-write mode creates the file if it does not exist
+    void Close();
+
+    bool IsOpen() const { return mFileDescriptor != -1; }
+    bool Writable() const { return mMode == Mode::READ_WRITE; }
+
+    size_t Size() const { return mSize; }
+    char *Data() { return mData; }
+    const char *Data() const { return mData; }
+
+    void Resize(size_t size);   // grow or shrink the file (ftruncate) and remap it, invalidates pointers into the mapping
+    void Sync();                // flush dirty pages to the file (msync)
+
+private:
+    char *mData;
+    size_t mSize;
+    int mFileDescriptor;
+    Mode mMode;
+
+    void Map();
+    void Unmap();
+};
+
+inline MemoryMappedFile::MemoryMappedFile(MemoryMappedFile &&other) : mData(other.mData), mSize(other.mSize), mFileDescriptor(other.mFileDescriptor), mMode(other.mMode)
+{
+    other.mData = nullptr;
+    other.mSize = 0;
+    other.mFileDescriptor = -1;
+}
+
+inline MemoryMappedFile &MemoryMappedFile::operator=(MemoryMappedFile &&other)
+{
+    if (this != &other)
+    {
+        Close();
+
+        mData = other.mData;
+        mSize = other.mSize;
+        mFileDescriptor = other.mFileDescriptor;
+        mMode = other.mMode;
+
+        other.mData = nullptr;
+        other.mSize = 0;
+        other.mFileDescriptor = -1;
+    }
+
+    return *this;
+}
+
+inline void MemoryMappedFile::Open(const char *path, Mode mode)
+{
+    Close();
+
+    mMode = mode;
+    mFileDescriptor = mode == Mode::READ_ONLY ? open(path, O_RDONLY) : open(path, O_RDWR | O_CREAT, 0644);
+
+    if (mFileDescriptor == -1)
+        throw MemoryMappedFileException();
+
+    struct stat fileStatus;
+    if (fstat(mFileDescriptor, &fileStatus) == -1)
+    {
+        Close();
+        throw MemoryMappedFileException();
+    }
+
+    mSize = static_cast<size_t>(fileStatus.st_size);
+
+    Map();
+}
+
+inline void MemoryMappedFile::Close()
+{
+    Unmap();
+
+    if (mFileDescriptor != -1)
+        close(mFileDescriptor);
+
+    mFileDescriptor = -1;
+    mSize = 0;
+}
+
+inline void MemoryMappedFile::Resize(size_t size)
+{
+    if (!IsOpen() || !Writable())
+        throw MemoryMappedFileException();
+
+    // truncate while still mapped: if it fails the old mapping is left untouched
+    if (ftruncate(mFileDescriptor, static_cast<off_t>(size)) == -1)
+        throw MemoryMappedFileException();
+
+    Unmap();
+    mSize = size;
+
+    Map();
+}
+
+inline void MemoryMappedFile::Sync()
+{
+    if (mData && Writable() && msync(mData, mSize, MS_SYNC) == -1)
+        throw MemoryMappedFileException();
+}
+
+inline void MemoryMappedFile::Map()
+{
+    if (mSize == 0)   // empty files cannot be mapped
+        return;
+
+    int protection = mMode == Mode::READ_ONLY ? PROT_READ : PROT_READ | PROT_WRITE;
+    void *address = mmap(nullptr, mSize, protection, MAP_SHARED, mFileDescriptor, 0);
+
+    if (address == MAP_FAILED)   // close rather than keep a size without a mapping
+    {
+        mData = nullptr;
+        Close();
+        throw MemoryMappedFileException();
+    }
+
+    mData = static_cast<char*>(address);
+}
+
+inline void MemoryMappedFile::Unmap()
+{
+    if (mData)
+        munmap(mData, mSize);
+
+    mData = nullptr;
+}
+
+#endif  // MEMORY_MAPPED_FILE_H
@@ -0,0 +1,42 @@
+#include "mmap_vector.hpp"
+#include <iostream>
+
+struct Record
+{
+    int mId;
+    float mValue;
+};
+
+int main(int argc, char **argv)
+{
+    const char *path = argc > 1 ? argv[1] : "records.bin";
+
+    {
+        MmapVector<Record> records(path, MmapVector<Record>::Mode::READ_WRITE);
+
+        std::cout << "records from previous runs: " << records.Size() << std::endl;
+
+        int firstId = records.Size();
+        for (int i = 0; i < 5; i++)
+            records.InsertLast(Record{firstId + i, i * 0.5f});
+
+        records.RemoveIf([](const Record &record) { return record.mId % 7 == 6; });
+        records.Sync();
+    }
+
+    MmapVector<Record> records(path);   // read-only
+
+    for (const Record &record : records)
+        std::cout << record.mId << " " << record.mValue << std::endl;
+
+    try
+    {
+        MmapVector<int> ints(path, MmapVector<int>::Mode::READ_WRITE);
+    }
+    catch (MmapVectorException &)
+    {
+        std::cout << "not a vector of int" << std::endl;
+    }
+
+    return 0;
+}
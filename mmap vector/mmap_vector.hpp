@@ -0,0 +1,470 @@
+#ifndef MMAP_VECTOR_H
+#define MMAP_VECTOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include "../memory_mapped_file.hpp"
+#include "../vector/vector.hpp"
+
+using std::size_t;
+
+class MmapVectorException : public std::exception {};   // not a vector file of this element type, or write on a read-only vector
+
+/**** vector of trivially copyable elements stored in a memory mapped file: the elements persist across runs (reopening
+      is instant, pages are loaded lazily on first access, so the vector can be larger than memory) ****/
+// file layout: a 64 byte header (magic, element size, element count) followed by the elements, the file size is the
+// capacity. growth extends the file (ftruncate) and remaps it, which invalidates pointers and iterators as a Vector
+// reallocation does. writes reach the file when the kernel flushes the pages, Sync forces it (the element count lives
+// in the header, so a synced file always reopens consistent)
+template <typename T>
+class MmapVector
+{
+    static_assert(std::is_trivially_copyable<T>::value, "elements are written to the file as raw bytes");
+    static_assert(alignof(T) <= 64, "elements are aligned on the header size");
+
+public:
+    typedef T *Iterator;             // random access iterator
+    typedef const T *ConstIterator;  // implicit conversion from Iterator to ConstIterator
+    typedef MemoryMappedFile::Mode Mode;
+
+public:
+    MmapVector() {}
+    MmapVector(const char *path, Mode mode = Mode::READ_ONLY) { Open(path, mode); }
+    MmapVector(const MmapVector &other) = delete;
+    MmapVector(MmapVector &&other) = default;
+
+    MmapVector &operator=(const MmapVector &other) = delete;
+    MmapVector &operator=(MmapVector &&other) = default;
+
+    void Open(const char *path, Mode mode = Mode::READ_ONLY);   // read-write mode creates the file if it does not exist
+    void Close() { mFile.Close(); }
+    void Sync() { mFile.Sync(); }                               // flush the elements and the header to the file (msync)
+
+    bool IsOpen() const { return mFile.IsOpen(); }
+    bool Writable() const { return mFile.Writable(); }
+
+    size_t Size() const { return mFile.Data() ? GetHeader().mNumElements : 0; }
+    size_t Capacity() const { return mFile.Size() > HEADER_SIZE ? (mFile.Size() - HEADER_SIZE) / sizeof(T) : 0; }
+    bool Empty() const { return Size() == 0; }
+
+    T *Data() { return const_cast<T*>(static_cast<const MmapVector&>(*this).Data()); }
+    const T *Data() const { return mFile.Data() ? reinterpret_cast<const T*>(mFile.Data() + HEADER_SIZE) : nullptr; }
+
+    void Resize(size_t size, const T &element = T());
+    void Reserve(size_t size);   // grow the file
+    void ShrinkToFit();          // truncate the file to the elements
+    void Clear();                // remove the elements and truncate the file
+
+    Iterator Begin() { return Data(); }
+    ConstIterator Begin() const { return Data(); }
+    ConstIterator CBegin() const { return Begin(); }
+    Iterator End() { return Data() + Size(); }   // return past the end pointer
+    ConstIterator End() const { return Data() + Size(); }
+    ConstIterator CEnd() const { return End(); }
+
+    template <typename U>
+    void Insert(int index, U &&element) { Emplace(index, std::forward<U>(element)); }
+    template <typename U>
+    void InsertFirst(U &&element) { Emplace(0, std::forward<U>(element)); }
+    template <typename U>
+    void InsertLast(U &&element) { Emplace(static_cast<int>(Size()), std::forward<U>(element)); }
+    template <typename U>
+    Iterator Insert(Iterator pos, U &&element) { return Emplace(pos, std::forward<U>(element)); }   // return iterator after inserted element
+    template <typename Iter>
+    Iterator Insert(Iterator pos, Iter begin, Iter end);    // insert iterator range before pos and return iterator after last inserted element
+    template <typename Iter>
+    void Append(Iter begin, Iter end) { Insert(End(), begin, end); }
+    void Append(const T *elements, size_t count) { Insert(End(), elements, elements + count); }
+
+    template <typename... Args>
+    void Emplace(int index, Args&&... args);
+    template <typename... Args>
+    void EmplaceFirst(Args&&... args) { Emplace(0, std::forward<Args>(args)...); }
+    template <typename... Args>
+    void EmplaceLast(Args&&... args) { Emplace(static_cast<int>(Size()), std::forward<Args>(args)...); }
+    template <typename... Args>
+    Iterator Emplace(Iterator pos, Args&&... args);   // return iterator after emplaced element
+
+    void Remove(int index);
+    void RemoveFirst() { Remove(0); }
+    void RemoveLast() { Remove(static_cast<int>(Size()) - 1); }
+    Iterator Remove(Iterator pos) { return Remove(pos, pos + 1); }
+    Iterator Remove(Iterator begin, Iterator end);   // return iterator to the element that followed the removed range
+    template <typename P>
+    size_t RemoveIf(const P &predicate);             // remove the elements satisfying predicate (order kept), return their number
+
+    T &operator[](int index) { return Data()[index]; }
+    const T &operator[](int index) const { return Data()[index]; }
+    T &First() { return Data()[0]; }
+    const T &First() const { return Data()[0]; }
+    T &Last() { return Data()[Size() - 1]; }
+    const T &Last() const { return Data()[Size() - 1]; }
+
+    Iterator AtIndex(size_t index) { return Data() + index; }
+    ConstIterator AtIndex(size_t index) const { return Data() + index; }
+    int IndexOf(ConstIterator iterator) const { return iterator - Data(); }
+
+    // linear searches, vectorized for arithmetic types (see simd_search.hpp)
+    Iterator Find(const T &key) { return const_cast<Iterator>(static_cast<const MmapVector&>(*this).Find(key)); }
+    ConstIterator Find(const T &key) const;
+    // same predicate contract as Vector::FindIf: blocks of 64 elements past the match for arithmetic T
+    template <typename P>
+    Iterator FindIf(const P &predicate) { return const_cast<Iterator>(static_cast<const MmapVector&>(*this).FindIf(predicate)); }
+    template <typename P>
+    ConstIterator FindIf(const P &predicate) const;
+    bool Contains(const T &key) const { return Find(key) != End(); }
+    size_t Count(const T &key) const;
+    template <typename P>
+    size_t CountIf(const P &predicate) const;
+    Vector<size_t> FindAll(const T &key) const;   // indices of all the elements equal to key
+
+private:
+    static constexpr std::uint64_t MAGIC = 0x524f544345564d4dULL;   // "MMVECTOR"
+    static constexpr size_t HEADER_SIZE = 64;
+
+    struct Header
+    {
+        std::uint64_t mMagic;
+        std::uint64_t mElementSize;
+        std::uint64_t mNumElements;
+    };
+
+    MemoryMappedFile mFile;
+
+    Header &GetHeader() { return *reinterpret_cast<Header*>(mFile.Data()); }
+    const Header &GetHeader() const { return *reinterpret_cast<const Header*>(mFile.Data()); }
+
+    void CheckWritable() const;
+    void SetSize(size_t size) { GetHeader().mNumElements = size; }
+    void Grow(size_t size);   // capacity for size elements, geometric
+    T *OpenGap(size_t index, size_t count);   // move the elements from index count places up, return the gap
+};
+
+// begin and end functions (to use in range-for loop)
+template <typename T>
+typename MmapVector<T>::Iterator begin(MmapVector<T> &vector)
+{
+    return vector.Begin();
+}
+
+template <typename T>
+typename MmapVector<T>::Iterator end(MmapVector<T> &vector)
+{
+    return vector.End();
+}
+
+template <typename T>
+typename MmapVector<T>::ConstIterator begin(const MmapVector<T> &vector)
+{
+    return vector.Begin();
+}
+
+template <typename T>
+typename MmapVector<T>::ConstIterator end(const MmapVector<T> &vector)
+{
+    return vector.End();
+}
+
+template <typename T>
+void MmapVector<T>::Open(const char *path, Mode mode)
+{
+    mFile.Open(path, mode);
+
+    if (mFile.Size() == 0 && mFile.Writable())   // new file
+    {
+        mFile.Resize(HEADER_SIZE);
+
+        GetHeader().mMagic = MAGIC;
+        GetHeader().mElementSize = sizeof(T);
+        GetHeader().mNumElements = 0;
+    }
+
+    if (mFile.Size() < HEADER_SIZE || GetHeader().mMagic != MAGIC || GetHeader().mElementSize != sizeof(T) || GetHeader().mNumElements > Capacity())
+    {
+        mFile.Close();
+        throw MmapVectorException();
+    }
+}
+
+template <typename T>
+void MmapVector<T>::CheckWritable() const
+{
+    if (!mFile.IsOpen() || !mFile.Writable())
+        throw MmapVectorException();
+}
+
+template <typename T>
+void MmapVector<T>::Reserve(size_t size)
+{
+    CheckWritable();
+
+    if (size > Capacity())
+        mFile.Resize(HEADER_SIZE + size * sizeof(T));
+}
+
+template <typename T>
+void MmapVector<T>::Grow(size_t size)
+{
+    if (size > Capacity())
+        Reserve(std::max(size, 2 * Capacity()));   // every remap costs a system call, keep them logarithmic
+}
+
+template <typename T>
+void MmapVector<T>::ShrinkToFit()
+{
+    CheckWritable();
+
+    mFile.Resize(HEADER_SIZE + Size() * sizeof(T));
+}
+
+template <typename T>
+void MmapVector<T>::Clear()
+{
+    CheckWritable();
+
+    SetSize(0);
+    ShrinkToFit();
+}
+
+template <typename T>
+void MmapVector<T>::Resize(size_t size, const T &element)
+{
+    CheckWritable();
+
+    T copy(element);   // element may be in the mapping
+
+    Grow(size);
+
+    for (size_t i = Size(); i < size; i++)
+        Data()[i] = copy;
+
+    SetSize(size);
+}
+
+template <typename T>
+T *MmapVector<T>::OpenGap(size_t index, size_t count)
+{
+    size_t size = Size();
+
+    Grow(size + count);
+
+    T *gap = Data() + index;
+    std::memmove(static_cast<void*>(gap + count), static_cast<const void*>(gap), (size - index) * sizeof(T));
+    SetSize(size + count);
+
+    return gap;
+}
+
+// the element is built before the file grows (args may refer to an element of the mapping)
+template <typename T>
+template <typename... Args>
+typename MmapVector<T>::Iterator MmapVector<T>::Emplace(Iterator pos, Args&&... args)
+{
+    CheckWritable();
+
+    size_t index = pos - Data();
+
+    if (index > Size())
+        throw IndexOutOfBoundsException();
+
+    T element = [&args...]()
+    {
+        if constexpr (std::is_constructible<T, Args&&...>::value)
+            return T(std::forward<Args>(args)...);
+        else
+            return T{std::forward<Args>(args)...};   // aggregate
+    }();
+
+    *OpenGap(index, 1) = element;
+
+    return Data() + index + 1;
+}
+
+template <typename T>
+template <typename... Args>
+void MmapVector<T>::Emplace(int index, Args&&... args)
+{
+    if (index < 0 || static_cast<size_t>(index) > Size())
+        throw IndexOutOfBoundsException();
+
+    Emplace(Data() + index, std::forward<Args>(args)...);
+}
+
+// forward ranges are copied aside when they point into the mapping (the remap would move them), input ranges are
+// appended one by one then rotated into place
+template <typename T>
+template <typename Iter>
+typename MmapVector<T>::Iterator MmapVector<T>::Insert(Iterator pos, Iter begin, Iter end)
+{
+    CheckWritable();
+
+    size_t index = pos - Data();
+    size_t size = Size();
+
+    if (index > size)
+        throw IndexOutOfBoundsException();
+
+    if constexpr (IsForwardIterator<Iter>::value)
+    {
+        if constexpr (std::is_pointer<Iter>::value)
+        {
+            if (begin != end && static_cast<const void*>(&*begin) >= mFile.Data() && static_cast<const void*>(&*begin) < mFile.Data() + mFile.Size())
+            {
+                Vector<T> copy;
+                copy.Append(begin, end);
+
+                return Insert(Data() + index, copy.Begin(), copy.End());
+            }
+        }
+
+        size_t count = std::distance(begin, end);
+        T *gap = OpenGap(index, count);
+
+        std::copy(begin, end, gap);
+
+        return Data() + index + count;
+    }
+    else
+    {
+        for (; begin != end; ++begin)
+        {
+            T element(*begin);
+
+            Grow(Size() + 1);
+            Data()[Size()] = element;
+            SetSize(Size() + 1);
+        }
+
+        std::rotate(Data() + index, Data() + size, Data() + Size());
+
+        return Data() + index + (Size() - size);
+    }
+}
+
+template <typename T>
+void MmapVector<T>::Remove(int index)
+{
+    if (index < 0 || static_cast<size_t>(index) >= Size())
+        throw IndexOutOfBoundsException();
+
+    Remove(Data() + index, Data() + index + 1);
+}
+
+template <typename T>
+typename MmapVector<T>::Iterator MmapVector<T>::Remove(Iterator begin, Iterator end)
+{
+    CheckWritable();
+
+    if (begin < Data() || begin > end || end > End())
+        throw IndexOutOfBoundsException();
+
+    std::memmove(static_cast<void*>(begin), static_cast<const void*>(end), (End() - end) * sizeof(T));
+    SetSize(Size() - (end - begin));
+
+    return begin;
+}
+
+template <typename T>
+template <typename P>
+size_t MmapVector<T>::RemoveIf(const P &predicate)
+{
+    CheckWritable();
+
+    T *elements = Data();
+    size_t size = Size(), numKept = 0;
+
+    for (size_t i = 0; i < size; i++)
+        if (!predicate(elements[i]))
+            elements[numKept++] = elements[i];
+
+    SetSize(numKept);
+
+    return size - numKept;
+}
+
+template <typename T>
+typename MmapVector<T>::ConstIterator MmapVector<T>::Find(const T &key) const
+{
+    if constexpr (SimdSearchable<T>::value)
+        return Data() + SimdFind(Data(), Size(), key);
+
+    for (const T *element = Begin(); element != End(); ++element)
+        if (key == *element)
+            return element;
+
+    return End();
+}
+
+template <typename T>
+template <typename P>
+typename MmapVector<T>::ConstIterator MmapVector<T>::FindIf(const P &predicate) const
+{
+    if constexpr (std::is_arithmetic<T>::value)
+        return Data() + BlockFindIf(Data(), Size(), predicate);
+
+    for (const T *element = Begin(); element != End(); ++element)
+        if (predicate(*element))
+            return element;
+
+    return End();
+}
+
+template <typename T>
+size_t MmapVector<T>::Count(const T &key) const
+{
+    if constexpr (SimdSearchable<T>::value)
+        return SimdCount(Data(), Size(), key);
+
+    size_t count = 0;
+
+    for (const T *element = Begin(); element != End(); ++element)
+        if (key == *element)
+            count++;
+
+    return count;
+}
+
+template <typename T>
+template <typename P>
+size_t MmapVector<T>::CountIf(const P &predicate) const
+{
+    if constexpr (std::is_arithmetic<T>::value)
+        return BlockCountIf(Data(), Size(), predicate);
+
+    size_t count = 0;
+
+    for (const T *element = Begin(); element != End(); ++element)
+        if (predicate(*element))
+            count++;
+
+    return count;
+}
+
+template <typename T>
+Vector<size_t> MmapVector<T>::FindAll(const T &key) const
+{
+    Vector<size_t> indices;
+
+    if constexpr (SimdSearchable<T>::value)
+    {
+        indices.Resize(Count(key));
+        SimdFindAll(Data(), Size(), key, indices.Data());
+    }
+    else
+    {
+        for (size_t i = 0; i < Size(); i++)
+            if (key == Data()[i])
+                indices.InsertLast(i);
+    }
+
+    return indices;
+}
+
+#endif  // MMAP_VECTOR_H
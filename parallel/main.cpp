@@ -0,0 +1,30 @@
+#include "parallel_algorithms.hpp"
+#include <iostream>
+
+int main()
+{
+    std::cout << "threads: " << ThreadPool::Shared().NumThreads() << std::endl;
+
+    Vector<int> values;
+    for (int i = 0; i < 1000000; i++)
+        values.InsertLast(i * 7919L % 1000);
+
+    std::cout << "sum: " << ParallelReduce(values, 0L) << std::endl;
+    std::cout << "max: " << ParallelReduce(values, 0, [](int a, int b) { return a > b ? a : b; }) << std::endl;
+
+    Vector<long> prefix;
+    prefix.Resize(values.Size());
+    ParallelInclusiveScan(values.Data(), values.Size(), prefix.Data());
+    std::cout << "prefix sums: " << prefix[0] << " " << prefix[1] << " " << prefix[2] << " ... " << prefix.Last() << std::endl;
+
+    ParallelForEach(values, [](int &value) { value *= 2; });
+
+    size_t numSmall = ParallelPartition(values, [](int value) { return value < 100; });
+    std::cout << "below 100: " << numSmall << std::endl;
+
+    ParallelSort(values);
+    ParallelUnique(values);
+    std::cout << "distinct: " << values.Size() << " first: " << values.First() << " last: " << values.Last() << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,412 @@
+#ifndef PARALLEL_ALGORITHMS_H
+#define PARALLEL_ALGORITHMS_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <utility>
+
+#include "../vector/vector.hpp"
+#include "parallel_for.hpp"
+
+using std::size_t;
+
+/**** parallel algorithms over contiguous ranges (Vector::Data(), Size()) on the shared work stealing pool, every
+      algorithm takes a grain size: the number of elements below which a task is not worth scheduling ****/
+// results do not depend on the number of threads nor on the scheduling: reductions and scans work on fixed blocks of
+// grainSize elements combined in index order (same grain, same rounding of a floating point sum on any machine),
+// partitions and unique are stable, Sort orders equal elements the same way for a given grain
+
+constexpr size_t PARALLEL_GRAIN_SIZE = 4096;
+constexpr size_t PARALLEL_SORT_GRAIN_SIZE = 16384;
+
+// f(element) for every element
+template <typename T, typename F>
+void ParallelForEach(T *data, size_t size, const F &f, size_t grainSize = PARALLEL_GRAIN_SIZE)
+{
+    ParallelFor(0, size, [data, &f](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; i++)
+            f(data[i]);
+    }, grainSize);
+}
+
+// output[i] = f(input[i]), output may be input
+template <typename T, typename U, typename F>
+void ParallelTransform(const T *input, size_t size, U *output, const F &f, size_t grainSize = PARALLEL_GRAIN_SIZE)
+{
+    ParallelFor(0, size, [input, output, &f](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; i++)
+            output[i] = f(input[i]);
+    }, grainSize);
+}
+
+// op(init, x0, x1, ...) with op associative: every block of grainSize elements is reduced left to right, then the block
+// results left to right starting from init
+template <typename T, typename R, typename Op = std::plus<>>
+R ParallelReduce(const T *data, size_t size, R init, const Op &op = Op(), size_t grainSize = PARALLEL_GRAIN_SIZE)
+{
+    if (grainSize == 0)
+        grainSize = 1;
+
+    size_t numBlocks = (size + grainSize - 1) / grainSize;
+
+    Vector<R> partials;
+    partials.Resize(numBlocks, init);
+
+    ParallelFor(0, numBlocks, [data, size, grainSize, &op, &partials](size_t blockBegin, size_t blockEnd)
+    {
+        for (size_t block = blockBegin; block < blockEnd; block++)
+        {
+            size_t begin = block * grainSize, end = std::min(begin + grainSize, size);
+            R partial = data[begin];
+
+            for (size_t i = begin + 1; i < end; i++)
+                partial = op(partial, data[i]);
+
+            partials[block] = std::move(partial);
+        }
+    });
+
+    for (size_t block = 0; block < numBlocks; block++)
+        init = op(std::move(init), partials[block]);
+
+    return init;
+}
+
+// output[i] = op(x0, ..., xi), output may be input. two passes over fixed blocks: block totals in parallel, their
+// running totals sequentially (one per block), then every block rescanned from its carry in parallel
+template <typename T, typename U, typename Op = std::plus<>>
+void ParallelInclusiveScan(const T *input, size_t size, U *output, const Op &op = Op(), size_t grainSize = PARALLEL_GRAIN_SIZE)
+{
+    if (size == 0)
+        return;
+
+    if (grainSize == 0)
+        grainSize = 1;
+
+    size_t numBlocks = (size + grainSize - 1) / grainSize;
+
+    Vector<U> carries;   // total of the blocks before every block (the first one has none)
+    carries.Reserve(numBlocks);
+
+    {
+        Vector<U> totals;
+        totals.Resize(numBlocks, U(input[0]));
+
+        if (numBlocks > 1)
+        {
+            ParallelFor(0, numBlocks - 1, [input, grainSize, &op, &totals](size_t blockBegin, size_t blockEnd)
+            {
+                for (size_t block = blockBegin; block < blockEnd; block++)
+                {
+                    size_t begin = block * grainSize;
+                    U total = input[begin];
+
+                    for (size_t i = begin + 1; i < begin + grainSize; i++)
+                        total = op(total, input[i]);
+
+                    totals[block] = std::move(total);
+                }
+            });
+        }
+
+        carries.InsertLast(totals[0]);   // unused
+
+        for (size_t block = 1; block < numBlocks; block++)
+            carries.InsertLast(block == 1 ? totals[0] : op(carries[block - 1], totals[block - 1]));
+    }
+
+    ParallelFor(0, numBlocks, [input, size, output, grainSize, &op, &carries](size_t blockBegin, size_t blockEnd)
+    {
+        for (size_t block = blockBegin; block < blockEnd; block++)
+        {
+            size_t begin = block * grainSize, end = std::min(begin + grainSize, size);
+            U running = block == 0 ? U(input[begin]) : op(carries[block], input[begin]);
+            output[begin] = running;
+
+            for (size_t i = begin + 1; i < end; i++)
+            {
+                running = op(running, input[i]);
+                output[i] = running;
+            }
+        }
+    });
+}
+
+// output[i] = op(init, x0, ..., xi-1), output may be input, returns the total op(init, x0, ..., xn-1)
+template <typename T, typename U, typename Op = std::plus<>>
+U ParallelExclusiveScan(const T *input, size_t size, U *output, U init, const Op &op = Op(), size_t grainSize = PARALLEL_GRAIN_SIZE)
+{
+    if (grainSize == 0)
+        grainSize = 1;
+
+    size_t numBlocks = (size + grainSize - 1) / grainSize;
+
+    Vector<U> carries;   // op(init, elements of the blocks before)
+    carries.Resize(numBlocks, init);
+
+    ParallelFor(0, numBlocks, [input, size, grainSize, &op, &carries](size_t blockBegin, size_t blockEnd)
+    {
+        for (size_t block = blockBegin; block < blockEnd; block++)
+        {
+            size_t begin = block * grainSize, end = std::min(begin + grainSize, size);
+            U total = input[begin];
+
+            for (size_t i = begin + 1; i < end; i++)
+                total = op(total, input[i]);
+
+            carries[block] = std::move(total);   // block total for now
+        }
+    });
+
+    for (size_t block = 0; block < numBlocks; block++)
+    {
+        U total = std::move(carries[block]);
+        carries[block] = init;
+        init = op(init, total);
+    }
+
+    ParallelFor(0, numBlocks, [input, size, output, grainSize, &op, &carries](size_t blockBegin, size_t blockEnd)
+    {
+        for (size_t block = blockBegin; block < blockEnd; block++)
+        {
+            size_t begin = block * grainSize, end = std::min(begin + grainSize, size);
+            U running = carries[block];
+
+            for (size_t i = begin; i < end; i++)
+            {
+                U next = op(running, input[i]);   // read before the write when in place
+                output[i] = std::move(running);
+                running = std::move(next);
+            }
+        }
+    });
+
+    return init;
+}
+
+// stable partition driven by a predicate of the index: selected(i) is evaluated for every index before any element moves
+// (so it may look at the neighbours), the selected elements go first and keep their order, then the others in order.
+// returns the number of selected elements. the elements are moved to a buffer at their final position then moved back
+template <typename T, typename S>
+size_t ParallelPartitionByIndex(T *data, size_t size, const S &selected, size_t grainSize = PARALLEL_GRAIN_SIZE)
+{
+    if (size == 0)
+        return 0;
+
+    if (grainSize == 0)
+        grainSize = 1;
+
+    size_t numBlocks = (size + grainSize - 1) / grainSize;
+
+    Vector<bool> flags;
+    flags.Resize(size);
+    Vector<size_t> offsets;   // selected elements before every block
+    offsets.Resize(numBlocks + 1, 0);
+
+    ParallelFor(0, numBlocks, [size, grainSize, &selected, &flags, &offsets](size_t blockBegin, size_t blockEnd)
+    {
+        for (size_t block = blockBegin; block < blockEnd; block++)
+        {
+            size_t begin = block * grainSize, end = std::min(begin + grainSize, size), count = 0;
+
+            for (size_t i = begin; i < end; i++)
+            {
+                flags[i] = selected(i);
+                count += flags[i];
+            }
+
+            offsets[block + 1] = count;
+        }
+    });
+
+    for (size_t block = 0; block < numBlocks; block++)
+        offsets[block + 1] += offsets[block];
+
+    size_t numSelected = offsets[numBlocks];
+    T *buffer = static_cast<T*>(DefaultAllocation::Allocate(size * sizeof(T), alignof(T)));
+
+    ParallelFor(0, numBlocks, [data, size, buffer, grainSize, numSelected, &flags, &offsets](size_t blockBegin, size_t blockEnd)
+    {
+        for (size_t block = blockBegin; block < blockEnd; block++)
+        {
+            size_t begin = block * grainSize, end = std::min(begin + grainSize, size);
+            size_t selectedPosition = offsets[block];
+            size_t otherPosition = numSelected + begin - offsets[block];
+
+            for (size_t i = begin; i < end; i++)
+                new(&buffer[flags[i] ? selectedPosition++ : otherPosition++]) T(std::move(data[i]));
+        }
+    });
+
+    ParallelFor(0, size, [data, buffer](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; i++)
+        {
+            data[i] = std::move(buffer[i]);
+            buffer[i].~T();
+        }
+    }, grainSize);
+
+    DefaultAllocation::Deallocate(buffer, size * sizeof(T), alignof(T));
+
+    return numSelected;
+}
+
+// elements satisfying predicate first, both groups in their original order, returns the number satisfying predicate
+template <typename T, typename P>
+size_t ParallelPartition(T *data, size_t size, const P &predicate, size_t grainSize = PARALLEL_GRAIN_SIZE)
+{
+    return ParallelPartitionByIndex(data, size, [data, &predicate](size_t i) { return static_cast<bool>(predicate(data[i])); }, grainSize);
+}
+
+// keep the first element of every run of equal consecutive elements at the front (in order), returns their number, the
+// elements after it are the removed duplicates (as std::unique, but still valid values)
+template <typename T>
+size_t ParallelUnique(T *data, size_t size, size_t grainSize = PARALLEL_GRAIN_SIZE)
+{
+    return ParallelPartitionByIndex(data, size, [data](size_t i) { return i == 0 || !(data[i] == data[i - 1]); }, grainSize);
+}
+
+// number of elements of a that come before the element q of the merge of a and b (equal elements: those of a first)
+template <typename T, typename C>
+size_t MergePathSplit(const T *a, size_t sizeA, const T *b, size_t sizeB, size_t q, const C &compare)
+{
+    size_t low = q > sizeB ? q - sizeB : 0, high = q < sizeA ? q : sizeA;
+
+    while (low < high)
+    {
+        size_t middle = low + (high - low) / 2;
+
+        if (compare(b[q - middle - 1], a[middle]))
+            high = middle;
+        else
+            low = middle + 1;
+    }
+
+    return low;
+}
+
+// blocks of grainSize elements (rounded up to a power of two) are sorted in parallel, then merged pairwise level after
+// level between the array and a buffer. a level is cut in pieces of one block of output, each piece finds its two input
+// ranges by binary search (merge path), so every level runs in parallel up to the last merge. a single thread runs the
+// same blocks and merges: equal elements do not end in a different order on a machine with fewer cores
+template <typename T, typename C = std::less<>>
+void ParallelSort(T *data, size_t size, const C &compare = C(), size_t grainSize = PARALLEL_SORT_GRAIN_SIZE)
+{
+    size_t blockSize = 1;
+    while (blockSize < grainSize)
+        blockSize *= 2;
+
+    if (size <= blockSize)
+    {
+        std::sort(data, data + size, compare);
+        return;
+    }
+
+    size_t numBlocks = (size + blockSize - 1) / blockSize;
+    T *buffer = static_cast<T*>(DefaultAllocation::Allocate(size * sizeof(T), alignof(T)));
+
+    // sorted blocks land in the buffer, which holds constructed elements from then on
+    ParallelFor(0, numBlocks, [data, size, buffer, blockSize, &compare](size_t blockBegin, size_t blockEnd)
+    {
+        for (size_t block = blockBegin; block < blockEnd; block++)
+        {
+            size_t begin = block * blockSize, end = std::min(begin + blockSize, size);
+
+            for (size_t i = begin; i < end; i++)
+                new(&buffer[i]) T(std::move(data[i]));
+
+            std::sort(buffer + begin, buffer + end, compare);
+        }
+    });
+
+    T *source = buffer, *destination = data;
+    Vector<size_t> splits;   // elements of the first run of its pair before the output of every piece
+    splits.Resize(numBlocks);
+
+    for (size_t width = blockSize; width < size; width *= 2)
+    {
+        // all the splits are searched before any element is moved out of the source
+        ParallelFor(0, numBlocks, [source, size, width, blockSize, &compare, &splits](size_t pieceBegin, size_t pieceEnd)
+        {
+            for (size_t piece = pieceBegin; piece < pieceEnd; piece++)
+            {
+                size_t begin = piece * blockSize, low = begin / (2 * width) * (2 * width);
+                size_t middle = std::min(low + width, size), high = std::min(low + 2 * width, size);
+
+                splits[piece] = MergePathSplit(source + low, middle - low, source + middle, high - middle, begin - low, compare);
+            }
+        });
+
+        ParallelFor(0, numBlocks, [source, destination, size, width, blockSize, &compare, &splits](size_t pieceBegin, size_t pieceEnd)
+        {
+            for (size_t piece = pieceBegin; piece < pieceEnd; piece++)
+            {
+                size_t begin = piece * blockSize, end = std::min(begin + blockSize, size);
+                size_t low = begin / (2 * width) * (2 * width);
+                size_t middle = std::min(low + width, size), high = std::min(low + 2 * width, size);
+
+                size_t a0 = splits[piece], a1 = end == high ? middle - low : splits[piece + 1];   // the last piece ends its pair
+
+                std::merge(std::make_move_iterator(source + low + a0), std::make_move_iterator(source + low + a1),
+                           std::make_move_iterator(source + middle + (begin - low - a0)), std::make_move_iterator(source + middle + (end - low - a1)),
+                           destination + begin, compare);
+            }
+        });
+
+        std::swap(source, destination);
+    }
+
+    ParallelFor(0, size, [data, source, buffer](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; i++)
+        {
+            if (source == buffer)
+                data[i] = std::move(buffer[i]);
+
+            buffer[i].~T();
+        }
+    }, blockSize);
+
+    DefaultAllocation::Deallocate(buffer, size * sizeof(T), alignof(T));
+}
+
+// Vector overloads
+template <typename T, typename A, typename F>
+void ParallelForEach(Vector<T, A> &vector, const F &f, size_t grainSize = PARALLEL_GRAIN_SIZE)
+{
+    ParallelForEach(vector.Data(), vector.Size(), f, grainSize);
+}
+
+template <typename T, typename A, typename R, typename Op = std::plus<>>
+R ParallelReduce(const Vector<T, A> &vector, R init, const Op &op = Op(), size_t grainSize = PARALLEL_GRAIN_SIZE)
+{
+    return ParallelReduce(vector.Data(), vector.Size(), std::move(init), op, grainSize);
+}
+
+template <typename T, typename A, typename P>
+size_t ParallelPartition(Vector<T, A> &vector, const P &predicate, size_t grainSize = PARALLEL_GRAIN_SIZE)
+{
+    return ParallelPartition(vector.Data(), vector.Size(), predicate, grainSize);
+}
+
+template <typename T, typename A>
+void ParallelUnique(Vector<T, A> &vector, size_t grainSize = PARALLEL_GRAIN_SIZE)   // removes the duplicates
+{
+    size_t size = ParallelUnique(vector.Data(), vector.Size(), grainSize);
+
+    vector.Remove(vector.Begin() + size, vector.End());
+}
+
+template <typename T, typename A, typename C = std::less<>>
+void ParallelSort(Vector<T, A> &vector, const C &compare = C(), size_t grainSize = PARALLEL_SORT_GRAIN_SIZE)
+{
+    ParallelSort(vector.Data(), vector.Size(), compare, grainSize);
+}
+
+#endif  // PARALLEL_ALGORITHMS_H
@@ -0,0 +1,29 @@
+#ifndef PARALLEL_FOR_H
+#define PARALLEL_FOR_H
+
+#include <cstddef>
+
+#include "thread_pool.hpp"
+
+using std::size_t;
+
+// split [begin, end) in chunks of at least grainSize iterations and call f(chunkBegin, chunkEnd) for each chunk on the
+// shared work stealing pool (the calling thread takes part), returns when all chunks are done. the grain is raised so a
+// thread gets at most CHUNKS_PER_THREAD chunks: enough to balance uneven chunks, few enough to keep scheduling cheap
+template <typename F>
+void ParallelFor(size_t begin, size_t end, const F &f, size_t grainSize = 1)
+{
+    static const size_t CHUNKS_PER_THREAD = 8;
+
+    if (begin >= end)
+        return;
+
+    ThreadPool &pool = ThreadPool::Shared();
+
+    size_t maxChunks = pool.NumThreads() * CHUNKS_PER_THREAD;
+    size_t minGrainSize = (end - begin + maxChunks - 1) / maxChunks;
+
+    pool.Run(begin, end, grainSize > minGrainSize ? grainSize : minGrainSize, f);
+}
+
+#endif  // PARALLEL_FOR_H
@@ -0,0 +1,303 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+#include "../vector/vector.hpp"
+
+using std::size_t;
+
+// number of threads used by the parallel kernels (at least 1)
+inline unsigned int HardwareConcurrency()
+{
+    unsigned int numThreads = std::thread::hardware_concurrency();
+
+    return numThreads ? numThreads : 1U;
+}
+
+/**** work stealing thread pool for fork-join loops: Run(begin, end, grainSize, f) calls f(chunkBegin, chunkEnd) over
+      [begin, end) and returns when every chunk is done ****/
+// a range is halved until it is shorter than 2 * grainSize, the splitting thread keeps the lower half and pushes the
+// upper one on its own queue, idle threads steal the oldest (largest) range of another queue. the thread calling Run
+// works on the loop (and on whatever it can steal) until the loop is done, so a Run nested in a chunk cannot deadlock
+class ThreadPool
+{
+public:
+    explicit ThreadPool(unsigned int numWorkers);
+    ThreadPool(const ThreadPool &other) = delete;
+    ThreadPool &operator=(const ThreadPool &other) = delete;
+    ~ThreadPool();
+
+    static ThreadPool &Shared();   // HardwareConcurrency() - 1 workers, the thread calling Run being the last one
+
+    unsigned int NumThreads() const { return mWorkers.Size() + 1; }   // workers and the calling thread
+
+    // the first exception thrown by a chunk is rethrown once the other chunks are done
+    template <typename F>
+    void Run(size_t begin, size_t end, size_t grainSize, const F &f);
+
+private:
+    struct Loop   // one Run call
+    {
+        void (*mBody)(const void *function, size_t begin, size_t end);
+        const void *mFunction;
+        size_t mGrainSize;
+        std::atomic<size_t> mNumRemaining;   // iterations not done yet
+        std::mutex mExceptionMutex;
+        std::exception_ptr mException;
+    };
+
+    struct Range
+    {
+        Loop *mLoop;
+        size_t mBegin;
+        size_t mEnd;
+    };
+
+    class RangeQueue   // the owner pushes and pops at the back, thieves take the front
+    {
+    public:
+        void Push(const Range &range);
+        bool PopBack(Range &range);
+        bool PopFront(Range &range);
+
+    private:
+        std::mutex mMutex;
+        Vector<Range> mRanges;
+        size_t mHead = 0;
+    };
+
+    struct ThreadIdentity
+    {
+        const ThreadPool *mPool = nullptr;
+        unsigned int mQueueIndex = 0;
+    };
+
+    Vector<std::thread> mWorkers;
+    Vector<RangeQueue> mQueues;   // one per worker, the last one shared by the threads outside of the pool
+
+    std::atomic<size_t> mNumQueued;     // ranges waiting in the queues
+    std::atomic<unsigned int> mNumSleeping;
+    std::mutex mSleepMutex;
+    std::condition_variable mWakeUp;
+    bool mStop;
+
+    static ThreadIdentity &CurrentThread();
+    unsigned int QueueIndex() const { return CurrentThread().mPool == this ? CurrentThread().mQueueIndex : mWorkers.Size(); }
+
+    void WorkerLoop(unsigned int queueIndex);
+    void Push(unsigned int queueIndex, const Range &range);
+    bool TryTake(unsigned int queueIndex, Range &range);
+    void Execute(unsigned int queueIndex, Range range);
+};
+
+inline void ThreadPool::RangeQueue::Push(const Range &range)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    mRanges.InsertLast(range);
+}
+
+inline bool ThreadPool::RangeQueue::PopBack(Range &range)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    if (mHead == mRanges.Size())
+        return false;
+
+    range = mRanges.Last();
+    mRanges.RemoveLast();
+
+    if (mHead == mRanges.Size())
+    {
+        mRanges.Resize(0);
+        mHead = 0;
+    }
+
+    return true;
+}
+
+inline bool ThreadPool::RangeQueue::PopFront(Range &range)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    if (mHead == mRanges.Size())
+        return false;
+
+    range = mRanges[mHead++];
+
+    if (mHead == mRanges.Size())
+    {
+        mRanges.Resize(0);
+        mHead = 0;
+    }
+
+    return true;
+}
+
+inline ThreadPool::ThreadPool(unsigned int numWorkers) : mQueues(numWorkers + 1), mNumQueued(0), mNumSleeping(0), mStop(false)
+{
+    mWorkers.Reserve(numWorkers);
+
+    for (unsigned int i = 0; i < numWorkers; i++)
+        mWorkers.InsertLast(std::thread([this, i]() { WorkerLoop(i); }));
+}
+
+inline ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mSleepMutex);
+        mStop = true;
+    }
+
+    mWakeUp.notify_all();
+
+    for (std::thread &worker : mWorkers)
+        worker.join();
+}
+
+inline ThreadPool &ThreadPool::Shared()
+{
+    static ThreadPool pool(HardwareConcurrency() - 1);
+
+    return pool;
+}
+
+inline ThreadPool::ThreadIdentity &ThreadPool::CurrentThread()
+{
+    static thread_local ThreadIdentity identity;
+
+    return identity;
+}
+
+inline void ThreadPool::WorkerLoop(unsigned int queueIndex)
+{
+    CurrentThread().mPool = this;
+    CurrentThread().mQueueIndex = queueIndex;
+
+    while (true)
+    {
+        Range range;
+
+        if (TryTake(queueIndex, range))
+        {
+            Execute(queueIndex, range);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(mSleepMutex);
+
+        mNumSleeping++;
+        mWakeUp.wait(lock, [this]() { return mStop || mNumQueued.load() > 0; });
+        mNumSleeping--;
+
+        if (mStop)
+            return;
+    }
+}
+
+// a pusher either sees the sleeper counted or the sleeper sees the new range (both counters are sequentially consistent),
+// the mutex is only taken when someone sleeps
+inline void ThreadPool::Push(unsigned int queueIndex, const Range &range)
+{
+    mQueues[queueIndex].Push(range);
+    mNumQueued++;
+
+    if (mNumSleeping.load() > 0)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mSleepMutex);
+        }
+
+        mWakeUp.notify_one();
+    }
+}
+
+inline bool ThreadPool::TryTake(unsigned int queueIndex, Range &range)
+{
+    unsigned int numQueues = mQueues.Size();
+
+    bool found = mQueues[queueIndex].PopBack(range);
+
+    for (unsigned int i = 1; !found && i < numQueues; i++)
+        found = mQueues[(queueIndex + i) % numQueues].PopFront(range);
+
+    if (found)
+        mNumQueued--;
+
+    return found;
+}
+
+// the loop may be gone as soon as its last iterations are counted, nothing touches it afterwards
+inline void ThreadPool::Execute(unsigned int queueIndex, Range range)
+{
+    Loop &loop = *range.mLoop;
+
+    while (range.mEnd - range.mBegin >= 2 * loop.mGrainSize)
+    {
+        size_t middle = range.mBegin + (range.mEnd - range.mBegin) / 2;
+
+        Push(queueIndex, Range{&loop, middle, range.mEnd});
+        range.mEnd = middle;
+    }
+
+    try
+    {
+        loop.mBody(loop.mFunction, range.mBegin, range.mEnd);
+    }
+    catch (...)
+    {
+        std::lock_guard<std::mutex> lock(loop.mExceptionMutex);
+
+        if (!loop.mException)
+            loop.mException = std::current_exception();
+    }
+
+    loop.mNumRemaining.fetch_sub(range.mEnd - range.mBegin);
+}
+
+template <typename F>
+void ThreadPool::Run(size_t begin, size_t end, size_t grainSize, const F &f)
+{
+    if (begin >= end)
+        return;
+
+    if (grainSize == 0)
+        grainSize = 1;
+
+    if (mWorkers.Empty() || end - begin < 2 * grainSize)   // not worth scheduling
+    {
+        f(begin, end);
+        return;
+    }
+
+    Loop loop;
+    loop.mBody = [](const void *function, size_t chunkBegin, size_t chunkEnd) { (*static_cast<const F*>(function))(chunkBegin, chunkEnd); };
+    loop.mFunction = &f;
+    loop.mGrainSize = grainSize;
+    loop.mNumRemaining = end - begin;
+
+    unsigned int queueIndex = QueueIndex();
+
+    Execute(queueIndex, Range{&loop, begin, end});
+
+    while (loop.mNumRemaining.load() > 0)
+    {
+        Range range;
+
+        if (TryTake(queueIndex, range))
+            Execute(queueIndex, range);
+        else
+            std::this_thread::yield();
+    }
+
+    if (loop.mException)
+        std::rethrow_exception(loop.mException);
+}
+
+#endif  // THREAD_POOL_H
@@ -0,0 +1,57 @@
+#include "persistent_vector.hpp"
+#include <iostream>
+#include <string>
+#include <thread>
+
+int main()
+{
+    PersistentVector<int> log;
+
+    for (int i = 0; i < 100; i++)
+        log.InsertLast(i);
+
+    PersistentVector<int> snapshot = log.Snapshot();   // O(1)
+
+    log.Set(0, -1);
+    log.Update(1, [](int &element) { element *= 100; });
+    log.InsertLast(100);
+
+    std::cout << "log: " << log.Size() << " elements, first " << log[0] << " " << log[1] << " last " << log.Last() << std::endl;
+    std::cout << "snapshot: " << snapshot.Size() << " elements, first " << snapshot[0] << " " << snapshot[1] << " last " << snapshot.Last() << std::endl;
+
+    // a reader sums a snapshot while the writer keeps appending to its own vector
+    PersistentVector<long> values;
+    for (long i = 0; i < 100000; i++)
+        values.InsertLast(i);
+
+    long sum = 0;
+    std::thread reader([snapshot = values.Snapshot(), &sum]()
+    {
+        for (long value : snapshot)
+            sum += value;
+    });
+
+    for (long i = 0; i < 100000; i++)   // after the first edit of each path the writer works in place again
+        values.InsertLast(i);
+
+    reader.join();
+
+    std::cout << "reader sum: " << sum << ", writer size: " << values.Size() << ", depth: " << values.Depth() << std::endl;
+
+    PersistentVector<std::string> words{"persistent", "vector", "of", "strings"};
+    PersistentVector<std::string> before = words;
+
+    words.RemoveLast();
+    words.Set(2, "with");
+    words.InsertLast("snapshots");
+
+    for (const std::string &word : before)
+        std::cout << word << " ";
+    std::cout << std::endl;
+
+    for (const std::string &word : words)
+        std::cout << word << " ";
+    std::cout << std::endl;
+
+    return 0;
+}
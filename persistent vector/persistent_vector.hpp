@@ -0,0 +1,529 @@
+#ifndef PERSISTENT_VECTOR_H
+#define PERSISTENT_VECTOR_H
+
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <utility>
+
+#include "../vector/vector.hpp"   // IndexOutOfBoundsException
+
+using std::size_t;
+
+template <typename T>
+class PersistentVector;
+
+template <typename T>
+void swap(PersistentVector<T> &a, PersistentVector<T> &b)
+{
+    a.Swap(b);
+}
+
+/**** persistent vector: 32 way trie of leaves of 32 elements plus a tail leaf holding the last 1 to 32 elements
+      (Clojure's vector). copying is O(1) (the copy shares every node, a snapshot), element i is found in
+      log32(n) steps (7 for 2^32 elements) and updates copy the O(log32 n) nodes of the path they change ****/
+// the nodes are reference counted: a node used by one vector only is edited in place, so between two snapshots a
+// vector is transient (edits after a snapshot copy each shared node once, the following ones reuse the copies) and
+// InsertLast is O(1) amortized: it fills the tail in place and pushes a full tail into the trie once every 32 elements.
+// the counts are atomic: a snapshot taken by the writer (or under its lock) can be read and destroyed by other threads
+// while the writer goes on editing its own vector
+template <typename T>
+class PersistentVector
+{
+public:
+    static constexpr unsigned int BITS = 5;
+    static constexpr size_t BRANCHING = size_t(1) << BITS;
+    static constexpr size_t MASK = BRANCHING - 1;
+
+    class ConstIterator;
+
+public:
+    PersistentVector() : mRoot(nullptr), mTail(nullptr), mNumElements(0), mShift(BITS) {}
+    PersistentVector(const PersistentVector &other);   // O(1), shares the nodes
+    PersistentVector(PersistentVector &&other);
+    PersistentVector(std::initializer_list<T> initList);
+
+    ~PersistentVector() { Clear(); }
+
+    PersistentVector &operator=(const PersistentVector &other);
+    PersistentVector &operator=(PersistentVector &&other);
+
+    void Swap(PersistentVector &other);
+
+    PersistentVector Snapshot() const { return *this; }   // O(1), later edits of either vector do not show in the other
+
+    size_t Size() const { return mNumElements; }
+    bool Empty() const { return mNumElements == 0; }
+    size_t Depth() const { return mRoot ? mShift / BITS + 1 : 0; }   // levels of the trie
+
+    void Clear();
+
+    ConstIterator Begin() const { return ConstIterator(this, 0); }
+    ConstIterator CBegin() const { return Begin(); }
+    ConstIterator End() const { return ConstIterator(this, mNumElements); }   // return past the end iterator
+    ConstIterator CEnd() const { return End(); }
+
+    // elements are read only: writes go through Set and Update, which copy the shared nodes first
+    const T &operator[](size_t index) const { return LeafFor(index)->Elements()[index & MASK]; }
+    const T &First() const { return (*this)[0]; }
+    const T &Last() const { return mTail->Elements()[mTail->mNumElements - 1]; }
+
+    template <typename U>
+    void Set(size_t index, U &&element) { EditableElement(index) = std::forward<U>(element); }
+    template <typename F>
+    void Update(size_t index, const F &f) { f(EditableElement(index)); }   // f(T &element)
+
+    template <typename U>
+    void InsertLast(U &&element) { EmplaceLast(std::forward<U>(element)); }
+    template <typename... Args>
+    void EmplaceLast(Args&&... args);
+    template <typename Iter>
+    void Append(Iter begin, Iter end);
+
+    void RemoveLast();
+
+private:
+    struct Node
+    {
+        std::atomic<unsigned int> mReferences{1};
+    };
+
+    struct Branch : Node
+    {
+        Node *mChildren[BRANCHING] = {};
+    };
+
+    struct Leaf : Node
+    {
+        size_t mNumElements = 0;
+        alignas(T) unsigned char mStorage[BRANCHING * sizeof(T)];
+
+        T *Elements() { return reinterpret_cast<T*>(mStorage); }
+        const T *Elements() const { return reinterpret_cast<const T*>(mStorage); }
+    };
+
+    Branch *mRoot;          // leaves at level 0, mRoot at level mShift (null while the tail holds everything)
+    Leaf *mTail;            // null when empty
+    size_t mNumElements;
+    unsigned int mShift;
+
+    size_t TailOffset() const { return mNumElements < BRANCHING ? 0 : ((mNumElements - 1) >> BITS) << BITS; }
+
+    const Leaf *LeafFor(size_t index) const;
+    T &EditableElement(size_t index);
+
+    static void Retain(Node *node) { node->mReferences.fetch_add(1, std::memory_order_relaxed); }
+    static void Release(Node *node, unsigned int level);
+    static Leaf *CopyLeaf(const Leaf *leaf);
+    static Node *Editable(Node *node, unsigned int level);   // node itself if not shared, else a copy (node released)
+
+    static Node *NewPath(unsigned int level, Leaf *leaf);
+    Node *PushTail(unsigned int level, Branch *parent, Leaf *leaf);
+    Node *PopTail(unsigned int level, Branch *node);
+};
+
+// random access, reads through a pointer to the current leaf (the trie is only walked when crossing to another leaf).
+// valid as long as the vector is not edited, an iterator over a snapshot stays valid while the writer goes on
+template <typename T>
+class PersistentVector<T>::ConstIterator
+{
+public:
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const T *pointer;
+    typedef const T &reference;
+
+public:
+    ConstIterator() : mVector(nullptr), mIndex(0), mLeaf(nullptr) {}
+
+    reference operator*() const { return mLeaf[mIndex & MASK]; }
+    pointer operator->() const { return &**this; }
+    reference operator[](difference_type n) const { return *(*this + n); }
+
+    ConstIterator &operator++() { mIndex++; if ((mIndex & MASK) == 0) Seek(); return *this; }
+    ConstIterator operator++(int) { ConstIterator it = *this; ++*this; return it; }
+    ConstIterator &operator--() { mIndex--; if ((mIndex & MASK) == MASK || !mLeaf) Seek(); return *this; }
+    ConstIterator operator--(int) { ConstIterator it = *this; --*this; return it; }
+
+    ConstIterator &operator+=(difference_type n) { mIndex += n; Seek(); return *this; }
+    ConstIterator &operator-=(difference_type n) { mIndex -= n; Seek(); return *this; }
+    ConstIterator operator+(difference_type n) const { return ConstIterator(mVector, mIndex + n); }
+    ConstIterator operator-(difference_type n) const { return ConstIterator(mVector, mIndex - n); }
+    friend ConstIterator operator+(difference_type n, const ConstIterator &it) { return it + n; }
+    difference_type operator-(const ConstIterator &other) const { return difference_type(mIndex) - difference_type(other.mIndex); }
+
+    bool operator==(const ConstIterator &other) const { return mIndex == other.mIndex; }
+    bool operator!=(const ConstIterator &other) const { return mIndex != other.mIndex; }
+    bool operator<(const ConstIterator &other) const { return mIndex < other.mIndex; }
+    bool operator>(const ConstIterator &other) const { return mIndex > other.mIndex; }
+    bool operator<=(const ConstIterator &other) const { return mIndex <= other.mIndex; }
+    bool operator>=(const ConstIterator &other) const { return mIndex >= other.mIndex; }
+
+    size_t Index() const { return mIndex; }
+
+private:
+    friend class PersistentVector;
+
+    ConstIterator(const PersistentVector *vector, size_t index) : mVector(vector), mIndex(index) { Seek(); }
+
+    void Seek() { mLeaf = mIndex < mVector->mNumElements ? mVector->LeafFor(mIndex)->Elements() : nullptr; }
+
+    const PersistentVector *mVector;
+    size_t mIndex;
+    const T *mLeaf;   // elements of the leaf holding mIndex, null past the end
+};
+
+// begin and end functions (to use in range-for loop)
+template <typename T>
+typename PersistentVector<T>::ConstIterator begin(const PersistentVector<T> &vector)
+{
+    return vector.Begin();
+}
+
+template <typename T>
+typename PersistentVector<T>::ConstIterator end(const PersistentVector<T> &vector)
+{
+    return vector.End();
+}
+
+template <typename T>
+PersistentVector<T>::PersistentVector(const PersistentVector &other)
+    : mRoot(other.mRoot), mTail(other.mTail), mNumElements(other.mNumElements), mShift(other.mShift)
+{
+    if (mRoot)
+        Retain(mRoot);
+
+    if (mTail)
+        Retain(mTail);
+}
+
+template <typename T>
+PersistentVector<T>::PersistentVector(PersistentVector &&other)
+    : mRoot(other.mRoot), mTail(other.mTail), mNumElements(other.mNumElements), mShift(other.mShift)
+{
+    other.mRoot = nullptr;
+    other.mTail = nullptr;
+    other.mNumElements = 0;
+    other.mShift = BITS;
+}
+
+template <typename T>
+PersistentVector<T>::PersistentVector(std::initializer_list<T> initList) : PersistentVector()
+{
+    Append(initList.begin(), initList.end());
+}
+
+template <typename T>
+PersistentVector<T> &PersistentVector<T>::operator=(const PersistentVector &other)
+{
+    PersistentVector temp = other;
+    Swap(temp);
+
+    return *this;
+}
+
+template <typename T>
+PersistentVector<T> &PersistentVector<T>::operator=(PersistentVector &&other)
+{
+    PersistentVector temp = std::move(other);
+    Swap(temp);
+
+    return *this;
+}
+
+template <typename T>
+void PersistentVector<T>::Swap(PersistentVector &other)
+{
+    std::swap(mRoot, other.mRoot);
+    std::swap(mTail, other.mTail);
+    std::swap(mNumElements, other.mNumElements);
+    std::swap(mShift, other.mShift);
+}
+
+template <typename T>
+void PersistentVector<T>::Clear()
+{
+    if (mRoot)
+        Release(mRoot, mShift);
+
+    if (mTail)
+        Release(mTail, 0);
+
+    mRoot = nullptr;
+    mTail = nullptr;
+    mNumElements = 0;
+    mShift = BITS;
+}
+
+template <typename T>
+const typename PersistentVector<T>::Leaf *PersistentVector<T>::LeafFor(size_t index) const
+{
+    if (index >= TailOffset())
+        return mTail;
+
+    const Node *node = mRoot;
+
+    for (unsigned int level = mShift; level > 0; level -= BITS)
+        node = static_cast<const Branch*>(node)->mChildren[(index >> level) & MASK];
+
+    return static_cast<const Leaf*>(node);
+}
+
+// the last reference destroys the node and releases its children (a leaf destroys its elements)
+template <typename T>
+void PersistentVector<T>::Release(Node *node, unsigned int level)
+{
+    if (node->mReferences.fetch_sub(1, std::memory_order_acq_rel) != 1)
+        return;
+
+    if (level == 0)
+    {
+        Leaf *leaf = static_cast<Leaf*>(node);
+
+        for (size_t i = 0; i < leaf->mNumElements; i++)
+            leaf->Elements()[i].~T();
+
+        delete leaf;
+    }
+    else
+    {
+        Branch *branch = static_cast<Branch*>(node);
+
+        for (size_t i = 0; i < BRANCHING && branch->mChildren[i]; i++)   // children fill a branch from the left
+            Release(branch->mChildren[i], level - BITS);
+
+        delete branch;
+    }
+}
+
+template <typename T>
+typename PersistentVector<T>::Leaf *PersistentVector<T>::CopyLeaf(const Leaf *leaf)
+{
+    Leaf *copy = new Leaf;
+
+    try
+    {
+        for (; copy->mNumElements < leaf->mNumElements; copy->mNumElements++)
+            new(&copy->Elements()[copy->mNumElements]) T(leaf->Elements()[copy->mNumElements]);
+    }
+    catch (...)
+    {
+        Release(copy, 0);
+        throw;
+    }
+
+    return copy;
+}
+
+// the acquire load pairs with the release decrement of the last other owner: its reads of the node are done
+template <typename T>
+typename PersistentVector<T>::Node *PersistentVector<T>::Editable(Node *node, unsigned int level)
+{
+    if (node->mReferences.load(std::memory_order_acquire) == 1)
+        return node;
+
+    Node *copy;
+
+    if (level == 0)
+        copy = CopyLeaf(static_cast<Leaf*>(node));
+    else
+    {
+        Branch *branch = new Branch;
+
+        for (size_t i = 0; i < BRANCHING; i++)
+            if ((branch->mChildren[i] = static_cast<Branch*>(node)->mChildren[i]))
+                Retain(branch->mChildren[i]);
+
+        copy = branch;
+    }
+
+    Release(node, level);
+
+    return copy;
+}
+
+template <typename T>
+T &PersistentVector<T>::EditableElement(size_t index)
+{
+    if (index >= mNumElements)
+        throw IndexOutOfBoundsException();
+
+    if (index >= TailOffset())
+    {
+        mTail = static_cast<Leaf*>(Editable(mTail, 0));
+        return mTail->Elements()[index & MASK];
+    }
+
+    mRoot = static_cast<Branch*>(Editable(mRoot, mShift));
+    Node *node = mRoot;
+
+    for (unsigned int level = mShift; level > 0; level -= BITS)
+    {
+        Node *&child = static_cast<Branch*>(node)->mChildren[(index >> level) & MASK];
+        child = Editable(child, level - BITS);
+        node = child;
+    }
+
+    return static_cast<Leaf*>(node)->Elements()[index & MASK];
+}
+
+// a chain of branches from level down to leaf
+template <typename T>
+typename PersistentVector<T>::Node *PersistentVector<T>::NewPath(unsigned int level, Leaf *leaf)
+{
+    if (level == 0)
+        return leaf;
+
+    Branch *branch = new Branch;
+    branch->mChildren[0] = NewPath(level - BITS, leaf);
+
+    return branch;
+}
+
+// hang the full tail (elements [mNumElements - 32, mNumElements)) under parent, an editable branch at level
+template <typename T>
+typename PersistentVector<T>::Node *PersistentVector<T>::PushTail(unsigned int level, Branch *parent, Leaf *leaf)
+{
+    Node *&child = parent->mChildren[((mNumElements - 1) >> level) & MASK];
+
+    if (level == BITS)
+        child = leaf;
+    else if (child)
+        child = PushTail(level - BITS, static_cast<Branch*>(Editable(child, level - BITS)), leaf);
+    else
+        child = NewPath(level - BITS, leaf);
+
+    return parent;
+}
+
+template <typename T>
+template <typename... Args>
+void PersistentVector<T>::EmplaceLast(Args&&... args)
+{
+    if (mTail && mTail->mNumElements < BRANCHING)
+    {
+        mTail = static_cast<Leaf*>(Editable(mTail, 0));
+        new(&mTail->Elements()[mTail->mNumElements]) T(std::forward<Args>(args)...);
+        mTail->mNumElements++;
+        mNumElements++;
+
+        return;
+    }
+
+    // new tail, built before the old one moves into the trie (nothing changes if the element throws)
+    Leaf *leaf = new Leaf;
+
+    try
+    {
+        new(&leaf->Elements()[0]) T(std::forward<Args>(args)...);
+        leaf->mNumElements = 1;
+    }
+    catch (...)
+    {
+        delete leaf;
+        throw;
+    }
+
+    if (mTail)
+    {
+        if (!mRoot)
+        {
+            mRoot = new Branch;
+            mRoot->mChildren[0] = mTail;
+        }
+        else if ((mNumElements >> BITS) > (size_t(1) << mShift))   // the trie is full: one more level
+        {
+            Branch *root = new Branch;
+            root->mChildren[0] = mRoot;
+            root->mChildren[1] = NewPath(mShift, mTail);
+            mRoot = root;
+            mShift += BITS;
+        }
+        else
+            mRoot = static_cast<Branch*>(PushTail(mShift, static_cast<Branch*>(Editable(mRoot, mShift)), mTail));
+    }
+
+    mTail = leaf;
+    mNumElements++;
+}
+
+template <typename T>
+template <typename Iter>
+void PersistentVector<T>::Append(Iter begin, Iter end)
+{
+    for (; begin != end; ++begin)
+        EmplaceLast(*begin);
+}
+
+// remove the leaf of the elements [mNumElements - 33, mNumElements - 1) from under node, an editable branch at level,
+// return null when node is left empty (it is released)
+template <typename T>
+typename PersistentVector<T>::Node *PersistentVector<T>::PopTail(unsigned int level, Branch *node)
+{
+    size_t childIndex = ((mNumElements - 2) >> level) & MASK;
+    Node *&child = node->mChildren[childIndex];
+
+    if (level > BITS)
+        child = PopTail(level - BITS, static_cast<Branch*>(Editable(child, level - BITS)));
+    else
+    {
+        Release(child, 0);
+        child = nullptr;
+    }
+
+    if (!child && childIndex == 0)
+    {
+        Release(node, level);
+        return nullptr;
+    }
+
+    return node;
+}
+
+template <typename T>
+void PersistentVector<T>::RemoveLast()
+{
+    if (mNumElements == 0)
+        throw IndexOutOfBoundsException();
+
+    if (mNumElements == 1)
+    {
+        Clear();
+        return;
+    }
+
+    if (mTail->mNumElements > 1)
+    {
+        mTail = static_cast<Leaf*>(Editable(mTail, 0));
+        mTail->Elements()[--mTail->mNumElements].~T();
+        mNumElements--;
+
+        return;
+    }
+
+    // the last leaf of the trie becomes the tail
+    Leaf *leaf = const_cast<Leaf*>(LeafFor(mNumElements - 2));
+    Retain(leaf);
+    Release(mTail, 0);
+    mTail = leaf;
+
+    mRoot = static_cast<Branch*>(PopTail(mShift, static_cast<Branch*>(Editable(mRoot, mShift))));
+    mNumElements--;
+
+    if (!mRoot)
+        mShift = BITS;
+
+    if (mRoot && mShift > BITS && !mRoot->mChildren[1])   // one child left: drop a level
+    {
+        Branch *root = static_cast<Branch*>(mRoot->mChildren[0]);
+        Retain(root);
+        Release(mRoot, mShift);
+        mRoot = root;
+        mShift -= BITS;
+    }
+}
+
+#endif  // PERSISTENT_VECTOR_H
@@ -6,8 +6,8 @@
 #define PRINT(s)     std::cout << (s)
 #define PRINTLN(s)   PRINT(s) << std::endl
 
-template <typename T, template <typename> class S>
-void PrintSequence(const S<T> &sequence)
+template <typename T, template <typename...> class S, typename... Rest>
+void PrintSequence(const S<T, Rest...> &sequence)
 {
     for (int i = 0; i < sequence.Size(); i++)
     {
@@ -17,10 +17,10 @@ void PrintSequence(const S<T> &sequence)
     PRINTLN("");
 }
 
-template <typename T, template <typename> class S>
-void ITPrintSequence(const S<T> &sequence)
+template <typename T, template <typename...> class S, typename... Rest>
+void ITPrintSequence(const S<T, Rest...> &sequence)
 {
-    typename S<T>::ConstIterator it = sequence.Begin();
+    typename S<T, Rest...>::ConstIterator it = sequence.Begin();
 
     while (it != sequence.End())
     {
@@ -0,0 +1,37 @@
+#include "segmented_vector.hpp"
+#include <iostream>
+#include <string>
+
+int main(int argc, char **argv)
+{
+    SegmentedVector<int, 2> v{1, 2, 3};   // chunks of 4 elements
+
+    const int *first = &v[0];
+
+    for (int i = 4; i <= 10; i++)
+        v.InsertLast(i);
+
+    std::cout << "size: " << v.Size() << " capacity: " << v.Capacity() << " chunks: " << v.NumChunks() << std::endl;
+    std::cout << "first element did not move: " << (first == &v[0]) << std::endl;
+
+    v.Insert(0, 0);
+    v.Remove(5);
+    v.RemoveIf([](int element) { return element % 3 == 0; });
+
+    for (int element : v)
+        std::cout << element << " ";
+    std::cout << std::endl;
+
+    std::cout << "index of 7: " << v.IndexOf(v.Find(7)) << " contains 9: " << v.Contains(9) << std::endl;
+
+    SegmentedVector<std::string> s;
+    s.EmplaceLast(3, 'a');
+    s.EmplaceFirst("first");
+    s.Insert(s.Begin() + 1, std::string("middle"));
+
+    for (SegmentedVector<std::string>::ConstIterator it = s.CBegin(); it != s.CEnd(); ++it)
+        std::cout << *it << " ";
+    std::cout << std::endl;
+
+    return 0;
+}
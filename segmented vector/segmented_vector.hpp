@@ -0,0 +1,605 @@
+#ifndef SEGMENTED_VECTOR_H
+#define SEGMENTED_VECTOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <utility>
+#include <initializer_list>
+#include <type_traits>
+
+#include "../vector/vector.hpp"
+
+using std::size_t;
+
+// largest power of two number of elements fitting a 16 KB chunk (at least one element)
+template <typename T>
+constexpr unsigned int DefaultChunkShift()
+{
+    unsigned int shift = 0;
+
+    while ((sizeof(T) << (shift + 1)) <= 16384)
+        shift++;
+
+    return shift;
+}
+
+template <typename T, unsigned int CHUNK_SHIFT>
+class SegmentedVector;
+
+template <typename T, unsigned int CHUNK_SHIFT>
+void swap(SegmentedVector<T, CHUNK_SHIFT> &a, SegmentedVector<T, CHUNK_SHIFT> &b)
+{
+    a.Swap(b);
+}
+
+/**** vector made of fixed size chunks of 2^CHUNK_SHIFT elements: growing allocates one more chunk and never moves the
+      elements (no reallocation spike, pointers and references stay valid until the element is removed or shifted by an
+      insertion / removal before it), element i is at mChunks[i >> CHUNK_SHIFT][i & CHUNK_MASK] ****/
+// only the table of chunk pointers is reallocated (one pointer per chunk), removed elements leave their chunks allocated
+// until Clear. elements are contiguous within a chunk, not across chunks (ForEachChunk gives the contiguous blocks)
+template <typename T, unsigned int CHUNK_SHIFT = DefaultChunkShift<T>()>
+class SegmentedVector
+{
+public:
+    static constexpr size_t CHUNK_SIZE = size_t(1) << CHUNK_SHIFT;
+    static constexpr size_t CHUNK_MASK = CHUNK_SIZE - 1;
+
+private:
+    template <bool CONST>
+    class IteratorBase;
+
+public:
+    typedef IteratorBase<false> Iterator;     // random access iterator
+    typedef IteratorBase<true> ConstIterator; // implicit conversion from Iterator to ConstIterator
+
+public:
+    SegmentedVector() : mNumElements(0U) {}
+    SegmentedVector(size_t size);
+    SegmentedVector(const SegmentedVector &other);
+    SegmentedVector(SegmentedVector &&other);
+    SegmentedVector(std::initializer_list<T> initList);    // sequence ctor
+
+    ~SegmentedVector() { Clear(); }
+
+    SegmentedVector &operator=(const SegmentedVector &other);
+    SegmentedVector &operator=(SegmentedVector &&other);
+
+    void Swap(SegmentedVector &other);
+
+    size_t Size() const { return mNumElements; }
+    size_t Capacity() const { return mChunks.Size() << CHUNK_SHIFT; }
+    bool Empty() const { return mNumElements == 0; }
+
+    size_t NumChunks() const { return mChunks.Size(); }
+    T *Chunk(size_t chunkIndex) { return mChunks[chunkIndex]; }
+    const T *Chunk(size_t chunkIndex) const { return mChunks[chunkIndex]; }
+    template <typename F>
+    void ForEachChunk(const F &f) const;   // f(const T *elements, size_t count) for every non empty chunk, in order
+
+    void Resize(size_t size, const T &element = T());
+    void Reserve(size_t size);   // allocate chunks up front, never moves the elements
+    void Clear();                // destroy the elements and release the chunks
+
+    Iterator Begin() { return Iterator(mChunks.Data(), 0); }
+    ConstIterator Begin() const { return ConstIterator(mChunks.Data(), 0); }
+    ConstIterator CBegin() const { return Begin(); }
+    Iterator End() { return Iterator(mChunks.Data(), mNumElements); }   // return past the end iterator
+    ConstIterator End() const { return ConstIterator(mChunks.Data(), mNumElements); }
+    ConstIterator CEnd() const { return End(); }
+
+    template <typename U>
+    void Insert(int index, U &&element) { Emplace(index, std::forward<U>(element)); }
+    template <typename U>
+    void InsertFirst(U &&element) { Emplace(0, std::forward<U>(element)); }
+    template <typename U>
+    void InsertLast(U &&element) { EmplaceLast(std::forward<U>(element)); }
+    template <typename U>
+    Iterator Insert(Iterator pos, U &&element) { return Emplace(pos, std::forward<U>(element)); }   // return iterator after inserted element
+    template <typename Iter>
+    Iterator Insert(Iterator pos, Iter begin, Iter end);   // insert iterator range before pos and return iterator after last inserted element
+    template <typename Iter>
+    void Append(Iter begin, Iter end);
+
+    template <typename... Args>
+    void Emplace(int index, Args&&... args);
+    template <typename... Args>
+    void EmplaceFirst(Args&&... args) { Emplace(0, std::forward<Args>(args)...); }
+    template <typename... Args>
+    T &EmplaceLast(Args&&... args);
+    template <typename... Args>
+    Iterator Emplace(Iterator pos, Args&&... args);   // return iterator after emplaced element
+
+    void Remove(int index) { Remove(Begin() + index); }
+    void RemoveFirst() { Remove(0); }
+    void RemoveLast();
+    Iterator Remove(Iterator pos) { return Remove(pos, pos + 1); }
+    Iterator Remove(Iterator begin, Iterator end);   // return iterator to the element that followed the removed range
+    template <typename P>
+    size_t RemoveIf(const P &predicate);             // remove the elements satisfying predicate (order kept), return their number
+
+    T &operator[](size_t index) { return mChunks[index >> CHUNK_SHIFT][index & CHUNK_MASK]; }
+    const T &operator[](size_t index) const { return mChunks[index >> CHUNK_SHIFT][index & CHUNK_MASK]; }
+    T &First() { return (*this)[0]; }
+    const T &First() const { return (*this)[0]; }
+    T &Last() { return (*this)[mNumElements - 1]; }
+    const T &Last() const { return (*this)[mNumElements - 1]; }
+
+    Iterator AtIndex(size_t index) { return Begin() + index; }
+    ConstIterator AtIndex(size_t index) const { return Begin() + index; }
+    int IndexOf(ConstIterator iterator) const { return iterator - Begin(); }
+
+    // linear search, chunk by chunk with the SIMD kernels of Vector for arithmetic types
+    Iterator Find(const T &key) { return Begin() + static_cast<const SegmentedVector&>(*this).FindIndex(key); }
+    ConstIterator Find(const T &key) const { return Begin() + FindIndex(key); }
+    // same predicate contract as Vector::FindIf (arithmetic T: evaluated past the match, within the chunk)
+    template <typename P>
+    Iterator FindIf(const P &predicate) { return Begin() + static_cast<const SegmentedVector&>(*this).FindIfIndex(predicate); }
+    template <typename P>
+    ConstIterator FindIf(const P &predicate) const { return Begin() + FindIfIndex(predicate); }
+    bool Contains(const T &key) const { return FindIndex(key) != mNumElements; }
+    size_t Count(const T &key) const;
+    template <typename P>
+    size_t CountIf(const P &predicate) const;
+
+private:
+    Vector<T*> mChunks;   // table of chunks, every chunk holds CHUNK_SIZE elements (constructed below mNumElements)
+    size_t mNumElements;
+
+    static T *AllocateChunk() { return static_cast<T*>(operator new(CHUNK_SIZE * sizeof(T), std::align_val_t(alignof(T)))); }
+    static void FreeChunk(T *chunk) { operator delete(chunk, std::align_val_t(alignof(T))); }
+
+    template <typename... Args>
+    static void Construct(T *address, Args&&... args);
+
+    T *AddressOf(size_t index) const { return mChunks[index >> CHUNK_SHIFT] + (index & CHUNK_MASK); }
+    void DestroyLast(size_t count);
+
+    size_t FindIndex(const T &key) const;
+    template <typename P>
+    size_t FindIfIndex(const P &predicate) const;
+};
+
+// the iterator is an index plus the chunk table, so it stays valid while chunks are added, except when the table itself
+// is reallocated (growth past the reserved number of chunks)
+template <typename T, unsigned int CHUNK_SHIFT>
+template <bool CONST>
+class SegmentedVector<T, CHUNK_SHIFT>::IteratorBase
+{
+public:
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef typename std::conditional<CONST, const T*, T*>::type pointer;
+    typedef typename std::conditional<CONST, const T&, T&>::type reference;
+
+public:
+    IteratorBase() : mChunks(nullptr), mIndex(0) {}
+    IteratorBase(T *const *chunks, size_t index) : mChunks(chunks), mIndex(index) {}
+
+    template <bool OTHER_CONST, typename = typename std::enable_if<CONST && !OTHER_CONST>::type>
+    IteratorBase(const IteratorBase<OTHER_CONST> &other) : mChunks(other.mChunks), mIndex(other.mIndex) {}
+
+    reference operator*() const { return mChunks[mIndex >> CHUNK_SHIFT][mIndex & CHUNK_MASK]; }
+    pointer operator->() const { return &**this; }
+    reference operator[](difference_type n) const { return *(*this + n); }
+
+    IteratorBase &operator++() { mIndex++; return *this; }
+    IteratorBase operator++(int) { IteratorBase it = *this; mIndex++; return it; }
+    IteratorBase &operator--() { mIndex--; return *this; }
+    IteratorBase operator--(int) { IteratorBase it = *this; mIndex--; return it; }
+
+    IteratorBase &operator+=(difference_type n) { mIndex += n; return *this; }
+    IteratorBase &operator-=(difference_type n) { mIndex -= n; return *this; }
+    IteratorBase operator+(difference_type n) const { return IteratorBase(mChunks, mIndex + n); }
+    IteratorBase operator-(difference_type n) const { return IteratorBase(mChunks, mIndex - n); }
+    friend IteratorBase operator+(difference_type n, const IteratorBase &it) { return it + n; }
+    difference_type operator-(const IteratorBase &other) const { return difference_type(mIndex) - difference_type(other.mIndex); }
+
+    bool operator==(const IteratorBase &other) const { return mIndex == other.mIndex; }
+    bool operator!=(const IteratorBase &other) const { return mIndex != other.mIndex; }
+    bool operator<(const IteratorBase &other) const { return mIndex < other.mIndex; }
+    bool operator>(const IteratorBase &other) const { return mIndex > other.mIndex; }
+    bool operator<=(const IteratorBase &other) const { return mIndex <= other.mIndex; }
+    bool operator>=(const IteratorBase &other) const { return mIndex >= other.mIndex; }
+
+    size_t Index() const { return mIndex; }
+
+private:
+    friend class SegmentedVector;
+    template <bool>
+    friend class IteratorBase;
+
+    T *const *mChunks;
+    size_t mIndex;
+};
+
+// begin and end functions (to use in range-for loop)
+template <typename T, unsigned int CHUNK_SHIFT>
+typename SegmentedVector<T, CHUNK_SHIFT>::Iterator begin(SegmentedVector<T, CHUNK_SHIFT> &vector)
+{
+    return vector.Begin();
+}
+
+template <typename T, unsigned int CHUNK_SHIFT>
+typename SegmentedVector<T, CHUNK_SHIFT>::Iterator end(SegmentedVector<T, CHUNK_SHIFT> &vector)
+{
+    return vector.End();
+}
+
+template <typename T, unsigned int CHUNK_SHIFT>
+typename SegmentedVector<T, CHUNK_SHIFT>::ConstIterator begin(const SegmentedVector<T, CHUNK_SHIFT> &vector)
+{
+    return vector.Begin();
+}
+
+template <typename T, unsigned int CHUNK_SHIFT>
+typename SegmentedVector<T, CHUNK_SHIFT>::ConstIterator end(const SegmentedVector<T, CHUNK_SHIFT> &vector)
+{
+    return vector.End();
+}
+
+template <typename T, unsigned int CHUNK_SHIFT>
+SegmentedVector<T, CHUNK_SHIFT>::SegmentedVector(size_t size) : mNumElements(0U)
+{
+    Reserve(size);
+
+    for (size_t i = 0; i < size; i++)
+        EmplaceLast();   // T default constructible
+}
+
+template <typename T, unsigned int CHUNK_SHIFT>
+SegmentedVector<T, CHUNK_SHIFT>::SegmentedVector(const SegmentedVector &other) : mNumElements(0U)
+{
+    Reserve(other.mNumElements);
+
+    other.ForEachChunk([this](const T *elements, size_t count)
+    {
+        for (size_t i = 0; i < count; i++)
+            EmplaceLast(elements[i]);
+    });
+}
+
+template <typename T, unsigned int CHUNK_SHIFT>
+SegmentedVector<T, CHUNK_SHIFT>::SegmentedVector(SegmentedVector &&other) : mChunks(std::move(other.mChunks)), mNumElements(other.mNumElements)
+{
+    other.mNumElements = 0;
+}
+
+template <typename T, unsigned int CHUNK_SHIFT>
+SegmentedVector<T, CHUNK_SHIFT>::SegmentedVector(std::initializer_list<T> initList) : mNumElements(0U)
+{
+    Append(initList.begin(), initList.end());
+}
+
+template <typename T, unsigned int CHUNK_SHIFT>
+SegmentedVector<T, CHUNK_SHIFT> &SegmentedVector<T, CHUNK_SHIFT>::operator=(const SegmentedVector &other)
+{
+    if (this != &other)
+    {
+        SegmentedVector copy(other);
+        Swap(copy);
+    }
+
+    return *this;
+}
+
+template <typename T, unsigned int CHUNK_SHIFT>
+SegmentedVector<T, CHUNK_SHIFT> &SegmentedVector<T, CHUNK_SHIFT>::operator=(SegmentedVector &&other)
+{
+    if (this != &other)
+    {
+        Clear();
+        Swap(other);
+    }
+
+    return *this;
+}
+
+template <typename T, unsigned int CHUNK_SHIFT>
+void SegmentedVector<T, CHUNK_SHIFT>::Swap(SegmentedVector &other)
+{
+    mChunks.Swap(other.mChunks);
+    std::swap(mNumElements, other.mNumElements);
+}
+
+template <typename T, unsigned int CHUNK_SHIFT>
+template <typename F>
+void SegmentedVector<T, CHUNK_SHIFT>::ForEachChunk(const F &f) const
+{
+    for (size_t first = 0; first < mNumElements; first += CHUNK_SIZE)
+        f(static_cast<const T*>(mChunks[first >> CHUNK_SHIFT]), std::min(CHUNK_SIZE, mNumElements - first));
+}
+
+template <typename T, unsigned int CHUNK_SHIFT>
+void SegmentedVector<T, CHUNK_SHIFT>::Resize(size_t size, const T &element)
+{
+    if (size < mNumElements)
+    {
+        DestroyLast(mNumElements - size);
+        return;
+    }
+
+    Reserve(size);
+
+    // no element moves, so element may be one of ours
+    while (mNumElements < size)
+        EmplaceLast(element);
+}
+
+template <typename T, unsigned int CHUNK_SHIFT>
+void SegmentedVector<T, CHUNK_SHIFT>::Reserve(size_t size)
+{
+    size_t numChunks = (size + CHUNK_MASK) >> CHUNK_SHIFT;
+
+    mChunks.Reserve(numChunks);
+
+    while (mChunks.Size() < numChunks)
+        mChunks.InsertLast(AllocateChunk());
+}
+
+template <typename T, unsigned int CHUNK_SHIFT>
+void SegmentedVector<T, CHUNK_SHIFT>::Clear()
+{
+    DestroyLast(mNumElements);
+
+    for (T *chunk : mChunks)
+        FreeChunk(chunk);
+
+    mChunks.Clear();
+}
+
+template <typename T, unsigned int CHUNK_SHIFT>
+template <typename... Args>
+void SegmentedVector<T, CHUNK_SHIFT>::Construct(T *address, Args&&... args)
+{
+    if constexpr (std::is_constructible<T, Args&&...>::value)
+        new(address) T(std::forward<Args>(args)...);
+    else
+        new(address) T{std::forward<Args>(args)...};   // aggregate
+}
+
+template <typename T, unsigned int CHUNK_SHIFT>
+void SegmentedVector<T, CHUNK_SHIFT>::DestroyLast(size_t count)
+{
+    for (; count > 0; count--)
+    {
+        mNumElements--;
+        AddressOf(mNumElements)->~T();
+    }
+}
+
+// the only place where chunks get allocated on the way: one chunk every CHUNK_SIZE insertions, the elements never move,
+// so args may refer to an element of this vector
+template <typename T, unsigned int CHUNK_SHIFT>
+template <typename... Args>
+T &SegmentedVector<T, CHUNK_SHIFT>::EmplaceLast(Args&&... args)
+{
+    if (mNumElements == Capacity())
+        mChunks.InsertLast(AllocateChunk());
+
+    T *address = AddressOf(mNumElements);
+    Construct(address, std::forward<Args>(args)...);
+    mNumElements++;
+
+    return *address;
+}
+
+template <typename T, unsigned int CHUNK_SHIFT>
+template <typename... Args>
+void SegmentedVector<T, CHUNK_SHIFT>::Emplace(int index, Args&&... args)
+{
+    if (index < 0 || static_cast<size_t>(index) > mNumElements)
+        throw IndexOutOfBoundsException();
+
+    Emplace(Begin() + index, std::forward<Args>(args)...);
+}
+
+// the new element is built first (args may refer to an element about to be shifted), then the elements from pos are
+// shifted one place up by move assignment, which is all it takes since no reallocation can happen
+template <typename T, unsigned int CHUNK_SHIFT>
+template <typename... Args>
+typename SegmentedVector<T, CHUNK_SHIFT>::Iterator SegmentedVector<T, CHUNK_SHIFT>::Emplace(Iterator pos, Args&&... args)
+{
+    size_t index = pos.mIndex;
+
+    if (index == mNumElements)
+    {
+        EmplaceLast(std::forward<Args>(args)...);
+        return End();
+    }
+
+    alignas(T) unsigned char storage[sizeof(T)];
+    T *element = reinterpret_cast<T*>(storage);
+    Construct(element, std::forward<Args>(args)...);
+
+    try
+    {
+        EmplaceLast(std::move(Last()));
+        std::move_backward(Begin() + index, End() - 2, End() - 1);
+        (*this)[index] = std::move(*element);
+    }
+    catch (...)
+    {
+        element->~T();
+        throw;
+    }
+
+    element->~T();
+
+    return Begin() + (index + 1);
+}
+
+// the range is appended then rotated in place, the elements never leave their chunks
+template <typename T, unsigned int CHUNK_SHIFT>
+template <typename Iter>
+typename SegmentedVector<T, CHUNK_SHIFT>::Iterator SegmentedVector<T, CHUNK_SHIFT>::Insert(Iterator pos, Iter begin, Iter end)
+{
+    size_t index = pos.mIndex;
+    size_t oldSize = mNumElements;
+
+    Append(begin, end);
+    std::rotate(Begin() + index, Begin() + oldSize, End());
+
+    return Begin() + (index + (mNumElements - oldSize));
+}
+
+template <typename T, unsigned int CHUNK_SHIFT>
+template <typename Iter>
+void SegmentedVector<T, CHUNK_SHIFT>::Append(Iter begin, Iter end)
+{
+    // a range of this vector: Reserve can reallocate the chunk table the iterators point to, the indices stay valid
+    // (and so do the elements, chunks never move)
+    if constexpr (std::is_same<Iter, Iterator>::value || std::is_same<Iter, ConstIterator>::value)
+    {
+        if (begin.mChunks == mChunks.Data() && begin != end)
+        {
+            size_t first = begin.mIndex, last = end.mIndex;
+
+            Reserve(mNumElements + (last - first));
+
+            for (size_t i = first; i < last; i++)
+                EmplaceLast((*this)[i]);
+
+            return;
+        }
+    }
+
+    if constexpr (IsForwardIterator<Iter>::value)
+        Reserve(mNumElements + std::distance(begin, end));
+
+    for (; begin != end; ++begin)
+        EmplaceLast(*begin);
+}
+
+template <typename T, unsigned int CHUNK_SHIFT>
+void SegmentedVector<T, CHUNK_SHIFT>::RemoveLast()
+{
+    if (mNumElements == 0)
+        throw IndexOutOfBoundsException();
+
+    DestroyLast(1);
+}
+
+template <typename T, unsigned int CHUNK_SHIFT>
+typename SegmentedVector<T, CHUNK_SHIFT>::Iterator SegmentedVector<T, CHUNK_SHIFT>::Remove(Iterator begin, Iterator end)
+{
+    if (begin.mIndex > end.mIndex || end.mIndex > mNumElements)
+        throw IndexOutOfBoundsException();
+
+    if (begin != end)
+    {
+        std::move(end, End(), begin);
+        DestroyLast(end - begin);
+    }
+
+    return begin;
+}
+
+template <typename T, unsigned int CHUNK_SHIFT>
+template <typename P>
+size_t SegmentedVector<T, CHUNK_SHIFT>::RemoveIf(const P &predicate)
+{
+    size_t numKept = 0;
+
+    for (size_t i = 0; i < mNumElements; i++)
+    {
+        T &element = (*this)[i];
+
+        if (predicate(element))
+            continue;
+
+        if (numKept != i)
+            (*this)[numKept] = std::move(element);
+
+        numKept++;
+    }
+
+    size_t numRemoved = mNumElements - numKept;
+    DestroyLast(numRemoved);
+
+    return numRemoved;
+}
+
+template <typename T, unsigned int CHUNK_SHIFT>
+size_t SegmentedVector<T, CHUNK_SHIFT>::FindIndex(const T &key) const
+{
+    for (size_t first = 0; first < mNumElements; first += CHUNK_SIZE)
+    {
+        const T *chunk = mChunks[first >> CHUNK_SHIFT];
+        size_t count = std::min(CHUNK_SIZE, mNumElements - first);
+        size_t i = 0;
+
+        if constexpr (SimdSearchable<T>::value)
+            i = SimdFind(chunk, count, key);
+        else
+            while (i < count && !(key == chunk[i]))
+                i++;
+
+        if (i < count)
+            return first + i;
+    }
+
+    return mNumElements;
+}
+
+template <typename T, unsigned int CHUNK_SHIFT>
+template <typename P>
+size_t SegmentedVector<T, CHUNK_SHIFT>::FindIfIndex(const P &predicate) const
+{
+    for (size_t first = 0; first < mNumElements; first += CHUNK_SIZE)
+    {
+        const T *chunk = mChunks[first >> CHUNK_SHIFT];
+        size_t count = std::min(CHUNK_SIZE, mNumElements - first);
+        size_t i = 0;
+
+        if constexpr (std::is_arithmetic<T>::value)
+            i = BlockFindIf(chunk, count, predicate);
+        else
+            while (i < count && !predicate(chunk[i]))
+                i++;
+
+        if (i < count)
+            return first + i;
+    }
+
+    return mNumElements;
+}
+
+template <typename T, unsigned int CHUNK_SHIFT>
+size_t SegmentedVector<T, CHUNK_SHIFT>::Count(const T &key) const
+{
+    size_t count = 0;
+
+    ForEachChunk([&key, &count](const T *elements, size_t numElements)
+    {
+        if constexpr (SimdSearchable<T>::value)
+            count += SimdCount(elements, numElements, key);
+        else
+            for (size_t i = 0; i < numElements; i++)
+                count += key == elements[i];
+    });
+
+    return count;
+}
+
+template <typename T, unsigned int CHUNK_SHIFT>
+template <typename P>
+size_t SegmentedVector<T, CHUNK_SHIFT>::CountIf(const P &predicate) const
+{
+    size_t count = 0;
+
+    ForEachChunk([&predicate, &count](const T *elements, size_t numElements)
+    {
+        if constexpr (std::is_arithmetic<T>::value)
+            count += BlockCountIf(elements, numElements, predicate);
+        else
+            for (size_t i = 0; i < numElements; i++)
+                count += predicate(elements[i]) ? 1 : 0;
+    });
+
+    return count;
+}
+
+#endif  // SEGMENTED_VECTOR_H
@@ -3,8 +3,8 @@
 
 #include "ADT/stack/stack.hpp"
 
-template <typename T, template <class> class S>
-void SequenceReverse(S<T> &sequence)
+template <typename T, template <typename...> class S, typename... Rest>
+void SequenceReverse(S<T, Rest...> &sequence)
 {
     Stack<T> stack;
 
@@ -0,0 +1,36 @@
+#include "soa_vector.hpp"
+#include <iostream>
+#include <string>
+
+int main(int argc, char **argv)
+{
+    // id, name, position, velocity
+    SoAVector<int, std::string, float, float> particles;
+
+    for (int i = 0; i < 8; i++)
+        particles.InsertLast(i, "particle " + std::to_string(i), i * 1.0f, 0.5f);
+
+    // hot loop over two columns only
+    float *positions = particles.Column<2>();
+    const float *velocities = particles.Column<3>();
+
+    for (size_t i = 0; i < particles.Size(); i++)
+        positions[i] += velocities[i];
+
+    particles.Remove(2);
+    particles.SwapRemove(0);
+    particles.Insert(1, std::make_tuple(42, std::string("inserted"), -1.0f, 0.0f));
+    particles.RemoveIf([](SoAVector<int, std::string, float, float>::ConstReference particle) { return particle.Get<0>() % 3 == 0; });
+
+    for (auto particle : particles)
+        std::cout << particle.Get<0>() << " " << particle.Get<1>() << " " << particle.Get<2>() << std::endl;
+
+    std::cout << "index of id 5: " << particles.Find<0>(5) << std::endl;
+
+    float total = 0.0f;
+    for (float position : particles.ColumnView<2>())
+        total += position;
+    std::cout << "total position: " << total << std::endl;
+
+    return 0;
+}
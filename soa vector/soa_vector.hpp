@@ -0,0 +1,720 @@
+#ifndef SOA_VECTOR_H
+#define SOA_VECTOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <tuple>
+#include <utility>
+#include <type_traits>
+
+#include "../vector/vector.hpp"
+
+using std::size_t;
+
+// contiguous view of one column, usable with the SIMD kernels (Data / Size) or in a range-for loop
+template <typename F>
+class ColumnSpan
+{
+public:
+    ColumnSpan(F *data, size_t size) : mData(data), mSize(size) {}
+
+    F *Data() const { return mData; }
+    size_t Size() const { return mSize; }
+
+    F *Begin() const { return mData; }
+    F *End() const { return mData + mSize; }
+
+    F &operator[](size_t index) const { return mData[index]; }
+
+private:
+    F *mData;
+    size_t mSize;
+};
+
+template <typename F>
+F *begin(const ColumnSpan<F> &span)
+{
+    return span.Begin();
+}
+
+template <typename F>
+F *end(const ColumnSpan<F> &span)
+{
+    return span.End();
+}
+
+template <typename... Fields>
+class SoAVector;
+
+template <typename... Fields>
+void swap(SoAVector<Fields...> &a, SoAVector<Fields...> &b)
+{
+    a.Swap(b);
+}
+
+/**** struct of arrays: element i is the row (Get<0>(i), Get<1>(i), ...), every field lives in its own array aligned on a
+      cache line, so a loop over one or two fields streams only those (and vectorizes over Column<I>()) ****/
+// rows are accessed through proxies holding a reference per field (operator[] and the iterators), a proxy converts to and
+// is assignable from the tuple of values (Value). insertions and removals move every column in step
+template <typename... Fields>
+class SoAVector
+{
+    static_assert(sizeof...(Fields) > 0, "at least one field");
+
+public:
+    static constexpr size_t NUM_FIELDS = sizeof...(Fields);
+    static constexpr size_t COLUMN_ALIGNMENT = 64;   // cache line, widest SIMD register (AVX-512)
+
+    template <size_t I>
+    using FieldType = typename std::tuple_element<I, std::tuple<Fields...>>::type;
+
+    typedef std::tuple<Fields...> Value;
+
+private:
+    template <bool CONST>
+    class ReferenceBase;
+    template <bool CONST>
+    class IteratorBase;
+
+public:
+    typedef ReferenceBase<false> Reference;
+    typedef ReferenceBase<true> ConstReference;
+    typedef IteratorBase<false> Iterator;      // random access iterator over proxies
+    typedef IteratorBase<true> ConstIterator;  // implicit conversion from Iterator to ConstIterator
+
+public:
+    SoAVector() : mColumns(static_cast<Fields*>(nullptr)...), mCapacity(0U), mNumElements(0U) {}
+    SoAVector(size_t size);
+    SoAVector(const SoAVector &other);
+    SoAVector(SoAVector &&other);
+
+    ~SoAVector() { Clear(); }
+
+    SoAVector &operator=(const SoAVector &other);
+    SoAVector &operator=(SoAVector &&other);
+
+    void Swap(SoAVector &other);
+
+    size_t Size() const { return mNumElements; }
+    size_t Capacity() const { return mCapacity; }
+    bool Empty() const { return mNumElements == 0; }
+
+    void Resize(size_t size);    // new rows are default constructed
+    void Reserve(size_t size);   // grow
+    void Clear();
+
+    // columns: the pointers are valid until the next reallocation, ColumnSpan covers the Size() elements
+    template <size_t I>
+    FieldType<I> *Column() { return std::get<I>(mColumns); }
+    template <size_t I>
+    const FieldType<I> *Column() const { return std::get<I>(mColumns); }
+    template <size_t I>
+    ColumnSpan<FieldType<I>> ColumnView() { return ColumnSpan<FieldType<I>>(Column<I>(), mNumElements); }
+    template <size_t I>
+    ColumnSpan<const FieldType<I>> ColumnView() const { return ColumnSpan<const FieldType<I>>(Column<I>(), mNumElements); }
+
+    template <size_t I>
+    FieldType<I> &Get(size_t index) { return std::get<I>(mColumns)[index]; }
+    template <size_t I>
+    const FieldType<I> &Get(size_t index) const { return std::get<I>(mColumns)[index]; }
+
+    Iterator Begin() { return Iterator(this, 0); }
+    ConstIterator Begin() const { return ConstIterator(this, 0); }
+    ConstIterator CBegin() const { return Begin(); }
+    Iterator End() { return Iterator(this, mNumElements); }   // return past the end iterator
+    ConstIterator End() const { return ConstIterator(this, mNumElements); }
+    ConstIterator CEnd() const { return End(); }
+
+    // a row is inserted from one value per field (converted to the field types) or from a Value
+    template <typename... Args>
+    void Insert(int index, Args&&... fields);
+    template <typename... Args>
+    void InsertFirst(Args&&... fields) { Insert(0, std::forward<Args>(fields)...); }
+    template <typename... Args>
+    void InsertLast(Args&&... fields) { EmplaceRow(std::forward<Args>(fields)...); }
+
+    void Remove(int index);
+    void RemoveFirst() { Remove(0); }
+    void RemoveLast() { Remove(mNumElements - 1); }
+    Iterator Remove(Iterator pos) { return Remove(pos, pos + 1); }
+    Iterator Remove(Iterator begin, Iterator end);   // return iterator to the element that followed the removed range
+    void SwapRemove(int index);                      // O(1): the last row takes the place of the removed one
+    template <typename P>
+    size_t RemoveIf(const P &predicate);             // predicate(ConstReference), order kept, return number removed
+
+    Reference operator[](size_t index) { return Reference(*this, index); }
+    ConstReference operator[](size_t index) const { return ConstReference(*this, index); }
+    Reference First() { return (*this)[0]; }
+    ConstReference First() const { return (*this)[0]; }
+    Reference Last() { return (*this)[mNumElements - 1]; }
+    ConstReference Last() const { return (*this)[mNumElements - 1]; }
+
+    // linear search in column I (SIMD kernels of Vector for arithmetic fields), Size() if absent
+    template <size_t I>
+    size_t Find(const FieldType<I> &key) const;
+    template <size_t I>
+    size_t Count(const FieldType<I> &key) const;
+
+private:
+    typedef std::tuple<Fields*...> Columns;
+
+    Columns mColumns;
+    size_t mCapacity;
+    size_t mNumElements;
+
+    template <typename F>
+    static F *AllocateColumn(size_t capacity);
+    template <typename F>
+    static void FreeColumn(F *column);
+    static Columns AllocateColumns(size_t capacity);
+    static void FreeColumns(const Columns &columns);
+
+    template <typename F>
+    static void Relocate(F *to, F *from, size_t count);
+
+    template <typename C, typename F, size_t... I>
+    static void ForEachColumn(C &columns, const F &f, std::index_sequence<I...>) { (f(std::get<I>(columns)), ...); }
+    template <typename F>
+    void ForEachColumn(const F &f) { ForEachColumn(mColumns, f, std::index_sequence_for<Fields...>()); }
+    template <size_t... I>
+    void RelocateColumns(const Columns &newColumns, std::index_sequence<I...>) { (Relocate(std::get<I>(newColumns), std::get<I>(mColumns), mNumElements), ...); }
+
+    // build a whole row or nothing (the fields constructed before a throwing one are destroyed)
+    template <size_t I = 0, typename Arg, typename... Rest>
+    static void ConstructRow(const Columns &columns, size_t index, Arg &&field, Rest&&... fields);
+    template <size_t I = 0>
+    static void ConstructDefaultRow(const Columns &columns, size_t index);
+
+    template <typename... Args>
+    void EmplaceRow(Args&&... fields);
+    template <typename... Args>
+    static void ConstructAnyRow(const Columns &columns, size_t index, Args&&... fields);
+    void Grow(size_t capacity, const Columns &newColumns);
+    void DestroyLast(size_t count);
+    void RotateLastTo(size_t index);
+
+    template <typename... Args>
+    struct IsRow : std::false_type {};
+    template <typename Arg>
+    struct IsRow<Arg> : std::is_same<typename std::decay<Arg>::type, Value> {};
+};
+
+// a reference per field of one row, assignment writes through (proxy semantics, as std::vector<bool>::reference)
+template <typename... Fields>
+template <bool CONST>
+class SoAVector<Fields...>::ReferenceBase
+{
+    typedef typename std::conditional<CONST, const SoAVector, SoAVector>::type Container;
+
+public:
+    ReferenceBase(Container &vector, size_t index) : mColumns(vector.mColumns), mIndex(index) {}
+
+    template <bool OTHER_CONST, typename = typename std::enable_if<CONST && !OTHER_CONST>::type>
+    ReferenceBase(const ReferenceBase<OTHER_CONST> &other) : mColumns(other.mColumns), mIndex(other.mIndex) {}
+
+    template <size_t I>
+    typename std::conditional<CONST, const FieldType<I>&, FieldType<I>&>::type Get() const { return std::get<I>(mColumns)[mIndex]; }
+
+    operator Value() const { return ToValue(std::index_sequence_for<Fields...>()); }
+
+    const ReferenceBase &operator=(const Value &row) const { Assign(row, std::index_sequence_for<Fields...>()); return *this; }
+    const ReferenceBase &operator=(Value &&row) const { Assign(std::move(row), std::index_sequence_for<Fields...>()); return *this; }
+    const ReferenceBase &operator=(const ReferenceBase &other) const { Assign(other, std::index_sequence_for<Fields...>()); return *this; }
+
+    friend void swap(const ReferenceBase &a, const ReferenceBase &b) { a.SwapFields(b, std::index_sequence_for<Fields...>()); }
+
+private:
+    template <bool>
+    friend class ReferenceBase;
+
+    const Columns &mColumns;
+    size_t mIndex;
+
+    template <size_t... I>
+    Value ToValue(std::index_sequence<I...>) const { return Value(Get<I>()...); }
+    template <size_t... I>
+    void Assign(const Value &row, std::index_sequence<I...>) const { ((Get<I>() = std::get<I>(row)), ...); }
+    template <size_t... I>
+    void Assign(Value &&row, std::index_sequence<I...>) const { ((Get<I>() = std::move(std::get<I>(row))), ...); }
+    template <size_t... I>
+    void Assign(const ReferenceBase &other, std::index_sequence<I...>) const { ((Get<I>() = other.template Get<I>()), ...); }
+    template <size_t... I>
+    void SwapFields(const ReferenceBase &other, std::index_sequence<I...>) const { using std::swap; (swap(Get<I>(), other.template Get<I>()), ...); }
+};
+
+// the iterator is the container plus an index, so it stays valid across reallocations
+template <typename... Fields>
+template <bool CONST>
+class SoAVector<Fields...>::IteratorBase
+{
+    typedef typename std::conditional<CONST, const SoAVector, SoAVector>::type Container;
+
+public:
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef Value value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef void pointer;
+    typedef ReferenceBase<CONST> reference;
+
+public:
+    IteratorBase() : mVector(nullptr), mIndex(0) {}
+    IteratorBase(Container *vector, size_t index) : mVector(vector), mIndex(index) {}
+
+    template <bool OTHER_CONST, typename = typename std::enable_if<CONST && !OTHER_CONST>::type>
+    IteratorBase(const IteratorBase<OTHER_CONST> &other) : mVector(other.mVector), mIndex(other.mIndex) {}
+
+    reference operator*() const { return reference(*mVector, mIndex); }
+    reference operator[](difference_type n) const { return reference(*mVector, mIndex + n); }
+
+    IteratorBase &operator++() { mIndex++; return *this; }
+    IteratorBase operator++(int) { IteratorBase it = *this; mIndex++; return it; }
+    IteratorBase &operator--() { mIndex--; return *this; }
+    IteratorBase operator--(int) { IteratorBase it = *this; mIndex--; return it; }
+
+    IteratorBase &operator+=(difference_type n) { mIndex += n; return *this; }
+    IteratorBase &operator-=(difference_type n) { mIndex -= n; return *this; }
+    IteratorBase operator+(difference_type n) const { return IteratorBase(mVector, mIndex + n); }
+    IteratorBase operator-(difference_type n) const { return IteratorBase(mVector, mIndex - n); }
+    friend IteratorBase operator+(difference_type n, const IteratorBase &it) { return it + n; }
+    difference_type operator-(const IteratorBase &other) const { return difference_type(mIndex) - difference_type(other.mIndex); }
+
+    bool operator==(const IteratorBase &other) const { return mIndex == other.mIndex; }
+    bool operator!=(const IteratorBase &other) const { return mIndex != other.mIndex; }
+    bool operator<(const IteratorBase &other) const { return mIndex < other.mIndex; }
+    bool operator>(const IteratorBase &other) const { return mIndex > other.mIndex; }
+    bool operator<=(const IteratorBase &other) const { return mIndex <= other.mIndex; }
+    bool operator>=(const IteratorBase &other) const { return mIndex >= other.mIndex; }
+
+    size_t Index() const { return mIndex; }
+
+private:
+    friend class SoAVector;
+    template <bool>
+    friend class IteratorBase;
+
+    Container *mVector;
+    size_t mIndex;
+};
+
+// begin and end functions (to use in range-for loop)
+template <typename... Fields>
+typename SoAVector<Fields...>::Iterator begin(SoAVector<Fields...> &vector)
+{
+    return vector.Begin();
+}
+
+template <typename... Fields>
+typename SoAVector<Fields...>::Iterator end(SoAVector<Fields...> &vector)
+{
+    return vector.End();
+}
+
+template <typename... Fields>
+typename SoAVector<Fields...>::ConstIterator begin(const SoAVector<Fields...> &vector)
+{
+    return vector.Begin();
+}
+
+template <typename... Fields>
+typename SoAVector<Fields...>::ConstIterator end(const SoAVector<Fields...> &vector)
+{
+    return vector.End();
+}
+
+template <typename... Fields>
+SoAVector<Fields...>::SoAVector(size_t size) : SoAVector()
+{
+    Resize(size);
+}
+
+template <typename... Fields>
+SoAVector<Fields...>::SoAVector(const SoAVector &other) : SoAVector()
+{
+    Reserve(other.mNumElements);
+
+    for (size_t i = 0; i < other.mNumElements; i++)
+        InsertLast(static_cast<Value>(other[i]));
+}
+
+template <typename... Fields>
+SoAVector<Fields...>::SoAVector(SoAVector &&other) : SoAVector()
+{
+    Swap(other);
+}
+
+template <typename... Fields>
+SoAVector<Fields...> &SoAVector<Fields...>::operator=(const SoAVector &other)
+{
+    if (this != &other)
+    {
+        SoAVector copy(other);
+        Swap(copy);
+    }
+
+    return *this;
+}
+
+template <typename... Fields>
+SoAVector<Fields...> &SoAVector<Fields...>::operator=(SoAVector &&other)
+{
+    if (this != &other)
+    {
+        Clear();
+        Swap(other);
+    }
+
+    return *this;
+}
+
+template <typename... Fields>
+void SoAVector<Fields...>::Swap(SoAVector &other)
+{
+    std::swap(mColumns, other.mColumns);
+    std::swap(mCapacity, other.mCapacity);
+    std::swap(mNumElements, other.mNumElements);
+}
+
+template <typename... Fields>
+template <typename F>
+F *SoAVector<Fields...>::AllocateColumn(size_t capacity)
+{
+    return static_cast<F*>(operator new(capacity * sizeof(F), std::align_val_t(std::max(COLUMN_ALIGNMENT, alignof(F)))));
+}
+
+template <typename... Fields>
+template <typename F>
+void SoAVector<Fields...>::FreeColumn(F *column)
+{
+    operator delete(column, std::align_val_t(std::max(COLUMN_ALIGNMENT, alignof(F))));
+}
+
+// all or nothing
+template <typename... Fields>
+typename SoAVector<Fields...>::Columns SoAVector<Fields...>::AllocateColumns(size_t capacity)
+{
+    Columns columns(static_cast<Fields*>(nullptr)...);
+
+    try
+    {
+        ForEachColumn(columns, [capacity](auto &column)
+        {
+            column = AllocateColumn<typename std::remove_pointer<typename std::remove_reference<decltype(column)>::type>::type>(capacity);
+        }, std::index_sequence_for<Fields...>());
+    }
+    catch (...)
+    {
+        FreeColumns(columns);
+        throw;
+    }
+
+    return columns;
+}
+
+template <typename... Fields>
+void SoAVector<Fields...>::FreeColumns(const Columns &columns)
+{
+    ForEachColumn(columns, [](auto *column)
+    {
+        if (column)
+            FreeColumn(column);
+    }, std::index_sequence_for<Fields...>());
+}
+
+template <typename... Fields>
+template <typename F>
+void SoAVector<Fields...>::Relocate(F *to, F *from, size_t count)
+{
+    if constexpr (IsTriviallyRelocatable<F>::value)
+    {
+        if (count > 0)
+            std::memcpy(static_cast<void*>(to), static_cast<const void*>(from), count * sizeof(F));
+    }
+    else
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            new(&to[i]) F(std::move(from[i]));
+            from[i].~F();
+        }
+    }
+}
+
+template <typename... Fields>
+template <size_t I, typename Arg, typename... Rest>
+void SoAVector<Fields...>::ConstructRow(const Columns &columns, size_t index, Arg &&field, Rest&&... fields)
+{
+    typedef FieldType<I> F;
+
+    F *address = std::get<I>(columns) + index;
+    new(address) F(std::forward<Arg>(field));
+
+    if constexpr (sizeof...(Rest) > 0)
+    {
+        try
+        {
+            ConstructRow<I + 1>(columns, index, std::forward<Rest>(fields)...);
+        }
+        catch (...)
+        {
+            address->~F();
+            throw;
+        }
+    }
+}
+
+template <typename... Fields>
+template <size_t I>
+void SoAVector<Fields...>::ConstructDefaultRow(const Columns &columns, size_t index)
+{
+    typedef FieldType<I> F;
+
+    F *address = std::get<I>(columns) + index;
+    new(address) F();
+
+    if constexpr (I + 1 < NUM_FIELDS)
+    {
+        try
+        {
+            ConstructDefaultRow<I + 1>(columns, index);
+        }
+        catch (...)
+        {
+            address->~F();
+            throw;
+        }
+    }
+}
+
+template <typename... Fields>
+template <typename... Args>
+void SoAVector<Fields...>::ConstructAnyRow(const Columns &columns, size_t index, Args&&... fields)
+{
+    if constexpr (sizeof...(Args) == 0)
+        ConstructDefaultRow(columns, index);
+    else if constexpr (IsRow<Args...>::value)
+        std::apply([&columns, index](auto&&... rowFields) { ConstructRow(columns, index, std::forward<decltype(rowFields)>(rowFields)...); }, std::forward<Args>(fields)...);
+    else
+    {
+        static_assert(sizeof...(Args) == NUM_FIELDS, "one value per field");
+        ConstructRow(columns, index, std::forward<Args>(fields)...);
+    }
+}
+
+// the old columns are released after their elements moved to the new ones
+template <typename... Fields>
+void SoAVector<Fields...>::Grow(size_t capacity, const Columns &newColumns)
+{
+    RelocateColumns(newColumns, std::index_sequence_for<Fields...>());
+    FreeColumns(mColumns);
+
+    mColumns = newColumns;
+    mCapacity = capacity;
+}
+
+// fields may refer to elements of the vector: when growing the row is built in the new columns before the old ones go
+template <typename... Fields>
+template <typename... Args>
+void SoAVector<Fields...>::EmplaceRow(Args&&... fields)
+{
+    if (mNumElements == mCapacity)
+    {
+        size_t capacity = mCapacity == 0 ? 1 : mCapacity * 2;
+        Columns newColumns = AllocateColumns(capacity);
+
+        try
+        {
+            ConstructAnyRow(newColumns, mNumElements, std::forward<Args>(fields)...);
+        }
+        catch (...)
+        {
+            FreeColumns(newColumns);
+            throw;
+        }
+
+        Grow(capacity, newColumns);
+    }
+    else
+        ConstructAnyRow(mColumns, mNumElements, std::forward<Args>(fields)...);
+
+    mNumElements++;
+}
+
+template <typename... Fields>
+template <typename... Args>
+void SoAVector<Fields...>::Insert(int index, Args&&... fields)
+{
+    if (index < 0 || static_cast<size_t>(index) > mNumElements)
+        throw IndexOutOfBoundsException();
+
+    EmplaceRow(std::forward<Args>(fields)...);
+    RotateLastTo(index);
+}
+
+template <typename... Fields>
+void SoAVector<Fields...>::RotateLastTo(size_t index)
+{
+    ForEachColumn([this, index](auto *column)
+    {
+        std::rotate(column + index, column + mNumElements - 1, column + mNumElements);
+    });
+}
+
+template <typename... Fields>
+void SoAVector<Fields...>::DestroyLast(size_t count)
+{
+    ForEachColumn([this, count](auto *column)
+    {
+        typedef typename std::remove_pointer<decltype(column)>::type F;
+
+        for (size_t i = mNumElements - count; i < mNumElements; i++)
+            column[i].~F();
+    });
+
+    mNumElements -= count;
+}
+
+template <typename... Fields>
+void SoAVector<Fields...>::Resize(size_t size)
+{
+    if (size < mNumElements)
+    {
+        DestroyLast(mNumElements - size);
+        return;
+    }
+
+    Reserve(size);
+
+    while (mNumElements < size)
+        EmplaceRow();
+}
+
+template <typename... Fields>
+void SoAVector<Fields...>::Reserve(size_t size)
+{
+    if (size <= mCapacity)
+        return;
+
+    Grow(size, AllocateColumns(size));
+}
+
+template <typename... Fields>
+void SoAVector<Fields...>::Clear()
+{
+    DestroyLast(mNumElements);
+    FreeColumns(mColumns);
+
+    mColumns = Columns(static_cast<Fields*>(nullptr)...);
+    mCapacity = 0;
+}
+
+template <typename... Fields>
+void SoAVector<Fields...>::Remove(int index)
+{
+    if (index < 0 || static_cast<size_t>(index) >= mNumElements)
+        throw IndexOutOfBoundsException();
+
+    Remove(Begin() + index, Begin() + (index + 1));
+}
+
+template <typename... Fields>
+typename SoAVector<Fields...>::Iterator SoAVector<Fields...>::Remove(Iterator begin, Iterator end)
+{
+    if (begin.mIndex > end.mIndex || end.mIndex > mNumElements)
+        throw IndexOutOfBoundsException();
+
+    if (begin != end)
+    {
+        ForEachColumn([this, &begin, &end](auto *column)
+        {
+            std::move(column + end.mIndex, column + mNumElements, column + begin.mIndex);
+        });
+
+        DestroyLast(end - begin);
+    }
+
+    return begin;
+}
+
+template <typename... Fields>
+void SoAVector<Fields...>::SwapRemove(int index)
+{
+    if (index < 0 || static_cast<size_t>(index) >= mNumElements)
+        throw IndexOutOfBoundsException();
+
+    if (static_cast<size_t>(index) != mNumElements - 1)
+    {
+        ForEachColumn([this, index](auto *column)
+        {
+            column[index] = std::move(column[mNumElements - 1]);
+        });
+    }
+
+    DestroyLast(1);
+}
+
+template <typename... Fields>
+template <typename P>
+size_t SoAVector<Fields...>::RemoveIf(const P &predicate)
+{
+    size_t numKept = 0;
+
+    for (size_t i = 0; i < mNumElements; i++)
+    {
+        if (predicate(static_cast<const SoAVector&>(*this)[i]))
+            continue;
+
+        if (numKept != i)
+        {
+            ForEachColumn([i, numKept](auto *column)
+            {
+                column[numKept] = std::move(column[i]);
+            });
+        }
+
+        numKept++;
+    }
+
+    size_t numRemoved = mNumElements - numKept;
+    DestroyLast(numRemoved);
+
+    return numRemoved;
+}
+
+template <typename... Fields>
+template <size_t I>
+size_t SoAVector<Fields...>::Find(const FieldType<I> &key) const
+{
+    const FieldType<I> *column = Column<I>();
+
+    if constexpr (SimdSearchable<FieldType<I>>::value)
+        return SimdFind(column, mNumElements, key);
+
+    for (size_t i = 0; i < mNumElements; i++)
+        if (key == column[i])
+            return i;
+
+    return mNumElements;
+}
+
+template <typename... Fields>
+template <size_t I>
+size_t SoAVector<Fields...>::Count(const FieldType<I> &key) const
+{
+    const FieldType<I> *column = Column<I>();
+
+    if constexpr (SimdSearchable<FieldType<I>>::value)
+        return SimdCount(column, mNumElements, key);
+
+    size_t count = 0;
+
+    for (size_t i = 0; i < mNumElements; i++)
+        if (key == column[i])
+            count++;
+
+    return count;
+}
+
+#endif  // SOA_VECTOR_H
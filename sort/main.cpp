@@ -0,0 +1,129 @@
+#include "sort.hpp"
+#include "radix_sort.hpp"
+#include "../parallel/parallel_algorithms.hpp"
+#include "../linked list/double_ended_doubly_linked_list.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+
+/**** sort benchmark matrix: one row per input distribution, one column per algorithm, milliseconds
+      (usage: main [number of elements]) ****/
+
+template <typename T, typename F>
+double Measure(const Vector<T> &input, const F &sort)
+{
+    Vector<T> data = input;
+
+    auto start = std::chrono::steady_clock::now();
+    sort(data);
+    auto stop = std::chrono::steady_clock::now();
+
+    if (!std::is_sorted(data.Begin(), data.End()))
+        std::cout << "NOT SORTED ";
+
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+template <typename T>
+void PrintRow(const std::string &name, const Vector<T> &input)
+{
+    std::cout << std::left << std::setw(16) << name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(14) << Measure(input, [](Vector<T> &v) { std::sort(v.Begin(), v.End()); })
+              << std::setw(14) << Measure(input, [](Vector<T> &v) { Sort(v); })
+              << std::setw(14) << Measure(input, [](Vector<T> &v) { std::stable_sort(v.Begin(), v.End()); })
+              << std::setw(14) << Measure(input, [](Vector<T> &v) { StableSort(v); })
+              << std::setw(14) << Measure(input, [](Vector<T> &v) { RadixSort(v); })
+              << std::setw(14) << Measure(input, [](Vector<T> &v) { ParallelSort(v); }) << std::endl;
+}
+
+int main(int argc, char **argv)
+{
+    size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200000;
+    std::mt19937 random(42);
+
+    std::cout << n << " elements" << std::endl;
+    std::cout << std::left << std::setw(16) << "" << std::right << std::setw(14) << "std::sort" << std::setw(14) << "Sort"
+              << std::setw(14) << "std::stable" << std::setw(14) << "StableSort" << std::setw(14) << "RadixSort"
+              << std::setw(14) << "ParallelSort" << std::endl;
+
+    Vector<int> ints;
+    ints.Resize(n);
+
+    for (size_t i = 0; i < n; i++)
+        ints[i] = random();
+    PrintRow("random int", ints);
+
+    for (size_t i = 0; i < n; i++)
+        ints[i] = i;
+    PrintRow("sorted", ints);
+
+    for (size_t i = 0; i < n; i++)
+        ints[i] = n - i;
+    PrintRow("reversed", ints);
+
+    for (size_t i = 0; i < n; i++)
+        ints[i] = i % 64 == 0 ? random() : i;
+    PrintRow("nearly sorted", ints);
+
+    for (size_t i = 0; i < n; i++)
+        ints[i] = random() % 16;
+    PrintRow("few unique", ints);
+
+    for (size_t i = 0; i < n; i++)
+        ints[i] = i < n / 2 ? i : n - i;
+    PrintRow("organ pipe", ints);
+
+    Vector<double> doubles;
+    for (size_t i = 0; i < n; i++)
+        doubles.InsertLast(std::normal_distribution<double>()(random));
+    PrintRow("random double", doubles);
+
+    Vector<std::string> strings;
+    for (size_t i = 0; i < n; i++)
+        strings.InsertLast("user/" + std::to_string(random() % 100000) + "/item");
+    PrintRow("strings", strings);
+
+    // small arrays: the partitions the sorting network takes
+    std::cout << std::left << std::setw(16) << "64 int arrays" << std::right;
+    for (int algorithm = 0; algorithm < 3; algorithm++)
+    {
+        Vector<int> data = ints;
+        for (size_t i = 0; i < n; i++)
+            data[i] = random();
+
+        auto start = std::chrono::steady_clock::now();
+        for (size_t begin = 0; begin + 64 <= n; begin += 64)
+        {
+            if (algorithm == 0)
+                std::sort(data.Data() + begin, data.Data() + begin + 64);
+            else if (algorithm == 1)
+                Sort(data.Data() + begin, data.Data() + begin + 64);
+            else
+                InsertionSort(data.Data() + begin, data.Data() + begin + 64, std::less<>());
+        }
+        auto stop = std::chrono::steady_clock::now();
+
+        std::cout << std::setw(14) << std::chrono::duration<double, std::milli>(stop - start).count();
+    }
+    std::cout << "   (std::sort, Sort, insertion)" << std::endl;
+
+    // linked list: merge sort relinking the nodes
+    DoublyLinkedList<std::string> list;
+    for (size_t i = 0; i < n; i++)
+        list.InsertLast(strings[i]);
+
+    auto start = std::chrono::steady_clock::now();
+    list.Sort();
+    auto stop = std::chrono::steady_clock::now();
+
+    std::cout << std::left << std::setw(16) << "list of strings" << std::right << std::setw(14)
+              << std::chrono::duration<double, std::milli>(stop - start).count() << "   (DoublyLinkedList::Sort)"
+              << (std::is_sorted(list.Begin(), list.End()) ? "" : " NOT SORTED") << std::endl;
+
+    return 0;
+}
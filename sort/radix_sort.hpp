@@ -0,0 +1,196 @@
+#ifndef RADIX_SORT_H
+#define RADIX_SORT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "../vector/vector.hpp"
+#include "sort.hpp"
+
+using std::size_t;
+
+/**** radix sorts: LSD on the bytes of integer and floating point keys, MSD on the characters of strings ****/
+
+constexpr size_t RADIX_SORT_THRESHOLD = 256;          // smaller ranges go to Sort
+constexpr size_t STRING_RADIX_SORT_THRESHOLD = 32;    // smaller buckets go to Sort
+
+template <size_t SIZE>
+struct UnsignedOfSize;
+
+template <> struct UnsignedOfSize<1> { typedef std::uint8_t Type; };
+template <> struct UnsignedOfSize<2> { typedef std::uint16_t Type; };
+template <> struct UnsignedOfSize<4> { typedef std::uint32_t Type; };
+template <> struct UnsignedOfSize<8> { typedef std::uint64_t Type; };
+
+// unsigned key with the order of the value: the sign bit of integers flipped, every bit of negative floats flipped and
+// the sign bit of positive ones (so -0.0 comes before 0.0 and NaNs go to the ends, by their sign)
+template <typename T>
+typename UnsignedOfSize<sizeof(T)>::Type RadixKey(T value)
+{
+    typedef typename UnsignedOfSize<sizeof(T)>::Type U;
+
+    const U SIGN_BIT = U(1) << (8 * sizeof(T) - 1);
+
+    if constexpr (std::is_floating_point<T>::value)
+    {
+        U bits;
+        std::memcpy(&bits, &value, sizeof(T));
+
+        return (bits & SIGN_BIT) ? U(~bits) : U(bits | SIGN_BIT);
+    }
+    else if constexpr (std::is_signed<T>::value)
+        return U(value) ^ SIGN_BIT;
+    else
+        return U(value);
+}
+
+// one counting pass builds the histograms of all the bytes, then one scatter pass per byte, from the lowest, between the
+// array and a buffer. bytes equal in every key (high bytes of small values) are skipped. stable, O(n) extra memory
+template <typename T>
+void RadixSort(T *data, size_t size)
+{
+    static_assert((std::is_integral<T>::value || std::is_floating_point<T>::value) && !std::is_same<T, bool>::value
+                  && sizeof(T) <= 8, "integer or floating point keys only");
+
+    if (size < RADIX_SORT_THRESHOLD)
+    {
+        Sort(data, data + size);
+        return;
+    }
+
+    size_t histograms[sizeof(T)][256] = {};
+
+    for (size_t i = 0; i < size; i++)
+    {
+        auto key = RadixKey(data[i]);
+
+        for (size_t byte = 0; byte < sizeof(T); byte++)
+            histograms[byte][(key >> (8 * byte)) & 0xFF]++;
+    }
+
+    Vector<T> buffer;
+    buffer.Resize(size);
+
+    T *source = data, *destination = buffer.Data();
+
+    for (size_t byte = 0; byte < sizeof(T); byte++)
+    {
+        size_t *histogram = histograms[byte];
+
+        if (histogram[(RadixKey(data[0]) >> (8 * byte)) & 0xFF] == size)   // the same byte everywhere
+            continue;
+
+        size_t offset = 0;
+        for (size_t digit = 0; digit < 256; digit++)
+        {
+            size_t count = histogram[digit];
+            histogram[digit] = offset;
+            offset += count;
+        }
+
+        for (size_t i = 0; i < size; i++)
+            destination[histogram[(RadixKey(source[i]) >> (8 * byte)) & 0xFF]++] = source[i];
+
+        std::swap(source, destination);
+    }
+
+    if (source != data)
+        std::memcpy(data, source, size * sizeof(T));
+}
+
+// character of a string at depth, 0 past its end (so shorter strings come first) and 1 + the byte otherwise
+inline unsigned int RadixDigit(const std::string &string, size_t depth)
+{
+    return depth < string.size() ? 1 + static_cast<unsigned char>(string[depth]) : 0;
+}
+
+// American flag sort: the strings of a range share their first depth characters, they are counted by their next
+// character and permuted in place into 257 buckets (swaps of strings, no buffer), then every bucket is sorted one
+// character deeper. pending ranges are kept on an explicit stack (long common prefixes do not grow the call stack),
+// small ones are finished by Sort comparing from depth
+inline void RadixSort(std::string *data, size_t size)
+{
+    struct Range
+    {
+        std::string *mBegin;
+        size_t mSize;
+        size_t mDepth;
+    };
+
+    Vector<Range> pending;
+    pending.InsertLast(Range{data, size, 0});
+
+    while (!pending.Empty())
+    {
+        Range range = pending.Last();
+        pending.RemoveLast();
+
+        std::string *begin = range.mBegin;
+        size_t depth = range.mDepth;
+
+        if (range.mSize < STRING_RADIX_SORT_THRESHOLD)
+        {
+            Sort(begin, begin + range.mSize, [depth](const std::string &a, const std::string &b)
+            {
+                return a.compare(depth, std::string::npos, b, depth, std::string::npos) < 0;
+            });
+
+            continue;
+        }
+
+        size_t counts[257] = {};
+
+        for (size_t i = 0; i < range.mSize; i++)
+            counts[RadixDigit(begin[i], depth)]++;
+
+        unsigned int first = RadixDigit(begin[0], depth);
+
+        if (counts[first] == range.mSize)   // one bucket: nothing to permute
+        {
+            if (first != 0)
+                pending.InsertLast(Range{begin, range.mSize, depth + 1});
+
+            continue;
+        }
+
+        size_t next[257], ends[257];
+        size_t offset = 0;
+
+        for (unsigned int digit = 0; digit < 257; digit++)
+        {
+            next[digit] = offset;
+            offset += counts[digit];
+            ends[digit] = offset;
+        }
+
+        for (unsigned int digit = 0; digit < 257; digit++)
+        {
+            while (next[digit] < ends[digit])
+            {
+                unsigned int other = RadixDigit(begin[next[digit]], depth);
+
+                if (other == digit)
+                    next[digit]++;
+                else
+                    std::swap(begin[next[digit]], begin[next[other]++]);
+            }
+        }
+
+        // bucket 0 holds the strings ending at depth: all equal
+        for (unsigned int digit = 1; digit < 257; digit++)
+            if (counts[digit] > 1)
+                pending.InsertLast(Range{begin + (ends[digit] - counts[digit]), counts[digit], depth + 1});
+    }
+}
+
+template <typename T, typename A>
+void RadixSort(Vector<T, A> &vector)
+{
+    RadixSort(vector.Data(), vector.Size());
+}
+
+#endif  // RADIX_SORT_H
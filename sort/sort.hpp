@@ -0,0 +1,635 @@
+#ifndef SORT_H
+#define SORT_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "../allocation_policy.hpp"
+#include "sorting_network.hpp"
+
+using std::size_t;
+
+/**** comparison sorts for random access ranges (Vector, SegmentedVector, arrays): Sort is pattern defeating quicksort,
+      StableSort a merge sort with a buffer of half the range. the containers have Sort(sequence) overloads, the linked
+      lists sort themselves with their Sort member (relinking) ****/
+
+constexpr size_t INSERTION_SORT_THRESHOLD = 24;
+constexpr size_t NINTHER_THRESHOLD = 128;
+constexpr size_t PARTIAL_INSERTION_SORT_LIMIT = 8;
+constexpr size_t PARTITION_BLOCK_SIZE = 64;
+constexpr size_t MERGE_SORT_RUN = 32;
+
+template <typename Iter>
+using IteratorValue = typename std::iterator_traits<Iter>::value_type;
+
+// plain ascending order on arithmetic keys: partitions go branch free and small partitions to the sorting network
+template <typename Iter, typename C>
+struct IsArithmeticLess
+{
+    typedef IteratorValue<Iter> T;
+
+    static constexpr bool value = std::is_arithmetic<T>::value && (std::is_same<C, std::less<>>::value || std::is_same<C, std::less<T>>::value);
+};
+
+// small partitions of contiguous 32 bit keys go to the sorting network
+template <typename Iter, typename C>
+struct UsesSortingNetwork
+{
+    static constexpr bool value = std::is_pointer<Iter>::value && IsArithmeticLess<Iter, C>::value && NetworkSortable<IteratorValue<Iter>>::value;
+};
+
+template <typename Iter, typename C>
+void InsertionSort(Iter begin, Iter end, const C &compare)
+{
+    if (begin == end)
+        return;
+
+    for (Iter current = begin + 1; current != end; ++current)
+    {
+        if (compare(*current, *(current - 1)))
+        {
+            IteratorValue<Iter> element = std::move(*current);
+            Iter hole = current;
+
+            do
+            {
+                *hole = std::move(*(hole - 1));
+                --hole;
+            } while (hole != begin && compare(element, *(hole - 1)));
+
+            *hole = std::move(element);
+        }
+    }
+}
+
+// the element before begin is not greater than any element of the range (no bound check)
+template <typename Iter, typename C>
+void UnguardedInsertionSort(Iter begin, Iter end, const C &compare)
+{
+    if (begin == end)
+        return;
+
+    for (Iter current = begin + 1; current != end; ++current)
+    {
+        if (compare(*current, *(current - 1)))
+        {
+            IteratorValue<Iter> element = std::move(*current);
+            Iter hole = current;
+
+            do
+            {
+                *hole = std::move(*(hole - 1));
+                --hole;
+            } while (compare(element, *(hole - 1)));
+
+            *hole = std::move(element);
+        }
+    }
+}
+
+// insertion sort giving up after PARTIAL_INSERTION_SORT_LIMIT moves, true if the range got sorted
+template <typename Iter, typename C>
+bool PartialInsertionSort(Iter begin, Iter end, const C &compare)
+{
+    if (begin == end)
+        return true;
+
+    size_t numMoves = 0;
+
+    for (Iter current = begin + 1; current != end; ++current)
+    {
+        if (compare(*current, *(current - 1)))
+        {
+            IteratorValue<Iter> element = std::move(*current);
+            Iter hole = current;
+
+            do
+            {
+                *hole = std::move(*(hole - 1));
+                --hole;
+            } while (hole != begin && compare(element, *(hole - 1)));
+
+            *hole = std::move(element);
+            numMoves += current - hole;
+        }
+
+        if (numMoves > PARTIAL_INSERTION_SORT_LIMIT)
+            return false;
+    }
+
+    return true;
+}
+
+template <typename Iter, typename C>
+void Sort2(Iter a, Iter b, const C &compare)
+{
+    if (compare(*b, *a))
+        std::iter_swap(a, b);
+}
+
+template <typename Iter, typename C>
+void Sort3(Iter a, Iter b, Iter c, const C &compare)
+{
+    Sort2(a, b, compare);
+    Sort2(b, c, compare);
+    Sort2(a, b, compare);
+}
+
+template <typename Iter, typename C>
+void SmallSort(Iter begin, Iter end, const C &compare, bool leftmost)
+{
+    if constexpr (UsesSortingNetwork<Iter, C>::value)
+        if (end - begin <= static_cast<std::ptrdiff_t>(SORTING_NETWORK_SIZE) && SortingNetwork(begin, end - begin))
+            return;
+
+    if (leftmost)
+        InsertionSort(begin, end, compare);
+    else
+        UnguardedInsertionSort(begin, end, compare);
+}
+
+// partition around the pivot *begin: [begin, pivot) < pivot <= (pivot, end). the pivot is a median so the scans stop
+// without bound checks. also tells whether the range was already partitioned (no swap needed)
+template <typename Iter, typename C>
+std::pair<Iter, bool> PartitionRight(Iter begin, Iter end, const C &compare)
+{
+    IteratorValue<Iter> pivot = std::move(*begin);
+    Iter first = begin, last = end;
+
+    while (compare(*++first, pivot));
+
+    if (first - 1 == begin)
+        while (first < last && !compare(*--last, pivot));
+    else
+        while (!compare(*--last, pivot));
+
+    bool alreadyPartitioned = first >= last;
+
+    while (first < last)
+    {
+        std::iter_swap(first, last);
+        while (compare(*++first, pivot));
+        while (!compare(*--last, pivot));
+    }
+
+    Iter pivotPosition = first - 1;
+    *begin = std::move(*pivotPosition);
+    *pivotPosition = std::move(pivot);
+
+    return std::make_pair(pivotPosition, alreadyPartitioned);
+}
+
+template <typename Iter>
+void SwapOffsets(Iter first, Iter last, const unsigned char *offsetsLeft, const unsigned char *offsetsRight, size_t count, bool useSwaps)
+{
+    if (useSwaps)
+    {
+        for (size_t i = 0; i < count; i++)
+            std::iter_swap(first + offsetsLeft[i], last - offsetsRight[i]);
+    }
+    else if (count > 0)   // one cycle through a temporary: 2 moves per pair instead of 3
+    {
+        Iter left = first + offsetsLeft[0], right = last - offsetsRight[0];
+        IteratorValue<Iter> element = std::move(*left);
+        *left = std::move(*right);
+
+        for (size_t i = 1; i < count; i++)
+        {
+            left = first + offsetsLeft[i];
+            *right = std::move(*left);
+            right = last - offsetsRight[i];
+            *left = std::move(*right);
+        }
+
+        *right = std::move(element);
+    }
+}
+
+// PartitionRight without branches on the comparisons (block partition): the offsets of the misplaced elements of a block
+// from each side are recorded first (the compare result is added to a counter), then the recorded elements are swapped
+template <typename Iter, typename C>
+std::pair<Iter, bool> PartitionRightBranchless(Iter begin, Iter end, const C &compare)
+{
+    IteratorValue<Iter> pivot = std::move(*begin);
+    Iter first = begin, last = end;
+
+    while (compare(*++first, pivot));
+
+    if (first - 1 == begin)
+        while (first < last && !compare(*--last, pivot));
+    else
+        while (!compare(*--last, pivot));
+
+    bool alreadyPartitioned = first >= last;
+
+    if (!alreadyPartitioned)
+    {
+        std::iter_swap(first, last);
+        ++first;
+
+        alignas(64) unsigned char offsetsLeft[PARTITION_BLOCK_SIZE];
+        alignas(64) unsigned char offsetsRight[PARTITION_BLOCK_SIZE];
+        size_t numLeft = 0, numRight = 0, startLeft = 0, startRight = 0;
+
+        // [first, last) is unknown, offsets of the right side are counted from last
+        while (last - first > static_cast<std::ptrdiff_t>(2 * PARTITION_BLOCK_SIZE))
+        {
+            if (numLeft == 0)
+            {
+                startLeft = 0;
+                Iter it = first;
+
+                for (unsigned char i = 0; i < PARTITION_BLOCK_SIZE; i++, ++it)
+                {
+                    offsetsLeft[numLeft] = i;
+                    numLeft += !compare(*it, pivot);
+                }
+            }
+
+            if (numRight == 0)
+            {
+                startRight = 0;
+                Iter it = last;
+
+                for (unsigned char i = 0; i < PARTITION_BLOCK_SIZE;)
+                {
+                    offsetsRight[numRight] = ++i;
+                    numRight += compare(*--it, pivot);
+                }
+            }
+
+            size_t count = std::min(numLeft, numRight);
+            SwapOffsets(first, last, offsetsLeft + startLeft, offsetsRight + startRight, count, numLeft == numRight);
+
+            numLeft -= count;
+            numRight -= count;
+            startLeft += count;
+            startRight += count;
+
+            if (numLeft == 0)
+                first += PARTITION_BLOCK_SIZE;
+
+            if (numRight == 0)
+                last -= PARTITION_BLOCK_SIZE;
+        }
+
+        // what is left: at most one pending block and the unknown elements
+        size_t sizeLeft = 0, sizeRight = 0;
+        size_t unknown = (last - first) - ((numLeft || numRight) ? PARTITION_BLOCK_SIZE : 0);
+
+        if (numRight)
+        {
+            sizeLeft = unknown;
+            sizeRight = PARTITION_BLOCK_SIZE;
+        }
+        else if (numLeft)
+        {
+            sizeLeft = PARTITION_BLOCK_SIZE;
+            sizeRight = unknown;
+        }
+        else
+        {
+            sizeLeft = unknown / 2;
+            sizeRight = unknown - sizeLeft;
+        }
+
+        if (unknown && !numLeft)
+        {
+            startLeft = 0;
+            Iter it = first;
+
+            for (unsigned char i = 0; i < sizeLeft; i++, ++it)
+            {
+                offsetsLeft[numLeft] = i;
+                numLeft += !compare(*it, pivot);
+            }
+        }
+
+        if (unknown && !numRight)
+        {
+            startRight = 0;
+            Iter it = last;
+
+            for (unsigned char i = 0; i < sizeRight;)
+            {
+                offsetsRight[numRight] = ++i;
+                numRight += compare(*--it, pivot);
+            }
+        }
+
+        size_t count = std::min(numLeft, numRight);
+        SwapOffsets(first, last, offsetsLeft + startLeft, offsetsRight + startRight, count, numLeft == numRight);
+
+        numLeft -= count;
+        numRight -= count;
+        startLeft += count;
+        startRight += count;
+
+        if (numLeft == 0)
+            first += sizeLeft;
+
+        if (numRight == 0)
+            last -= sizeRight;
+
+        // the misplaced elements of the last block go to the far end of the other side
+        if (numLeft)
+        {
+            while (numLeft--)
+                std::iter_swap(first + offsetsLeft[startLeft + numLeft], --last);
+
+            first = last;
+        }
+
+        if (numRight)
+        {
+            while (numRight--)
+                std::iter_swap(last - offsetsRight[startRight + numRight], first), ++first;
+
+            last = first;
+        }
+    }
+
+    Iter pivotPosition = first - 1;
+    *begin = std::move(*pivotPosition);
+    *pivotPosition = std::move(pivot);
+
+    return std::make_pair(pivotPosition, alreadyPartitioned);
+}
+
+// partition around the pivot *begin putting the elements equal to it on the left, used when the pivot equals the
+// element before the range (so it is the smallest of the range): the equal elements are then done
+template <typename Iter, typename C>
+Iter PartitionLeft(Iter begin, Iter end, const C &compare)
+{
+    IteratorValue<Iter> pivot = std::move(*begin);
+    Iter first = begin, last = end;
+
+    while (compare(pivot, *--last));
+
+    if (last + 1 == end)
+        while (first < last && !compare(pivot, *++first));
+    else
+        while (!compare(pivot, *++first));
+
+    while (first < last)
+    {
+        std::iter_swap(first, last);
+        while (compare(pivot, *--last));
+        while (!compare(pivot, *++first));
+    }
+
+    Iter pivotPosition = last;
+    *begin = std::move(*pivotPosition);
+    *pivotPosition = std::move(pivot);
+
+    return pivotPosition;
+}
+
+// quicksort loop of pdqsort: median of 3 (ninther on large ranges) pivot, runs of equal elements partitioned away in
+// linear time, already partitioned ranges finished by insertion sort, and after log2(n) unbalanced partitions the range
+// is shuffled then heap sorted, which bounds the worst case to O(n log n)
+template <typename Iter, typename C>
+void PdqSortLoop(Iter begin, Iter end, const C &compare, int badAllowed, bool leftmost = true)
+{
+    while (true)
+    {
+        size_t size = end - begin;
+
+        if (size < INSERTION_SORT_THRESHOLD || (UsesSortingNetwork<Iter, C>::value && size <= SORTING_NETWORK_SIZE && DetectSimdLevel() == SimdLevel::AVX2))
+        {
+            SmallSort(begin, end, compare, leftmost);
+            return;
+        }
+
+        size_t half = size / 2;
+
+        if (size > NINTHER_THRESHOLD)
+        {
+            Sort3(begin, begin + half, end - 1, compare);
+            Sort3(begin + 1, begin + (half - 1), end - 2, compare);
+            Sort3(begin + 2, begin + (half + 1), end - 3, compare);
+            Sort3(begin + (half - 1), begin + half, begin + (half + 1), compare);
+            std::iter_swap(begin, begin + half);
+        }
+        else
+            Sort3(begin + half, begin, end - 1, compare);
+
+        if (!leftmost && !compare(*(begin - 1), *begin))
+        {
+            begin = PartitionLeft(begin, end, compare) + 1;
+            continue;
+        }
+
+        std::pair<Iter, bool> partition;
+
+        if constexpr (IsArithmeticLess<Iter, C>::value)
+            partition = PartitionRightBranchless(begin, end, compare);
+        else
+            partition = PartitionRight(begin, end, compare);
+
+        Iter pivotPosition = partition.first;
+        size_t sizeLeft = pivotPosition - begin, sizeRight = end - (pivotPosition + 1);
+
+        if (sizeLeft < size / 8 || sizeRight < size / 8)
+        {
+            if (--badAllowed == 0)
+            {
+                std::make_heap(begin, end, compare);
+                std::sort_heap(begin, end, compare);
+                return;
+            }
+
+            // break the pattern that made the pivot bad
+            if (sizeLeft >= INSERTION_SORT_THRESHOLD)
+            {
+                std::iter_swap(begin, begin + sizeLeft / 4);
+                std::iter_swap(pivotPosition - 1, pivotPosition - sizeLeft / 4);
+
+                if (sizeLeft > NINTHER_THRESHOLD)
+                {
+                    std::iter_swap(begin + 1, begin + (sizeLeft / 4 + 1));
+                    std::iter_swap(begin + 2, begin + (sizeLeft / 4 + 2));
+                    std::iter_swap(pivotPosition - 2, pivotPosition - (sizeLeft / 4 + 1));
+                    std::iter_swap(pivotPosition - 3, pivotPosition - (sizeLeft / 4 + 2));
+                }
+            }
+
+            if (sizeRight >= INSERTION_SORT_THRESHOLD)
+            {
+                std::iter_swap(pivotPosition + 1, pivotPosition + (1 + sizeRight / 4));
+                std::iter_swap(end - 1, end - sizeRight / 4);
+
+                if (sizeRight > NINTHER_THRESHOLD)
+                {
+                    std::iter_swap(pivotPosition + 2, pivotPosition + (2 + sizeRight / 4));
+                    std::iter_swap(pivotPosition + 3, pivotPosition + (3 + sizeRight / 4));
+                    std::iter_swap(end - 2, end - (1 + sizeRight / 4));
+                    std::iter_swap(end - 3, end - (2 + sizeRight / 4));
+                }
+            }
+        }
+        else if (partition.second && PartialInsertionSort(begin, pivotPosition, compare) && PartialInsertionSort(pivotPosition + 1, end, compare))
+            return;
+
+        PdqSortLoop(begin, pivotPosition, compare, badAllowed, leftmost);
+        begin = pivotPosition + 1;
+        leftmost = false;
+    }
+}
+
+// O(n log n) worst case, not stable, O(n) on sorted, reversed and equal ranges
+template <typename Iter, typename C = std::less<>>
+void Sort(Iter begin, Iter end, const C &compare = C())
+{
+    if (end - begin < 2)
+        return;
+
+    int log2 = 0;
+    for (size_t size = end - begin; size > 1; size /= 2)
+        log2++;
+
+    PdqSortLoop(begin, end, compare, log2);
+}
+
+/**** stable merge sort ****/
+
+// the buffered elements [first, last) not merged yet: forward from out or backward before out
+template <typename T, typename Iter>
+void MoveBack(T *first, T *last, Iter out, bool forward)
+{
+    if (forward)
+        while (first != last)
+            *out++ = std::move(*first++);
+    else
+        while (first != last)
+            *--out = std::move(*--last);
+}
+
+// merge [begin, middle) and [middle, end) through buffer (room for the shorter run, not constructed): the shorter run
+// is moved to the buffer and merged back forward (left run) or backward (right run), ties taken from the left run
+template <typename Iter, typename C>
+void MergeWithBuffer(Iter begin, Iter middle, Iter end, IteratorValue<Iter> *buffer, const C &compare)
+{
+    typedef IteratorValue<Iter> T;
+
+    if (!compare(*middle, *(middle - 1)))   // already in order
+        return;
+
+    size_t sizeLeft = middle - begin, sizeRight = end - middle;
+    bool bufferLeft = sizeLeft <= sizeRight;
+    size_t sizeBuffer = bufferLeft ? sizeLeft : sizeRight;
+    Iter from = bufferLeft ? begin : middle;
+
+    for (size_t i = 0; i < sizeBuffer; i++)
+        new(&buffer[i]) T(std::move(from[i]));
+
+    T *first = buffer, *last = buffer + sizeBuffer;   // elements still in the buffer
+    Iter out = bufferLeft ? begin : end;
+
+    try
+    {
+        if (bufferLeft)
+        {
+            Iter right = middle;
+
+            while (first != last && right != end)
+            {
+                if (compare(*right, *first))
+                    *out++ = std::move(*right++);
+                else
+                    *out++ = std::move(*first++);
+            }
+        }
+        else
+        {
+            Iter left = middle;
+
+            while (first != last && left != begin)
+            {
+                if (compare(*(last - 1), *(left - 1)))
+                    *--out = std::move(*--left);
+                else
+                    *--out = std::move(*--last);
+            }
+        }
+    }
+    catch (...)   // the elements still in the buffer go back to the free slots, none is lost
+    {
+        MoveBack(first, last, out, bufferLeft);
+
+        for (size_t i = 0; i < sizeBuffer; i++)
+            buffer[i].~T();
+
+        throw;
+    }
+
+    MoveBack(first, last, out, bufferLeft);
+
+    for (size_t i = 0; i < sizeBuffer; i++)
+        buffer[i].~T();
+}
+
+// bottom up: runs of MERGE_SORT_RUN elements are insertion sorted, then merged pairwise, ranges already in order are
+// skipped (O(n) on sorted input). the buffer holds half of the range (the shorter run of a merge)
+template <typename Iter, typename C = std::less<>>
+void StableSort(Iter begin, Iter end, const C &compare = C())
+{
+    typedef IteratorValue<Iter> T;
+
+    size_t size = end - begin;
+
+    if (size < 2)
+        return;
+
+    for (size_t run = 0; run < size; run += MERGE_SORT_RUN)
+        InsertionSort(begin + run, begin + std::min(run + MERGE_SORT_RUN, size), compare);
+
+    if (size <= MERGE_SORT_RUN)
+        return;
+
+    size_t bufferSize = (size + 1) / 2;
+    T *buffer = static_cast<T*>(DefaultAllocation::Allocate(bufferSize * sizeof(T), alignof(T)));
+
+    try
+    {
+        for (size_t width = MERGE_SORT_RUN; width < size; width *= 2)
+            for (size_t low = 0; low + width < size; low += 2 * width)
+                MergeWithBuffer(begin + low, begin + (low + width), begin + std::min(low + 2 * width, size), buffer, compare);
+    }
+    catch (...)
+    {
+        DefaultAllocation::Deallocate(buffer, bufferSize * sizeof(T), alignof(T));
+        throw;
+    }
+
+    DefaultAllocation::Deallocate(buffer, bufferSize * sizeof(T), alignof(T));
+}
+
+/**** container overloads ****/
+
+// containers whose Begin() is a random access iterator (Vector, SegmentedVector, ...), not the linked lists
+template <typename S, typename = void>
+struct IsRandomAccessSequence : std::false_type {};
+
+template <typename S>
+struct IsRandomAccessSequence<S, std::void_t<typename std::iterator_traits<decltype(std::declval<S&>().Begin())>::iterator_category>>
+    : std::is_base_of<std::random_access_iterator_tag, typename std::iterator_traits<decltype(std::declval<S&>().Begin())>::iterator_category> {};
+
+template <typename S, typename C = std::less<>, typename std::enable_if<IsRandomAccessSequence<S>::value, int>::type = 0>
+void Sort(S &sequence, const C &compare = C())
+{
+    Sort(sequence.Begin(), sequence.End(), compare);
+}
+
+template <typename S, typename C = std::less<>, typename std::enable_if<IsRandomAccessSequence<S>::value, int>::type = 0>
+void StableSort(S &sequence, const C &compare = C())
+{
+    StableSort(sequence.Begin(), sequence.End(), compare);
+}
+
+#endif  // SORT_H
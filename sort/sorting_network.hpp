@@ -0,0 +1,184 @@
+#ifndef SORTING_NETWORK_H
+#define SORTING_NETWORK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "../vector/simd_search.hpp"   // DetectSimdLevel
+
+using std::size_t;
+
+/**** sorting network for small partitions of 32 bit keys (int32, uint32, float): up to 64 elements sorted in eight AVX2
+      registers without a branch on the data, selected at run time like the search kernels ****/
+// the eight registers go through an 8 input network (each column sorted), are transposed (each register a sorted run of
+// 8) and merged pairwise by bitonic merges: 8 + 8, 16 + 16, 32 + 32. shorter inputs are padded with the largest key.
+// NaNs are not ordered (as with operator<)
+
+constexpr size_t SORTING_NETWORK_SIZE = 64;
+
+template <typename T>
+struct NetworkSortable
+{
+    static constexpr bool value = std::is_same<T, std::int32_t>::value || std::is_same<T, std::uint32_t>::value || std::is_same<T, float>::value;
+};
+
+#ifdef SIMD_SEARCH_X86
+
+template <typename T>
+__attribute__((target("avx2"))) inline __m256i NetworkMin(__m256i a, __m256i b)
+{
+    if constexpr (std::is_same<T, float>::value)
+        return _mm256_castps_si256(_mm256_min_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b)));
+    else if constexpr (std::is_signed<T>::value)
+        return _mm256_min_epi32(a, b);
+    else
+        return _mm256_min_epu32(a, b);
+}
+
+template <typename T>
+__attribute__((target("avx2"))) inline __m256i NetworkMax(__m256i a, __m256i b)
+{
+    if constexpr (std::is_same<T, float>::value)
+        return _mm256_castps_si256(_mm256_max_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b)));
+    else if constexpr (std::is_signed<T>::value)
+        return _mm256_max_epi32(a, b);
+    else
+        return _mm256_max_epu32(a, b);
+}
+
+template <typename T>
+__attribute__((target("avx2"))) inline void CompareExchange(__m256i &a, __m256i &b)
+{
+    __m256i low = NetworkMin<T>(a, b);
+    b = NetworkMax<T>(a, b);
+    a = low;
+}
+
+// sort the 8 lanes of a bitonic register: half cleaners at distance 4, 2 and 1
+template <typename T>
+__attribute__((target("avx2"))) inline __m256i BitonicClean(__m256i v)
+{
+    __m256i p = _mm256_permute2x128_si256(v, v, 0x01);
+    v = _mm256_blend_epi32(NetworkMin<T>(v, p), NetworkMax<T>(v, p), 0xF0);
+
+    p = _mm256_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+    v = _mm256_blend_epi32(NetworkMin<T>(v, p), NetworkMax<T>(v, p), 0xCC);
+
+    p = _mm256_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1));
+    return _mm256_blend_epi32(NetworkMin<T>(v, p), NetworkMax<T>(v, p), 0xAA);
+}
+
+__attribute__((target("avx2"))) inline __m256i ReverseLanes(__m256i v)
+{
+    return _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+}
+
+// merge the sorted runs r[0, n) and r[n, 2n) of n registers each into one sorted run of 2n registers
+template <typename T>
+__attribute__((target("avx2"))) inline void BitonicMerge(__m256i *r, int n)
+{
+    // reversing the second run makes the whole sequence bitonic, the first half cleaner splits it in two bitonic halves
+    for (int i = 0; i < (n + 1) / 2; i++)
+    {
+        __m256i reversed = ReverseLanes(r[2 * n - 1 - i]);
+        r[2 * n - 1 - i] = ReverseLanes(r[n + i]);
+        r[n + i] = reversed;
+    }
+
+    for (int i = 0; i < n; i++)
+        CompareExchange<T>(r[i], r[n + i]);
+
+    // half cleaners between registers, then inside every register
+    for (int half = 0; half < 2; half++)
+    {
+        __m256i *run = r + half * n;
+
+        for (int distance = n / 2; distance > 0; distance /= 2)
+            for (int i = 0; i < n; i++)
+                if ((i & distance) == 0)
+                    CompareExchange<T>(run[i], run[i + distance]);
+
+        for (int i = 0; i < n; i++)
+            run[i] = BitonicClean<T>(run[i]);
+    }
+}
+
+template <typename T>
+__attribute__((target("avx2"))) void Avx2SortingNetwork(T *data, size_t size)
+{
+    alignas(32) T keys[SORTING_NETWORK_SIZE];
+
+    for (size_t i = 0; i < size; i++)
+        keys[i] = data[i];
+
+    T padding = std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity() : std::numeric_limits<T>::max();
+    for (size_t i = size; i < SORTING_NETWORK_SIZE; i++)
+        keys[i] = padding;
+
+    __m256i r[8];
+    for (int i = 0; i < 8; i++)
+        r[i] = _mm256_load_si256(reinterpret_cast<const __m256i *>(keys) + i);
+
+    // 19 comparator network on 8 inputs (every column)
+    static const int NETWORK[19][2] = {{0, 2}, {1, 3}, {4, 6}, {5, 7}, {0, 4}, {1, 5}, {2, 6}, {3, 7}, {0, 1}, {2, 3},
+                                       {4, 5}, {6, 7}, {2, 4}, {3, 5}, {1, 4}, {3, 6}, {1, 2}, {3, 4}, {5, 6}};
+
+    for (int i = 0; i < 19; i++)
+        CompareExchange<T>(r[NETWORK[i][0]], r[NETWORK[i][1]]);
+
+    // transpose the 8 x 8 block: register i gets column i
+    __m256i t[8], u[8];
+
+    for (int i = 0; i < 8; i += 2)
+    {
+        t[i] = _mm256_unpacklo_epi32(r[i], r[i + 1]);
+        t[i + 1] = _mm256_unpackhi_epi32(r[i], r[i + 1]);
+    }
+
+    for (int i = 0; i < 8; i += 4)
+    {
+        u[i] = _mm256_unpacklo_epi64(t[i], t[i + 2]);
+        u[i + 1] = _mm256_unpackhi_epi64(t[i], t[i + 2]);
+        u[i + 2] = _mm256_unpacklo_epi64(t[i + 1], t[i + 3]);
+        u[i + 3] = _mm256_unpackhi_epi64(t[i + 1], t[i + 3]);
+    }
+
+    for (int i = 0; i < 4; i++)
+    {
+        r[i] = _mm256_permute2x128_si256(u[i], u[i + 4], 0x20);
+        r[i + 4] = _mm256_permute2x128_si256(u[i], u[i + 4], 0x31);
+    }
+
+    for (int n = 1; n < 8; n *= 2)
+        for (int i = 0; i < 8; i += 2 * n)
+            BitonicMerge<T>(r + i, n);
+
+    for (int i = 0; i < 8; i++)
+        _mm256_store_si256(reinterpret_cast<__m256i *>(keys) + i, r[i]);
+
+    for (size_t i = 0; i < size; i++)
+        data[i] = keys[i];
+}
+
+#endif  // SIMD_SEARCH_X86
+
+// sort size <= SORTING_NETWORK_SIZE keys in ascending order, false (nothing done) when the cpu has no AVX2
+template <typename T>
+bool SortingNetwork(T *data, size_t size)
+{
+    static_assert(NetworkSortable<T>::value, "32 bit keys only");
+
+#ifdef SIMD_SEARCH_X86
+    if (DetectSimdLevel() == SimdLevel::AVX2)
+    {
+        Avx2SortingNetwork(data, size);
+        return true;
+    }
+#endif
+
+    return false;
+}
+
+#endif  // SORTING_NETWORK_H
@@ -1,6 +1,7 @@
 #include "vector.hpp"
 #include <string>
 
+#include "../huge_page_allocation.hpp"
 #include "../bubble_sort.hpp"
 #include "../print_sequence.hpp"
 #include "../sequence_reverse.hpp"
@@ -184,5 +185,13 @@ int main(int argc, char *argv[])
         std::cout << i << " ";
     std::cout << std::endl;
 
+    // cache line aligned storage, huge pages for the large arrays
+    Vector<float, AlignedAllocation<64>> aligned = {1.0f, 2.0f, 3.0f};
+    PrintSequence(aligned);
+
+    Vector<double, HugePageAllocation<>> large;
+    large.Resize(1 << 20, 0.5);
+    std::cout << large.Count(0.5) << std::endl;
+
     return 0;
 }
\ No newline at end of file
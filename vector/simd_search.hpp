@@ -0,0 +1,406 @@
+#ifndef SIMD_SEARCH_H
+#define SIMD_SEARCH_H
+
+#include <cstddef>
+#include <type_traits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_SEARCH_X86
+#include <immintrin.h>
+#endif
+
+using std::size_t;
+
+/**** linear searches over arrays of arithmetic types: AVX2 or SSE4.1 kernels selected at run time from the cpu features
+      (the binary does not need to be compiled for them), scalar loops elsewhere ****/
+// the kernels compare 4 vectors (128 bytes with AVX2) per iteration and only look at individual lanes once a block has a
+// match, so long scans are bound by memory bandwidth. equality follows operator== (NaN never matches, -0.0 matches 0.0)
+
+template <typename T>
+struct SimdSearchable   // types with a vector kernel
+{
+    static constexpr bool value = std::is_arithmetic<T>::value && (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8)
+                                  && !std::is_same<T, long double>::value;
+};
+
+enum class SimdLevel
+{
+    SCALAR,
+    SSE4,
+    AVX2
+};
+
+inline SimdLevel DetectSimdLevel()
+{
+#ifdef SIMD_SEARCH_X86
+    static const SimdLevel level = __builtin_cpu_supports("avx2") ? SimdLevel::AVX2 : __builtin_cpu_supports("sse4.1") ? SimdLevel::SSE4 : SimdLevel::SCALAR;
+    return level;
+#else
+    return SimdLevel::SCALAR;
+#endif
+}
+
+/**** scalar kernels (fallback and tails) ****/
+
+template <typename T>
+size_t ScalarFind(const T *data, size_t size, T key)
+{
+    for (size_t i = 0; i < size; i++)
+        if (data[i] == key)
+            return i;
+
+    return size;
+}
+
+template <typename T>
+size_t ScalarCount(const T *data, size_t size, T key)
+{
+    size_t count = 0;
+
+    for (size_t i = 0; i < size; i++)
+        count += data[i] == key;
+
+    return count;
+}
+
+template <typename T>
+size_t ScalarFindAll(const T *data, size_t size, T key, size_t *indices)
+{
+    size_t count = 0;
+
+    for (size_t i = 0; i < size; i++)
+        if (data[i] == key)
+            indices[count++] = i;
+
+    return count;
+}
+
+#ifdef SIMD_SEARCH_X86
+
+/**** AVX2 kernels: every compare gives a byte mask (sizeof(T) bits per lane) ****/
+
+template <typename T>
+__attribute__((target("avx2"))) inline __m256i Broadcast256(T key)
+{
+    if constexpr (std::is_same<T, float>::value)
+        return _mm256_castps_si256(_mm256_set1_ps(key));
+    else if constexpr (std::is_same<T, double>::value)
+        return _mm256_castpd_si256(_mm256_set1_pd(key));
+    else if constexpr (sizeof(T) == 1)
+        return _mm256_set1_epi8(static_cast<char>(key));
+    else if constexpr (sizeof(T) == 2)
+        return _mm256_set1_epi16(static_cast<short>(key));
+    else if constexpr (sizeof(T) == 4)
+        return _mm256_set1_epi32(static_cast<int>(key));
+    else
+        return _mm256_set1_epi64x(static_cast<long long>(key));
+}
+
+template <typename T>
+__attribute__((target("avx2"))) inline unsigned int EqualMask256(const T *data, __m256i keys)
+{
+    __m256i equal;
+
+    if constexpr (std::is_same<T, float>::value)
+        equal = _mm256_castps_si256(_mm256_cmp_ps(_mm256_loadu_ps(data), _mm256_castsi256_ps(keys), _CMP_EQ_OQ));
+    else if constexpr (std::is_same<T, double>::value)
+        equal = _mm256_castpd_si256(_mm256_cmp_pd(_mm256_loadu_pd(data), _mm256_castsi256_pd(keys), _CMP_EQ_OQ));
+    else
+    {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data));
+
+        if constexpr (sizeof(T) == 1)
+            equal = _mm256_cmpeq_epi8(block, keys);
+        else if constexpr (sizeof(T) == 2)
+            equal = _mm256_cmpeq_epi16(block, keys);
+        else if constexpr (sizeof(T) == 4)
+            equal = _mm256_cmpeq_epi32(block, keys);
+        else
+            equal = _mm256_cmpeq_epi64(block, keys);
+    }
+
+    return static_cast<unsigned int>(_mm256_movemask_epi8(equal));
+}
+
+template <typename T>
+__attribute__((target("avx2,popcnt"))) size_t Avx2Find(const T *data, size_t size, T key)
+{
+    constexpr size_t LANES = 32 / sizeof(T);
+    __m256i keys = Broadcast256(key);
+    size_t i = 0;
+
+    for (; i + 4 * LANES <= size; i += 4 * LANES)
+    {
+        unsigned int masks[4] = {EqualMask256(data + i, keys), EqualMask256(data + i + LANES, keys),
+                                 EqualMask256(data + i + 2 * LANES, keys), EqualMask256(data + i + 3 * LANES, keys)};
+
+        if (masks[0] | masks[1] | masks[2] | masks[3])
+            for (unsigned int j = 0; j < 4; j++)
+                if (masks[j])
+                    return i + j * LANES + __builtin_ctz(masks[j]) / sizeof(T);
+    }
+
+    for (; i + LANES <= size; i += LANES)
+        if (unsigned int mask = EqualMask256(data + i, keys))
+            return i + __builtin_ctz(mask) / sizeof(T);
+
+    return i + ScalarFind(data + i, size - i, key);
+}
+
+template <typename T>
+__attribute__((target("avx2,popcnt"))) size_t Avx2Count(const T *data, size_t size, T key)
+{
+    constexpr size_t LANES = 32 / sizeof(T);
+    __m256i keys = Broadcast256(key);
+    size_t i = 0, bits = 0;
+
+    for (; i + 4 * LANES <= size; i += 4 * LANES)
+        bits += __builtin_popcount(EqualMask256(data + i, keys)) + __builtin_popcount(EqualMask256(data + i + LANES, keys))
+                + __builtin_popcount(EqualMask256(data + i + 2 * LANES, keys)) + __builtin_popcount(EqualMask256(data + i + 3 * LANES, keys));
+
+    for (; i + LANES <= size; i += LANES)
+        bits += __builtin_popcount(EqualMask256(data + i, keys));
+
+    return bits / sizeof(T) + ScalarCount(data + i, size - i, key);
+}
+
+template <typename T>
+__attribute__((target("avx2,popcnt"))) size_t Avx2FindAll(const T *data, size_t size, T key, size_t *indices)
+{
+    constexpr size_t LANES = 32 / sizeof(T);
+    __m256i keys = Broadcast256(key);
+    size_t i = 0, count = 0;
+
+    for (; i + LANES <= size; i += LANES)
+        for (unsigned int mask = EqualMask256(data + i, keys); mask; mask &= mask - 1)
+        {
+            unsigned int byte = __builtin_ctz(mask);
+
+            indices[count++] = i + byte / sizeof(T);
+            mask &= ~((1U << (byte + sizeof(T) - 1)) - 1);   // all the bytes of the lane (the last one is cleared by the loop)
+        }
+
+    for (; i < size; i++)
+        if (data[i] == key)
+            indices[count++] = i;
+
+    return count;
+}
+
+/**** SSE4.1 kernels (same structure, 16 byte vectors) ****/
+
+template <typename T>
+__attribute__((target("sse4.1"))) inline __m128i Broadcast128(T key)
+{
+    if constexpr (std::is_same<T, float>::value)
+        return _mm_castps_si128(_mm_set1_ps(key));
+    else if constexpr (std::is_same<T, double>::value)
+        return _mm_castpd_si128(_mm_set1_pd(key));
+    else if constexpr (sizeof(T) == 1)
+        return _mm_set1_epi8(static_cast<char>(key));
+    else if constexpr (sizeof(T) == 2)
+        return _mm_set1_epi16(static_cast<short>(key));
+    else if constexpr (sizeof(T) == 4)
+        return _mm_set1_epi32(static_cast<int>(key));
+    else
+        return _mm_set1_epi64x(static_cast<long long>(key));
+}
+
+template <typename T>
+__attribute__((target("sse4.1"))) inline unsigned int EqualMask128(const T *data, __m128i keys)
+{
+    __m128i equal;
+
+    if constexpr (std::is_same<T, float>::value)
+        equal = _mm_castps_si128(_mm_cmpeq_ps(_mm_loadu_ps(data), _mm_castsi128_ps(keys)));
+    else if constexpr (std::is_same<T, double>::value)
+        equal = _mm_castpd_si128(_mm_cmpeq_pd(_mm_loadu_pd(data), _mm_castsi128_pd(keys)));
+    else
+    {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+
+        if constexpr (sizeof(T) == 1)
+            equal = _mm_cmpeq_epi8(block, keys);
+        else if constexpr (sizeof(T) == 2)
+            equal = _mm_cmpeq_epi16(block, keys);
+        else if constexpr (sizeof(T) == 4)
+            equal = _mm_cmpeq_epi32(block, keys);
+        else
+            equal = _mm_cmpeq_epi64(block, keys);
+    }
+
+    return static_cast<unsigned int>(_mm_movemask_epi8(equal));
+}
+
+template <typename T>
+__attribute__((target("sse4.1,popcnt"))) size_t Sse4Find(const T *data, size_t size, T key)
+{
+    constexpr size_t LANES = 16 / sizeof(T);
+    __m128i keys = Broadcast128(key);
+    size_t i = 0;
+
+    for (; i + 4 * LANES <= size; i += 4 * LANES)
+    {
+        unsigned int masks[4] = {EqualMask128(data + i, keys), EqualMask128(data + i + LANES, keys),
+                                 EqualMask128(data + i + 2 * LANES, keys), EqualMask128(data + i + 3 * LANES, keys)};
+
+        if (masks[0] | masks[1] | masks[2] | masks[3])
+            for (unsigned int j = 0; j < 4; j++)
+                if (masks[j])
+                    return i + j * LANES + __builtin_ctz(masks[j]) / sizeof(T);
+    }
+
+    for (; i + LANES <= size; i += LANES)
+        if (unsigned int mask = EqualMask128(data + i, keys))
+            return i + __builtin_ctz(mask) / sizeof(T);
+
+    return i + ScalarFind(data + i, size - i, key);
+}
+
+template <typename T>
+__attribute__((target("sse4.1,popcnt"))) size_t Sse4Count(const T *data, size_t size, T key)
+{
+    constexpr size_t LANES = 16 / sizeof(T);
+    __m128i keys = Broadcast128(key);
+    size_t i = 0, bits = 0;
+
+    for (; i + 4 * LANES <= size; i += 4 * LANES)
+        bits += __builtin_popcount(EqualMask128(data + i, keys)) + __builtin_popcount(EqualMask128(data + i + LANES, keys))
+                + __builtin_popcount(EqualMask128(data + i + 2 * LANES, keys)) + __builtin_popcount(EqualMask128(data + i + 3 * LANES, keys));
+
+    for (; i + LANES <= size; i += LANES)
+        bits += __builtin_popcount(EqualMask128(data + i, keys));
+
+    return bits / sizeof(T) + ScalarCount(data + i, size - i, key);
+}
+
+template <typename T>
+__attribute__((target("sse4.1,popcnt"))) size_t Sse4FindAll(const T *data, size_t size, T key, size_t *indices)
+{
+    constexpr size_t LANES = 16 / sizeof(T);
+    __m128i keys = Broadcast128(key);
+    size_t i = 0, count = 0;
+
+    for (; i + LANES <= size; i += LANES)
+        for (unsigned int mask = EqualMask128(data + i, keys); mask; mask &= mask - 1)
+        {
+            unsigned int byte = __builtin_ctz(mask);
+
+            indices[count++] = i + byte / sizeof(T);
+            mask &= ~((1U << (byte + sizeof(T) - 1)) - 1);
+        }
+
+    for (; i < size; i++)
+        if (data[i] == key)
+            indices[count++] = i;
+
+    return count;
+}
+
+#endif  // SIMD_SEARCH_X86
+
+/**** dispatching entry points ****/
+
+// index of the first element equal to key, size if none
+template <typename T>
+size_t SimdFind(const T *data, size_t size, T key)
+{
+    static_assert(SimdSearchable<T>::value, "arithmetic types only");
+
+#ifdef SIMD_SEARCH_X86
+    switch (DetectSimdLevel())
+    {
+    case SimdLevel::AVX2:
+        return Avx2Find(data, size, key);
+    case SimdLevel::SSE4:
+        return Sse4Find(data, size, key);
+    default:
+        break;
+    }
+#endif
+
+    return ScalarFind(data, size, key);
+}
+
+template <typename T>
+size_t SimdCount(const T *data, size_t size, T key)
+{
+    static_assert(SimdSearchable<T>::value, "arithmetic types only");
+
+#ifdef SIMD_SEARCH_X86
+    switch (DetectSimdLevel())
+    {
+    case SimdLevel::AVX2:
+        return Avx2Count(data, size, key);
+    case SimdLevel::SSE4:
+        return Sse4Count(data, size, key);
+    default:
+        break;
+    }
+#endif
+
+    return ScalarCount(data, size, key);
+}
+
+// write the indices of all the elements equal to key (in increasing order) and return their number, indices must have
+// room for every match (size entries in the worst case)
+template <typename T>
+size_t SimdFindAll(const T *data, size_t size, T key, size_t *indices)
+{
+    static_assert(SimdSearchable<T>::value, "arithmetic types only");
+
+#ifdef SIMD_SEARCH_X86
+    switch (DetectSimdLevel())
+    {
+    case SimdLevel::AVX2:
+        return Avx2FindAll(data, size, key, indices);
+    case SimdLevel::SSE4:
+        return Sse4FindAll(data, size, key, indices);
+    default:
+        break;
+    }
+#endif
+
+    return ScalarFindAll(data, size, key, indices);
+}
+
+// index of the first element satisfying predicate, size if none: the predicate is evaluated on blocks of 64 elements
+// without early exit (branch free, vectorized by the compiler for simple predicates), the first hit is located afterwards.
+// unlike a plain loop the predicate is called on up to 63 elements past the first hit, and twice on the elements of the
+// block up to the hit: only for cheap predicates without side effects
+template <typename T, typename P>
+size_t BlockFindIf(const T *data, size_t size, const P &predicate)
+{
+    constexpr size_t BLOCK = 64;
+    size_t i = 0;
+
+    for (; i + BLOCK <= size; i += BLOCK)
+    {
+        bool any = false;
+
+        for (size_t j = 0; j < BLOCK; j++)
+            any |= static_cast<bool>(predicate(data[i + j]));
+
+        if (any)
+            break;
+    }
+
+    for (; i < size; i++)
+        if (predicate(data[i]))
+            return i;
+
+    return size;
+}
+
+template <typename T, typename P>
+size_t BlockCountIf(const T *data, size_t size, const P &predicate)
+{
+    size_t count = 0;
+
+    for (size_t i = 0; i < size; i++)   // branch free sum, vectorized by the compiler for simple predicates
+        count += static_cast<bool>(predicate(data[i]));
+
+    return count;
+}
+
+#endif  // SIMD_SEARCH_H
@@ -1,26 +1,48 @@
 #ifndef VECTOR_H
 #define VECTOR_H
 
+#include <algorithm>
 #include <cstddef>
+#include <cstring>
+#include <iterator>
 #include <utility>
 #include <exception>
 #include <initializer_list>
 #include <type_traits>
 
+#include "simd_search.hpp"
+#include "../allocation_policy.hpp"
+
 using std::size_t;
 
 class IndexOutOfBoundsException : public std::exception {};
 
-template <typename T>
+template <typename T, typename A = DefaultAllocation>   // A: allocation policy (allocation_policy.hpp)
 class Vector;
 
+// types whose objects can be moved to another address with a plain memory copy (the source is then forgotten without
+// destructor call), specialize for types owning resources through pointers to outside of the object
 template <typename T>
-void swap(Vector<T> &a, Vector<T> &b)
+struct IsTriviallyRelocatable : std::is_trivially_copyable<T> {};
+
+template <typename T, typename A>
+struct IsTriviallyRelocatable<Vector<T, A>> : std::true_type {};
+
+// iterators that can be traversed twice (the length of a range is known before inserting it)
+template <typename Iter, typename = void>
+struct IsForwardIterator : std::false_type {};
+
+template <typename Iter>
+struct IsForwardIterator<Iter, std::void_t<typename std::iterator_traits<Iter>::iterator_category>>
+    : std::is_base_of<std::forward_iterator_tag, typename std::iterator_traits<Iter>::iterator_category> {};
+
+template <typename T, typename A>
+void swap(Vector<T, A> &a, Vector<T, A> &b)
 {
     a.Swap(b);
 }
 
-template <typename T>
+template <typename T, typename A>
 class Vector
 {
 public:
@@ -31,20 +53,20 @@ public:
     Vector(size_t size);
     Vector(const Vector &other);
     template <typename U>
-    Vector(const Vector<U> &other);
+    Vector(const Vector<U, A> &other);
     Vector(Vector &&other);
     template <typename U>
-    Vector(Vector<U> &&other);
+    Vector(Vector<U, A> &&other);
     Vector(std::initializer_list<T> initList);    // sequence ctor
 
     ~Vector() { if (mArray) Clear(); }
 
     Vector &operator=(const Vector &other);
     template <typename U>
-    Vector &operator=(const Vector<U> &other);
+    Vector &operator=(const Vector<U, A> &other);
     Vector &operator=(Vector &&other);
     template <typename U>
-    Vector &operator=(Vector<U> &&other);
+    Vector &operator=(Vector<U, A> &&other);
 
     void Swap(Vector &other);
 
@@ -76,25 +98,29 @@ public:
     Iterator Insert(Iterator pos, U &&element);             // insert element before pos and return iterator after inserted element
     template <typename Iter>
     Iterator Insert(Iterator pos, Iter begin, Iter end);    // insert iterator range before pos and return iterator after last inserted element
+    template <typename Iter>
+    void Append(Iter begin, Iter end) { Insert(End(), begin, end); }
+    void Append(const T *elements, size_t count) { Insert(End(), elements, elements + count); }
     
-    template <typename... Args, typename U = T, typename = typename std::enable_if<std::is_aggregate<U>::value>::type>
-    void Emplace(int index, Args&&... args);
-    template <typename... Args, typename U = T, typename = typename std::enable_if<!std::is_aggregate<U>::value>::type, typename = void>
+    // construct the element in place from args (T(args...), or T{args...} for aggregates)
+    template <typename... Args>
     void Emplace(int index, Args&&... args);
     template <typename... Args>
-    void EmplaceFirst(Args&&... args) { Emplace(0, std::forward<Args>(args)...); }
+    void EmplaceFirst(Args&&... args) { EmplaceAt(0, std::forward<Args>(args)...); }
     template <typename... Args>
-    void EmplaceLast(Args&&... args) { Emplace(mNumElements, std::forward<Args>(args)...); }
-    template <typename... Args, typename U = T, typename = typename std::enable_if<std::is_aggregate<U>::value>::type>
-    Iterator Emplace(Iterator pos, Args&&... args);
-    template <typename... Args, typename U = T, typename = typename std::enable_if<!std::is_aggregate<U>::value>::type, typename = void>
-    Iterator Emplace(Iterator pos, Args&&... args);
+    void EmplaceLast(Args&&... args) { EmplaceAt(mNumElements, std::forward<Args>(args)...); }
+    template <typename... Args>
+    void EmplaceLastUnchecked(Args&&... args) { Construct(mArray + mNumElements, std::forward<Args>(args)...); mNumElements++; }   // capacity must be reserved
+    template <typename... Args>
+    Iterator Emplace(Iterator pos, Args&&... args);   // return iterator after emplaced element
 
     void Remove(int index);
     void RemoveFirst() { Remove(0); }
     void RemoveLast() { Remove(mNumElements - 1); }
     Iterator Remove(Iterator pos);
-    Iterator Remove(Iterator begin, Iterator end);
+    Iterator Remove(Iterator begin, Iterator end);   // return iterator to the element that followed the removed range
+    template <typename P>
+    size_t RemoveIf(const P &predicate);             // remove the elements satisfying predicate (order kept), return their number
 
     T &operator[](int index) { return const_cast<T&>(static_cast<Vector const&>(*this)[index]); }
     const T &operator[](int index) const { return mArray[index]; }
@@ -106,44 +132,71 @@ public:
     Iterator AtIndex(size_t index) const { return &mArray[index]; }
     int IndexOf(ConstIterator iterator) { return iterator - mArray; }
 
-    Iterator Find(const T &key) { return const_cast<Iterator>(const_cast<Vector<T> const&>(*this).Find(key)); }
+    // linear searches, vectorized for arithmetic types (see simd_search.hpp)
+    Iterator Find(const T &key) { return const_cast<Iterator>(const_cast<Vector const&>(*this).Find(key)); }
     ConstIterator Find(const T &key) const;
+    // arithmetic T: the predicate is called on whole blocks of 64 elements, also past the match (keep it cheap and free of side effects)
+    template <typename P>
+    Iterator FindIf(const P &predicate) { return const_cast<Iterator>(const_cast<Vector const&>(*this).FindIf(predicate)); }
+    template <typename P>
+    ConstIterator FindIf(const P &predicate) const;
+    bool Contains(const T &key) const { return Find(key) != End(); }
+    size_t Count(const T &key) const;
+    template <typename P>
+    size_t CountIf(const P &predicate) const;
+    Vector<size_t> FindAll(const T &key) const;   // indices of all the elements equal to key
 private:
     T *mArray;
     size_t mCapacity;
     size_t mNumElements;
+
+    static T *Allocate(size_t capacity) { return static_cast<T*>(A::Allocate(capacity * sizeof(T), alignof(T))); }
+    static void Deallocate(T *array, size_t capacity) { A::Deallocate(array, capacity * sizeof(T), alignof(T)); }
+
+    template <typename... Args>
+    static void Construct(T *address, Args&&... args);
+
+    // move count elements to (possibly overlapping) uninitialized storage and end the source objects: one memmove for
+    // trivially relocatable types, move construction and destruction in a safe order otherwise
+    static void Relocate(T *to, T *from, size_t count);
+
+    template <typename... Args>
+    T *EmplaceAt(size_t index, Args&&... args);
+
+    template <typename Iter>
+    static void ConstructRange(T *to, Iter begin, size_t count);   // all or nothing
 };
 
 // begin and end functions (to use in range-for loop)
-template <typename T>
-typename Vector<T>::Iterator begin(Vector<T> &vector)
+template <typename T, typename A>
+typename Vector<T, A>::Iterator begin(Vector<T, A> &vector)
 {
     return vector.Begin();
 }
 
-template <typename T>
-typename Vector<T>::Iterator end(Vector<T> &vector)
+template <typename T, typename A>
+typename Vector<T, A>::Iterator end(Vector<T, A> &vector)
 {
     return vector.End();
 }
 
-template <typename T>
-typename Vector<T>::ConstIterator begin(const Vector<T> &vector)
+template <typename T, typename A>
+typename Vector<T, A>::ConstIterator begin(const Vector<T, A> &vector)
 {
     return vector.Begin();
 }
 
-template <typename T>
-typename Vector<T>::ConstIterator end(const Vector<T> &vector)
+template <typename T, typename A>
+typename Vector<T, A>::ConstIterator end(const Vector<T, A> &vector)
 {
     return vector.End();
 }
 
-template <typename T>
-Vector<T>::Vector(size_t size)
+template <typename T, typename A>
+Vector<T, A>::Vector(size_t size)
 {
-    // allocate untyped memory for array (operator new)
-    void *rawMemory = operator new(size * sizeof(T));
+    // allocate untyped memory for array (allocation policy)
+    void *rawMemory = Allocate(size);
 
     // construct elements in-place (placement-new)
     for (size_t i = 0; i < size; i++)
@@ -155,11 +208,11 @@ Vector<T>::Vector(size_t size)
     mNumElements = size;
 }
 
-template <typename T>
-Vector<T>::Vector(const Vector &other)
+template <typename T, typename A>
+Vector<T, A>::Vector(const Vector &other)
 {
-    // allocate untyped memory for array (operator new)
-    void *rawMemory = operator new(other.mCapacity * sizeof(T));
+    // allocate untyped memory for array (allocation policy)
+    void *rawMemory = Allocate(other.mCapacity);
 
     // copy elements (placement-new)
     for (size_t i = 0; i < other.mNumElements; i++)
@@ -171,12 +224,12 @@ Vector<T>::Vector(const Vector &other)
     mNumElements = other.mNumElements;
 }
 
-template <typename T>
+template <typename T, typename A>
 template <typename U>
-Vector<T>::Vector(const Vector<U> &other)
+Vector<T, A>::Vector(const Vector<U, A> &other)
 {
-    // allocate untyped memory for array (operator new)
-    void *rawMemory = operator new(other.mCapacity * sizeof(T));
+    // allocate untyped memory for array (allocation policy)
+    void *rawMemory = Allocate(other.mCapacity);
 
     // copy elements (placement-new)
     for (size_t i = 0; i < other.mNumElements; i++)
@@ -188,8 +241,8 @@ Vector<T>::Vector(const Vector<U> &other)
     mNumElements = other.mNumElements;
 }
 
-template <typename T>  // "steal" moved from vector resources
-Vector<T>::Vector(Vector &&other) : mArray(other.mArray), mCapacity(other.mCapacity), mNumElements(other.mNumElements)
+template <typename T, typename A>  // "steal" moved from vector resources
+Vector<T, A>::Vector(Vector &&other) : mArray(other.mArray), mCapacity(other.mCapacity), mNumElements(other.mNumElements)
 {
     // moved-from state is the state of the default constructor
     other.mArray = nullptr;    
@@ -197,12 +250,12 @@ Vector<T>::Vector(Vector &&other) : mArray(other.mArray), mCapacity(other.mCapac
     other.mNumElements = 0U;
 }
 
-template <typename T>
+template <typename T, typename A>
 template <typename U>
-Vector<T>::Vector(Vector<U> &&other) 
+Vector<T, A>::Vector(Vector<U, A> &&other) 
 {
-    // allocate untyped memory for array (operator new)
-    void  *rawMemory = operator new(other.mCapacity * sizeof(T));
+    // allocate untyped memory for array (allocation policy)
+    void  *rawMemory = Allocate(other.mCapacity);
 
     // move elements (placement-new)
     for (size_t i = 0; i < other.mNumElements; i++)
@@ -217,8 +270,8 @@ Vector<T>::Vector(Vector<U> &&other)
     other.mArray = nullptr;
 }
 
-template <typename T>
-Vector<T>::Vector(std::initializer_list<T> initList) : mArray(nullptr), mCapacity(0), mNumElements(0)
+template <typename T, typename A>
+Vector<T, A>::Vector(std::initializer_list<T> initList) : mArray(nullptr), mCapacity(0), mNumElements(0)
 {
     Reserve(initList.size());
 
@@ -226,8 +279,8 @@ Vector<T>::Vector(std::initializer_list<T> initList) : mArray(nullptr), mCapacit
         InsertLast(element);
 }
 
-template <typename T>
-void Vector<T>::Clear()
+template <typename T, typename A>
+void Vector<T, A>::Clear()
 {
     // destroy elements
     for (size_t i = 0; i < mNumElements; i++)
@@ -236,48 +289,54 @@ void Vector<T>::Clear()
     mNumElements = 0;
 
     // free allocated memory
-    operator delete(mArray);
+    Deallocate(mArray, mCapacity);
 
     mArray = nullptr;
     mCapacity = 0;
 }
 
-template <typename T>
-void Vector<T>::Resize(size_t size, const T &element)
+template <typename T, typename A>
+void Vector<T, A>::Resize(size_t size, const T &element)
 {
-    if (size == mNumElements)
+    if (size > mCapacity && &element >= mArray && &element < mArray + mNumElements)   // element would not survive the reallocation
+    {
+        T copy(element);
+        Resize(size, copy);
         return;
-    else if (size > mNumElements)
+    }
+
+    if (size > mNumElements)
+    {
+        if (size > mCapacity)
+            Reserve(size > 2 * mCapacity ? size : 2 * mCapacity);   // geometric growth when resizing one element at a time
+
+        for (; mNumElements < size; mNumElements++)
+            new(&mArray[mNumElements]) T(element);
+    }
+    else  // size <= mNumElements
     {
-        size_t diff = size - mNumElements;
+        if constexpr (!std::is_trivially_destructible<T>::value)
+            for (size_t i = size; i < mNumElements; i++)
+                mArray[i].~T();
 
-        while (diff--)
-            InsertLast(element);
+        mNumElements = size;
     }
-    else  // size < mNumElements
-        while (mNumElements > size)
-            RemoveLast();
 }
 
-template <typename T>
-void Vector<T>::Reserve(size_t size)
+template <typename T, typename A>
+void Vector<T, A>::Reserve(size_t size)
 {
     if (mCapacity >= size)
         return;
 
     // allocate new array (sizeof(T) * size bytes)
-    void *rawMem = operator new(size * sizeof(T));
-
-    // move elements to new array
-    for (size_t i = 0; i < mNumElements; i++)
-        new(&static_cast<T*>(rawMem)[i]) T(std::move(mArray[i]));  // placement-new + std::move
+    void *rawMem = Allocate(size);
 
-    // destroy old elements
-    for (size_t i = 0; i < mNumElements; i++)
-        mArray[i].~T();
+    // relocate elements to new array
+    Relocate(static_cast<T*>(rawMem), mArray, mNumElements);
 
     // free old array
-    operator delete(mArray);
+    Deallocate(mArray, mCapacity);
 
     // set new array
     mArray = static_cast<T*>(rawMem);
@@ -286,8 +345,8 @@ void Vector<T>::Reserve(size_t size)
     mCapacity = size;
 }
 
-template <typename T>
-void Vector<T>::Swap(Vector &other)
+template <typename T, typename A>
+void Vector<T, A>::Swap(Vector &other)
 {
     using std::swap;
 
@@ -310,8 +369,8 @@ void Vector<T>::Swap(Vector &other)
     // other.mNumElements = tempNumElements;
 }
 
-template <typename T>
-Vector<T> &Vector<T>::operator=(const Vector &other)
+template <typename T, typename A>
+Vector<T, A> &Vector<T, A>::operator=(const Vector &other)
 {
     // copy and swap
     Vector temp(other);  // copy
@@ -320,229 +379,388 @@ Vector<T> &Vector<T>::operator=(const Vector &other)
     return *this;
 }
 
-template <typename T>
+template <typename T, typename A>
 template <typename U>
-Vector<T> &Vector<T>::operator=(const Vector<U> &other)
+Vector<T, A> &Vector<T, A>::operator=(const Vector<U, A> &other)
 {
     // copy and swap
-    Vector<T> temp(other);  // generalized copy constructor
+    Vector<T, A> temp(other);  // generalized copy constructor
     Swap(temp);             // swap
 
     return *this;
 }
 
-template <typename T>
-Vector<T> &Vector<T>::operator=(Vector &&other)
+template <typename T, typename A>
+Vector<T, A> &Vector<T, A>::operator=(Vector &&other)
 {
     Swap(other);
 
     return *this;
 }
 
-template <typename T>
+template <typename T, typename A>
 template <typename U>
-Vector<T> &Vector<T>::operator=(Vector<U> &&other)
+Vector<T, A> &Vector<T, A>::operator=(Vector<U, A> &&other)
 {
-    Vector<T> temp(std::move(other));  // generalized move constructor
+    Vector<T, A> temp(std::move(other));  // generalized move constructor
     Swap(temp);                        // swap
 
     return *this;
 }
 
-template <typename T>
+template <typename T, typename A>
 template <typename U>
-void Vector<T>::Insert(int index, U &&element)   
+void Vector<T, A>::Insert(int index, U &&element)   
 {
     if (index < 0 || index > mNumElements)  
         throw IndexOutOfBoundsException();
 
-    if (mNumElements >= mCapacity)
-        Reserve(mCapacity == 0 ? 1 : mCapacity * 2);
+    EmplaceAt(index, std::forward<U>(element));   // copy/move-construct element
+}
+
+template <typename T, typename A>
+template <typename U>
+typename Vector<T, A>::Iterator Vector<T, A>::Insert(Iterator pos, U &&element)
+{
+    return EmplaceAt(pos - mArray, std::forward<U>(element)) + 1;   // copy/move-construct element
+}
+
+// one relocation of the tail for ranges of known length (single pass ranges are appended and rotated into place)
+template <typename T, typename A>
+template <typename Iter>
+typename Vector<T, A>::Iterator Vector<T, A>::Insert(Iterator pos, Iter begin, Iter end)
+{
+    size_t index = pos - mArray;
 
-    if (index == mNumElements)  // if insert last or vector empty
-        new(&mArray[index]) T(std::forward<U>(element));   // copy/move-construct element (placement-new)
-    else 
+    if constexpr (!IsForwardIterator<Iter>::value)
     {
-        // move-construct new last element 
-        new(&mArray[mNumElements]) T(std::move(mArray[mNumElements - 1]));
+        size_t oldNumElements = mNumElements;
 
-        // shift elements up one place
-        for (size_t i = mNumElements - 1; i > index; i--)
-            mArray[i] = std::move(mArray[i - 1]);
+        for (; begin != end; ++begin)
+            EmplaceAt(mNumElements, *begin);
 
-        // insert (copy/move-assing) element at index 
-        mArray[index] = std::forward<U>(element);
+        std::rotate(mArray + index, mArray + oldNumElements, mArray + mNumElements);
+
+        return mArray + index + (mNumElements - oldNumElements);
     }
+    else
+    {
+        if constexpr (std::is_pointer<Iter>::value && std::is_same<typename std::remove_cv<typename std::remove_pointer<Iter>::type>::type, T>::value)
+        {
+            if (begin != end && begin < End() && end > Begin())   // range of this vector: copied aside first
+            {
+                Vector copy;
+                copy.Insert(copy.End(), begin, end);
 
-    mNumElements++;
+                return Insert(mArray + index, std::make_move_iterator(copy.Begin()), std::make_move_iterator(copy.End()));
+            }
+        }
+
+        size_t count = std::distance(begin, end);
+
+        if (count == 0)
+            return mArray + index;
+
+        if (mNumElements + count > mCapacity)   // new elements are constructed in the new array, then the old ones relocated around
+        {
+            size_t capacity = mNumElements + count > 2 * mCapacity ? mNumElements + count : 2 * mCapacity;
+            T *array = Allocate(capacity);
+
+            try
+            {
+                ConstructRange(array + index, begin, count);
+            }
+            catch (...)
+            {
+                Deallocate(array, capacity);
+                throw;
+            }
+
+            Relocate(array, mArray, index);
+            Relocate(array + index + count, mArray + index, mNumElements - index);
+
+            Deallocate(mArray, mCapacity);
+
+            mArray = array;
+            mCapacity = capacity;
+        }
+        else
+        {
+            Relocate(mArray + index + count, mArray + index, mNumElements - index);
+
+            try
+            {
+                ConstructRange(mArray + index, begin, count);
+            }
+            catch (...)
+            {
+                Relocate(mArray + index, mArray + index + count, mNumElements - index);   // close the gap
+                throw;
+            }
+        }
+
+        mNumElements += count;
+
+        return mArray + index + count;
+    }
 }
 
-template <typename T>
-template <typename U>
-typename Vector<T>::Iterator Vector<T>::Insert(Iterator pos, U &&element)
+template <typename T, typename A>
+template <typename Iter>
+void Vector<T, A>::ConstructRange(T *to, Iter begin, size_t count)
 {
-    // size_t index = IndexOf(iterator);
-    // Insert(index, std::forward<U>(element));
-    // return AtIndex(index);
+    size_t i = 0;
 
-    if (mNumElements >= mCapacity)   
+    try
     {
-        size_t index = IndexOf(pos);  // save iterator
-        Reserve(mCapacity == 0 ? 1 : mCapacity * 2);
-        pos = AtIndex(index);  // restore iterator
+        for (; i < count; ++i, ++begin)
+            Construct(to + i, *begin);
     }
-
-    if (pos == End())  // if insert last or vector empty
-        new(pos) T(std::forward<U>(element));   // copy/move-construct element (placement-new)
-    else
+    catch (...)
     {
-        // move-construct new last element 
-        Iterator endIt = End();
-        new(endIt) T(std::move(*(endIt - 1)));  
+        while (i > 0)
+            to[--i].~T();
 
-        // shift elements up one place
-        for (Iterator it = endIt - 1; it > pos; --it)
-            *it = std::move(*(it - 1));
-
-        // insert (copy/move-assing) element at index 
-        *pos = std::forward<U>(element);
+        throw;
     }
+}
 
-    mNumElements++;
+template <typename T, typename A>
+template <typename... Args>
+void Vector<T, A>::Emplace(int index, Args&&... args) 
+{ 
+    if (index < 0 || static_cast<size_t>(index) > mNumElements)
+        throw IndexOutOfBoundsException();
 
-    return ++pos;
+    EmplaceAt(index, std::forward<Args>(args)...);
 }
 
-template <typename T>
-template <typename Iter>
-typename Vector<T>::Iterator Vector<T>::Insert(Iterator pos, Iter begin, Iter end)
+template <typename T, typename A>
+template <typename... Args>
+typename Vector<T, A>::Iterator Vector<T, A>::Emplace(Iterator pos, Args&&... args)
 {
-    if (begin == end)
-       return pos;
+    return EmplaceAt(pos - mArray, std::forward<Args>(args)...) + 1;
+}
 
-    int numElementsToInsert = end - begin;
-    int numElementsToShift = End() - pos;
+template <typename T, typename A>
+template <typename... Args>
+void Vector<T, A>::Construct(T *address, Args&&... args)
+{
+    if constexpr (std::is_constructible<T, Args&&...>::value)
+        new(address) T(std::forward<Args>(args)...);
+    else
+        new(address) T{std::forward<Args>(args)...};   // aggregate
+}
 
-    if (mNumElements + numElementsToInsert >= mCapacity)
+template <typename T, typename A>
+void Vector<T, A>::Relocate(T *to, T *from, size_t count)
+{
+    if (count == 0 || to == from)
+        return;
+
+    if constexpr (IsTriviallyRelocatable<T>::value)
+        std::memmove(static_cast<void*>(to), static_cast<const void*>(from), count * sizeof(T));
+    else if (to < from)   // front to back: every destination is free or already relocated
     {
-        size_t index = IndexOf(pos);
-        Reserve(mNumElements + numElementsToInsert);
-        pos = AtIndex(index);
+        for (size_t i = 0; i < count; i++)
+        {
+            new(&to[i]) T(std::move(from[i]));
+            from[i].~T();
+        }
     }
-
-    Iterator to = End() + numElementsToInsert - 1;
-    Iterator from = End() - 1;
-
-    for (int i = 0, j = numElementsToInsert; i < numElementsToShift; i++)  // shift elements to the end of the array
+    else
     {
-        if (j > 0)
+        for (size_t i = count; i-- > 0;)
         {
-            new(to--) T(std::move(*from--));
-            j--;
+            new(&to[i]) T(std::move(from[i]));
+            from[i].~T();
         }
-        else
-            *to = std::move(*from--);      
     }
+}
 
-    while (begin != end)
-        if (numElementsToShift > 0)
+// args may refer to elements of the vector: when growing the new element is built before the old array is released,
+// in the middle it is built aside before the tail is relocated one place up
+template <typename T, typename A>
+template <typename... Args>
+T *Vector<T, A>::EmplaceAt(size_t index, Args&&... args)
+{
+    if (mNumElements == mCapacity)
+    {
+        size_t capacity = mCapacity == 0 ? 1 : mCapacity * 2;
+        T *array = Allocate(capacity);
+
+        try
         {
-            *pos++ = *begin++;
-            numElementsToShift--;
+            Construct(array + index, std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            Deallocate(array, capacity);
+            throw;
         }
-        else
-            new(pos++) T(*begin++);
 
-    mNumElements += numElementsToInsert;
+        Relocate(array, mArray, index);
+        Relocate(array + index + 1, mArray + index, mNumElements - index);
 
-    return pos;
-}
+        Deallocate(mArray, mCapacity);
 
-template <typename T>
-template <typename... Args, typename, typename>
-void Vector<T>::Emplace(int index, Args&&... args) 
-{ 
-    Insert(index, T{std::forward<Args>(args)...}); 
-}
+        mArray = array;
+        mCapacity = capacity;
+    }
+    else if (index == mNumElements)
+        Construct(mArray + index, std::forward<Args>(args)...);
+    else
+    {
+        alignas(T) unsigned char storage[sizeof(T)];
+        T *element = reinterpret_cast<T*>(storage);
 
-template <typename T>
-template <typename... Args, typename, typename, typename>
-void Vector<T>::Emplace(int index, Args&&... args) 
-{ 
-    Insert(index, T(std::forward<Args>(args)...)); 
+        Construct(element, std::forward<Args>(args)...);
+
+        Relocate(mArray + index + 1, mArray + index, mNumElements - index);
+        Relocate(mArray + index, element, 1);
+    }
+
+    mNumElements++;
+
+    return mArray + index;
 }
 
-template <typename T>
-template <typename... Args, typename, typename>
-typename Vector<T>::Iterator Vector<T>::Emplace(Iterator pos, Args&&... args)
+template <typename T, typename A>
+void Vector<T, A>::Remove(int index)
 {
-    return Insert(pos, T{std::forward<Args>(args)...}); 
+    if (index < 0 || index >= mNumElements) 
+        throw IndexOutOfBoundsException();
+
+    Remove(mArray + index, mArray + index + 1);
 }
 
-template <typename T>
-template <typename... Args, typename U, typename, typename>
-typename Vector<T>::Iterator Vector<T>::Emplace(Iterator pos, Args&&... args)
+template <typename T, typename A>
+typename Vector<T, A>::Iterator Vector<T, A>::Remove(Iterator pos)
 {
-    return Insert(pos, T(std::forward<Args>(args)...)); 
+    return Remove(pos, pos + 1);
 }
 
-template <typename T>
-void Vector<T>::Remove(int index)
+template <typename T, typename A>
+typename Vector<T, A>::Iterator Vector<T, A>::Remove(Iterator begin, Iterator end)
 {
-    if (index < 0 || index >= mNumElements) 
-        throw IndexOutOfBoundsException();
+    if (begin == end)
+        return begin;
+
+    // destroy the range, then relocate the tail down in one pass
+    for (Iterator it = begin; it != end; ++it)
+        it->~T();
 
-    // shift elements down one place
-    for (size_t i = index; i < mNumElements - 1; i++)
-        mArray[i] = std::move(mArray[i + 1]);
+    Relocate(begin, end, End() - end);
 
-    // destroy last element
-    mArray[mNumElements - 1].~T();
+    mNumElements -= end - begin;
 
-    mNumElements--;
+    return begin;
 }
 
-template <typename T>
-typename Vector<T>::Iterator Vector<T>::Remove(Iterator pos)
+// single pass compaction: every run of kept elements is relocated down at once (one memmove for trivially relocatable
+// types), the predicate is called once per element in order
+template <typename T, typename A>
+template <typename P>
+size_t Vector<T, A>::RemoveIf(const P &predicate)
 {
-    // shift elements down one place
-    Iterator it;
-    for (it = pos; it < End() - 1; ++it)
-        *it = std::move(*(it + 1));
+    size_t write = 0, i = 0;
 
-    // destroy last element
-    it->~T();
+    while (i < mNumElements)
+    {
+        size_t runBegin = i;
+
+        while (i < mNumElements && !predicate(mArray[i]))
+            i++;
 
-    mNumElements--;
+        Relocate(mArray + write, mArray + runBegin, i - runBegin);
+        write += i - runBegin;
 
-    return pos;
+        if (i < mNumElements)   // predicate was true
+            mArray[i++].~T();
+    }
+
+    size_t numRemoved = mNumElements - write;
+    mNumElements = write;
+
+    return numRemoved;
 }
 
-template <typename T>
-typename Vector<T>::Iterator Vector<T>::Remove(Iterator begin, Iterator end)
+template <typename T, typename A>
+typename Vector<T, A>::ConstIterator Vector<T, A>::Find(const T &key) const
 {
-    Iterator it1 = begin;
-	Iterator it2 = end;
+    if constexpr (SimdSearchable<T>::value)
+        return mArray + SimdFind(mArray, mNumElements, key);
 
-	while (it1 != begin && it2 != End())
-		*it1++ = std::move(*it2++);
-
-	while (it1 != End())
-		it1++->~T();
+    for (std::size_t i = 0; i < mNumElements; i++)
+        if (key == mArray[i])
+            return ConstIterator(&mArray[i]);
 
-	mNumElements -= end - begin;
-	
-	return end;
+    return End();
 }
 
-template <typename T>
-typename Vector<T>::ConstIterator Vector<T>::Find(const T &key) const
+template <typename T, typename A>
+template <typename P>
+typename Vector<T, A>::ConstIterator Vector<T, A>::FindIf(const P &predicate) const
 {
+    if constexpr (std::is_arithmetic<T>::value)
+        return mArray + BlockFindIf(mArray, mNumElements, predicate);
+
     for (std::size_t i = 0; i < mNumElements; i++)
-        if (key == mArray[i])
+        if (predicate(mArray[i]))
             return ConstIterator(&mArray[i]);
 
     return End();
 }
 
+template <typename T, typename A>
+size_t Vector<T, A>::Count(const T &key) const
+{
+    if constexpr (SimdSearchable<T>::value)
+        return SimdCount(mArray, mNumElements, key);
+
+    size_t count = 0;
+
+    for (std::size_t i = 0; i < mNumElements; i++)
+        if (key == mArray[i])
+            count++;
+
+    return count;
+}
+
+template <typename T, typename A>
+template <typename P>
+size_t Vector<T, A>::CountIf(const P &predicate) const
+{
+    return BlockCountIf(mArray, mNumElements, predicate);
+}
+
+template <typename T, typename A>
+Vector<size_t> Vector<T, A>::FindAll(const T &key) const
+{
+    Vector<size_t> indices;
+
+    if constexpr (SimdSearchable<T>::value)
+    {
+        const size_t CHUNK = 1024;
+        size_t chunkIndices[CHUNK];   // matches of one chunk, appended afterwards
+
+        for (size_t begin = 0; begin < mNumElements; begin += CHUNK)
+        {
+            size_t size = mNumElements - begin < CHUNK ? mNumElements - begin : CHUNK;
+            size_t count = SimdFindAll(mArray + begin, size, key, chunkIndices);
+
+            for (size_t i = 0; i < count; i++)
+                indices.InsertLast(begin + chunkIndices[i]);
+        }
+    }
+    else
+    {
+        for (std::size_t i = 0; i < mNumElements; i++)
+            if (key == mArray[i])
+                indices.InsertLast(i);
+    }
+
+    return indices;
+}
+
 #endif  // VECTOR_H
\ No newline at end of file